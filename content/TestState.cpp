@@ -282,8 +282,9 @@ void TestState::predraw(predraw_state_t predraw_state, const WindowState* win_st
 			tile_ghost.setSize({ TILESIZE_F, TILESIZE_F });
 			tile_ghost.setColor(ff::Color::White().alpha(80));
 			tile_ghost.setTexture(&tileset->getTexture());
+			Rectf tileset_area{ tileset->getTextureArea() };
 			tile_ghost.setTextureRect(Rectf{
-					Vec2f{ tile->to_vec() } * TILESIZE_F,
+					Vec2f{ tile->to_vec() } * TILESIZE_F + Vec2f{ tileset_area.left, tileset_area.top },
 					Vec2f{ 1, 1 } * TILESIZE_F
 				});
 
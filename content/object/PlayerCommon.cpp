@@ -214,6 +214,10 @@ namespace plr::constants {
 	Default<float> dash_speed = 220.f;
 }
 
+namespace {
+    const SoundRef bump_sound{ "Bump.wav" };
+}
+
 namespace plr::action {
 
 	PlayerStateID dash(World& w, plr::members& plr, const move_t& move)
@@ -223,7 +227,7 @@ namespace plr::action {
 			sprite.set_hflip(move.wishx < 0);
 		}
 
-        w.system<AudioSystem>().play("Bump.wav", { .gain = .25f });
+        w.system<AudioSystem>().play(bump_sound, { .gain = .25f });
 		return PlayerStateID::Dash;
 	}
 
@@ -287,7 +291,7 @@ namespace plr::action {
 		}
 		box.set_local_vel(jumpVel);
 
-        w.system<AudioSystem>().play("Bump.wav", { .gain = 0.5f });
+        w.system<AudioSystem>().play(bump_sound, { .gain = 0.5f });
 		return PlayerStateID::Air;
 	}
 }
@@ -5,6 +5,9 @@ uniform sampler2D texture0;
 
 uniform vec2 char_size;
 
+// pixel area of the glyph bitmap on the texture, xy = offset, zw = size
+uniform vec4 tex_area;
+
 out vec4 v_color;
 out vec2 texCoord;
 
@@ -37,5 +40,5 @@ void main()
 
 	v_color = color;
 
-	texCoord = tpos / vec2(textureSize(texture0, 0));
+	texCoord = (tex_area.xy + tpos) / vec2(textureSize(texture0, 0));
 }
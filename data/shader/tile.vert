@@ -5,6 +5,9 @@ uniform sampler2D texture0;
 
 uniform uint columns;
 
+// pixel area of the tileset on the texture, xy = offset, zw = size
+uniform vec4 tex_area;
+
 layout (location = 0) in uint aTileId;
 
 out vec2 texCoord;
@@ -32,7 +35,7 @@ void main()
 		(aTileId & Y_MASK) >> 6
 	);
 
-	vec2 tileset_size = vec2(textureSize(texture0, 0)) / TILESIZE;
+	vec2 texture_size = vec2(textureSize(texture0, 0));
 
 	// +1 for right/bot, -1 for left/top
 	float horz_side = float(gl_VertexID & 1) * 2.0 - 1.0;
@@ -68,9 +71,8 @@ void main()
 
 	// calc texture coords
 	const uint tileset_columns = 64u;
-	texCoord    = t_offset + vec2(
-		(float(tile_id.x) + p_offset.x) / tileset_size.x,
-		(float(tile_id.y) + p_offset.y) / tileset_size.y
-	);
+	texCoord    = t_offset + (
+		tex_area.xy + (vec2(tile_id) + p_offset) * TILESIZE
+	) / texture_size;
 }
 
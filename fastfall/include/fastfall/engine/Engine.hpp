@@ -10,17 +10,22 @@
 
 #include "fastfall/render/drawable/VertexArray.hpp"
 #include "fastfall/render/target/Window.hpp"
+#include "fastfall/render/target/DrawList.hpp"
 #include "fastfall/engine/input/InputConfig.hpp"
 #include "fastfall/engine/audio.hpp"
+#include "fastfall/engine/telemetry.hpp"
 #include "fastfall/game/WorldImGui.hpp"
+#include "fastfall/util/triple_buffer.hpp"
 
 #include <queue>
+#include <filesystem>
 #include <memory>
 #include <mutex>
 #include <functional>
 #include <chrono>
 
 #include <mutex>
+#include <atomic>
 #include <barrier>
 
 
@@ -50,6 +55,32 @@ struct EngineSettings {
 
 	// run style
 	EngineRunStyle runstyle = EngineRunStyle::DoubleThread;
+
+	// if set, telemetry is written here on close, as json if the extension is .json, otherwise csv
+	std::filesystem::path telemetryOutput;
+};
+
+// what one runnable drew after predraw
+struct RunnableSnapshot {
+	RenderTexture* rtexture = nullptr;
+	Color clear_color;
+	DrawList draws;
+};
+
+// one update thread frame, handed to the render thread after predraw
+struct FrameSnapshot {
+	using time_point = std::chrono::steady_clock::time_point;
+
+	size_t frame = 0;
+	time_point update_begin;
+	time_point update_end;
+	time_point predraw_end;
+
+	// view of the first runnable
+	Vec2f view_pos;
+	float view_zoom = 1.f;
+
+	std::vector<RunnableSnapshot> runnables;
 };
 
 class DebugDrawImgui : public ImGuiContent {
@@ -63,6 +94,7 @@ class Engine : public ImGuiContent {
 	DebugDrawImgui debugdrawImgui;
     WorldImGui worldImgui;
 	AudioImGui audioImgui;
+	TelemetryImGui telemetryImgui;
 
 	InputConfig::InputObserver input_cfg;
 
@@ -119,13 +151,19 @@ private:
 	void updateTimer();
 	void updateStateHandler();
 	void updateView();
+	void updateView(Vec2f view_pos, float view_zoom);
 	void updateRunnables();
 	void predrawRunnables();
 	void drawRunnables();
+	void recordRunnables(FrameSnapshot& snapshot);
+	void drawSnapshot(const FrameSnapshot& snapshot);
 	void updateImGui();
+	bool buildImGui();
+	void renderImGui();
 	void cleanRunnables();
 	void display();
 	void sleep();
+	void recordFrameTelemetry();
 
 	void update_window_scale();
 
@@ -173,9 +211,23 @@ private:
 
 	std::vector<EngineRunnable> runnables;
 
+	// shared between the render and update thread in run_doubleThread
+	struct ThreadSync {
+		// render thread hands the next tick to the update thread
+		std::barrier<> tick_bar{ 2 };
+
+		// count of frames the update thread has finished, through predraw and cleanup
+		// events and imgui read and edit world state, so they wait for the update thread to be idle
+		std::atomic<size_t> frames_updated = 0;
+
+		// update thread publishes what it predrew, the render thread draws the latest one
+		triple_buffer<FrameSnapshot> snapshots;
+	};
+
 	void initRenderTarget(bool fullscreen);
-	void runUpdate(std::barrier<>* bar);
+	void runUpdate(ThreadSync* sync);
 	void drawRunnable(EngineRunnable& run);
+	void drawMargins(RenderTarget& target);
 
 	void close();
 
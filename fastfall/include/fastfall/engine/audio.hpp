@@ -17,11 +17,23 @@ struct SoundCfg {
     float gain = 1.f;
     const char* tag = nullptr;
     MIX_Group* group = nullptr;
+
+    // when the voice pool is full, a sound may take the voice of one that's lower priority,
+    // or of equal priority and further away, the oldest first
+    int priority = 0;
+    float distance = 0.f;
+
+    // -1 to loop until stopped
+    int loops = 0;
 };
 
+// owns a voice from the pool while alive, the sound keeps playing once released
 class SoundHandle {
 public:
     explicit SoundHandle(const char* tag = nullptr, MIX_Group* group = nullptr);
+
+    // may steal a voice, invalid if every voice is held or more important
+    explicit SoundHandle(const SoundCfg& cfg);
     SoundHandle(const SoundHandle&) = delete;
     SoundHandle& operator=(const SoundHandle&) = delete;
     SoundHandle(SoundHandle&& other) noexcept;
@@ -36,6 +48,8 @@ public:
     bool play();
     bool stop();
 
+    bool valid() const;
+
     size_t hash() const {
         return (static_cast<size_t>(track_id) << 32) | static_cast<size_t>(generation);
     }
@@ -68,6 +82,8 @@ struct hash<ff::SoundHandle> {
 
 namespace ff::audio {
 
+// fixed number of mixer tracks, created on init
+constexpr uint32_t voice_count = 32;
 
 bool init();
 void quit();
@@ -83,4 +99,21 @@ float get_music_volume();
 
 MIX_Mixer* get_mixer();
 
+// voices neither held by a handle nor playing
+uint32_t free_voice_count();
+uint64_t voices_stolen();
+
+// sound handles only queue their requests, process_commands() carries them out
+// on the main thread once per frame, so the update thread never waits on the mixer
+void set_tick(uint64_t tick);
+uint64_t get_tick();
+
+// plays requested more than this many ticks before the newest one are dropped,
+// as are plays from ticks older than ones already processed (after a rewind)
+void set_max_command_age(uint64_t ticks);
+
+size_t process_commands();
+size_t pending_commands();
+uint64_t commands_dropped();
+
 }
\ No newline at end of file
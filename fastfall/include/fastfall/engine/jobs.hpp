@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+// small work-stealing job system
+// each worker thread owns a queue, idle workers steal from the others
+// threads waiting on a group help run queued jobs instead of blocking
+// if the job system isn't running, jobs are run inline on the calling thread
+
+namespace ff::jobs {
+
+using Job = std::function<void()>;
+
+namespace detail {
+    struct task_t;
+}
+
+// tracks completion of a batch of jobs
+class Group {
+public:
+    Group() = default;
+
+    // no copy
+    Group(const Group&) = delete;
+    Group& operator=(const Group&) = delete;
+
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    std::atomic<size_t> pending = 0;
+
+    friend void run(Group& group, Job job);
+    friend struct detail::task_t;
+};
+
+// thread_count of 0 uses the hardware concurrency, minus the engine's own threads
+bool init(unsigned thread_count = 0);
+void quit();
+bool is_init();
+
+// number of worker threads, not including the caller
+unsigned worker_count();
+
+// queue a job in the group
+void run(Group& group, Job job);
+
+// block until every job in the group is done
+void wait(Group& group);
+
+// calls fn(begin, end) over [0, count) in chunks of at most grain, then waits
+// chunks may run in any order, fn must only write to data owned by its range
+template<class Fn>
+void parallel_for(size_t count, size_t grain, Fn&& fn) {
+    if (count == 0)
+        return;
+
+    grain = (std::max)(grain, size_t{ 1 });
+    if (!is_init() || count <= grain) {
+        fn(size_t{ 0 }, count);
+        return;
+    }
+
+    Group group;
+    for (size_t begin = grain; begin < count; begin += grain) {
+        size_t end = (std::min)(count, begin + grain);
+        run(group, [&fn, begin, end]() { fn(begin, end); });
+    }
+    // run the first chunk here
+    fn(size_t{ 0 }, grain);
+    wait(group);
+}
+
+}
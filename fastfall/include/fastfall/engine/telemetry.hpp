@@ -0,0 +1,155 @@
+#pragma once
+
+#include "fastfall/engine/imgui/ImGuiContent.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+// low overhead timings and counters, always compiled in (unlike profiler::DurationBuffer)
+// each channel keeps a ring of recent samples and a histogram of every sample since the last reset
+// recording is lock-free and may happen from any thread, only registering a channel takes a lock
+
+namespace ff::telemetry {
+
+// log-linear histogram, each power of two is split into SubBuckets linear buckets
+// so any recorded value is reported within ~3% of its true value
+class Histogram {
+public:
+    constexpr static unsigned SubBits = 5;
+    constexpr static size_t SubBuckets = 1 << SubBits;
+    constexpr static size_t BucketCount = SubBuckets * (64 - SubBits + 1);
+
+    constexpr static size_t bucket_of(uint64_t value) {
+        if (value < SubBuckets)
+            return value;
+
+        unsigned msb = std::bit_width(value) - 1;
+        unsigned shift = msb - SubBits;
+        return SubBuckets * (shift + 1) + ((value >> shift) - SubBuckets);
+    }
+
+    // largest value that maps to this bucket
+    constexpr static uint64_t bucket_max(size_t bucket) {
+        if (bucket < SubBuckets)
+            return bucket;
+
+        unsigned shift = (bucket / SubBuckets) - 1;
+        uint64_t top = SubBuckets + (bucket % SubBuckets);
+        return (top << shift) + ((uint64_t{ 1 } << shift) - 1);
+    }
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t min() const;
+    uint64_t max() const { return max_value.load(std::memory_order_relaxed); }
+    double   mean() const;
+
+    // p in [0, 1], 0 if nothing was recorded
+    uint64_t percentile(double p) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BucketCount> buckets{};
+    std::atomic<uint64_t> total = 0;
+    std::atomic<uint64_t> sum = 0;
+    std::atomic<uint64_t> min_value = UINT64_MAX;
+    std::atomic<uint64_t> max_value = 0;
+};
+
+enum class Kind : uint8_t {
+    Timing,  // nanoseconds
+    Counter,
+};
+
+// handle to a registered channel, cheap to copy
+struct Channel {
+    constexpr static uint16_t Invalid = UINT16_MAX;
+    uint16_t index = Invalid;
+
+    bool valid() const { return index != Invalid; }
+};
+
+constexpr size_t MaxChannels = 128;
+constexpr size_t RingSize    = 1024;
+
+// finds or registers a channel by name, keep the handle rather than calling this per sample
+// returns an invalid channel if MaxChannels is reached
+Channel timing(std::string_view name);
+Channel counter(std::string_view name);
+
+void record(Channel channel, uint64_t value);
+
+inline void record(Channel channel, std::chrono::steady_clock::duration duration) {
+    record(channel, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+}
+
+void set_enabled(bool enabled);
+bool is_enabled();
+
+// clears every channel's histogram and ring
+void reset();
+
+struct Summary {
+    std::string_view name;
+    Kind     kind;
+    uint64_t count;
+    uint64_t min;
+    double   mean;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t max;
+};
+
+size_t channel_count();
+Summary summarize(Channel channel);
+
+// copies up to out.size() of the most recent samples into out, oldest first
+// returns the number copied
+size_t recent(Channel channel, std::span<uint64_t> out);
+
+bool write_csv(const std::filesystem::path& path);
+bool write_json(const std::filesystem::path& path);
+
+// records the time from construction to destruction
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Channel ch)
+        : channel(ch)
+        , start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedTimer() {
+        record(channel, std::chrono::steady_clock::now() - start);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Channel channel;
+    std::chrono::steady_clock::time_point start;
+};
+
+}
+
+namespace ff {
+
+class TelemetryImGui : public ImGuiContent {
+public:
+    TelemetryImGui();
+    void ImGui_getContent(secs deltaTime) override;
+
+private:
+    int selected = -1;
+};
+
+}
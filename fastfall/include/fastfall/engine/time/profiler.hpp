@@ -19,6 +19,9 @@ namespace ff::profiler {
         secs    display_time;
         secs    sleep_time;
         secs    total_time;
+
+        // time the update thread spent working while this frame was drawn
+        secs    overlap_time;
     };
 
     Duration curr_duration;
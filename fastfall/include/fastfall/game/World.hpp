@@ -7,16 +7,29 @@
 #include "fastfall/game/actor/Actor.hpp"
 
 #include "fastfall/engine/input/InputState.hpp"
+#include "fastfall/engine/telemetry.hpp"
 
 #include "fastfall/game/WorldConfigComponents.hpp"
 #include "fastfall/game/WorldConfigSystems.hpp"
+#include "fastfall/game/WorldView.hpp"
 
+#include <mutex>
 #include <optional>
 #include <concepts>
 #include <span>
+#include <string_view>
 
 namespace ff {
 
+class World;
+
+// systems taking a span of ids are notified once per component type at the end of a batch
+template<class System, class T>
+concept notified_in_bulk_created = requires(System s, World& w, std::span<const ID<T>> ids) { s.notify_created(w, ids); };
+
+template<class System, class T>
+concept notified_in_bulk_erased = requires(System s, World& w, std::span<const ID<T>> ids) { s.notify_erased(w, ids); };
+
 class World : public Drawable
 {
 private:
@@ -40,6 +53,13 @@ private:
         Components::MapTuple _components;
         std::vector<ID<Drawable>>   erase_drawables_deferred;
 
+        // erased by process_destroyed()
+        std::vector<ID<Entity>>     destroy_entities;
+        std::vector<ComponentID>    destroy_components;
+
+        // bumped whenever a component of the type is created or erased
+        std::array<uint64_t, Components::Count> _versions = {};
+
         // systems
         Systems::Tuple _systems;
 
@@ -51,17 +71,31 @@ private:
         InputState _input;
     } state;
 
-private:
-    template<class T>
-    constexpr auto& components() const {
-        return const_cast<World&>(*this).components<T>();
-    }
+    // cached views, indexed by detail::view_index(), not copied with the state
+    std::vector<std::unique_ptr<detail::view_cache_base>> view_caches;
+    std::mutex view_mutex;
+
+    // work put off until the outermost batch ends, not copied with the state
+    struct batch_t {
+        uint32_t depth = 0;
+
+        // pending bulk notifications
+        Components::IDVectorTuple created;
+        Components::IDVectorTuple erased;
+
+        // merged into _comp_to_ent in one pass, kept sorted for lookups during the batch
+        std::vector<state_t::comp_to_ent_t> tied;
+        std::vector<ComponentID> untied;
 
+        // erased components, taken out of their maps once the systems have been told
+        std::vector<ComponentID> removed;
+    } batch_state;
+
+private:
+    // figure out what container fits component T
     template<class T>
-    constexpr auto& components()
-    {
-        // figure out what container fits component T
-        constexpr size_t index = []<size_t... Ndx>(std::index_sequence<Ndx...>) constexpr {
+    static constexpr size_t component_index() {
+        return []<size_t... Ndx>(std::index_sequence<Ndx...>) constexpr {
             std::optional<size_t> opt_ndx;
             auto container_matches = [&]<size_t N>(std::integral_constant<size_t, N>) {
                 using Container = std::tuple_element_t<N, Components::MapTuple>;
@@ -73,10 +107,36 @@ private:
             (container_matches(std::integral_constant<size_t, Ndx>{}) || ...);
             return *opt_ndx;
         }(std::make_index_sequence<Components::Count>{});
+    }
+
+    template<class T>
+    constexpr auto& components() const {
+        return const_cast<World&>(*this).components<T>();
+    }
+
+    template<class T>
+    constexpr auto& components()
+    {
+        return std::get<component_index<T>()>(state._components);
+    }
 
-        return std::get<index>(state._components);
+    template<class T>
+    void bump_version() {
+        // steps running concurrently may create or erase components while others ask for views
+        std::lock_guard lock{ view_mutex };
+        state._versions[component_index<T>()]++;
     }
 
+    template<class T>
+    static constexpr bool any_bulk_created = []<class... Sys>(std::type_identity<std::tuple<Sys...>>) {
+        return (notified_in_bulk_created<Sys, T> || ...);
+    }(std::type_identity<Systems::Tuple>{});
+
+    template<class T>
+    static constexpr bool any_bulk_erased = []<class... Sys>(std::type_identity<std::tuple<Sys...>>) {
+        return (notified_in_bulk_erased<Sys, T> || ...);
+    }(std::type_identity<Systems::Tuple>{});
+
 public:
     World();
     World(const World&);
@@ -188,12 +248,87 @@ public:
     bool erase(ComponentID component_id);
     bool erase_all_components(ID<Entity> entity_id);
 
+    // erases the entities in one batch, returns how many existed
+    size_t erase(std::span<const ID<Entity>> entity_ids);
+
+    // destruction queue
+    // queued entities and components are erased together in one batch by process_destroyed(),
+    // which runs after each update and before the scene's predraw
+    void destroy(ID<Entity> entity_id);
+    void destroy(ComponentID component_id);
+    void process_destroyed();
+
+    size_t pending_destroyed() const { return state.destroy_entities.size() + state.destroy_components.size(); }
+
+    // batching
+    // while a batch is open, systems that take a span of ids get one notification per component type
+    // when the outermost batch ends, and entity lookups are sorted in once instead of per component
+    // auto batch = world.batch();
+    class Batch {
+    public:
+        explicit Batch(World& t_world) : world(&t_world) { world->begin_batch(); }
+        ~Batch() { world->end_batch(); }
+
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+    private:
+        World* world;
+    };
+
+    [[nodiscard]] Batch batch() { return Batch{ *this }; }
+
+    void begin_batch();
+    void end_batch();
+    bool in_batch() const { return batch_state.depth > 0; }
+
+    // makes room for count more of T, Entity included
+    template<class T>
+    void reserve(size_t count) {
+        if constexpr (std::same_as<T, Entity>) {
+            state._entities.reserve(state._entities.size() + count);
+        }
+        else {
+            components<T>().reserve(components<T>().size() + count);
+        }
+    }
+
     // span components
     template<class T>
     inline auto& all() { return components<T>(); }
     template<class T>
     inline const auto& all() const { return components<T>(); }
 
+    // iterate T along with the Ts of its entity, without looking each one up
+    // for (auto [id, col, attach] : world.view<Collidable, AttachPoint>()) { ... }
+    // the view is invalidated by the next view() of the same types after a component is created or erased
+    template<class T, class... Ts>
+    ComponentView<T, Ts...> view() {
+        using cache_t = detail::view_cache<T, Ts...>;
+        static_assert(std::same_as<typename std::remove_cvref_t<decltype(components<T>())>::base_type, T>,
+                "views iterate components by their stored type");
+
+        size_t index = detail::view_index<T, Ts...>();
+
+        // steps running concurrently may each ask for views
+        std::lock_guard lock{ view_mutex };
+        uint64_t version = (state._versions[component_index<T>()] + ... + state._versions[component_index<Ts>()]);
+        if (view_caches.size() <= index) {
+            view_caches.resize(index + 1);
+        }
+        if (!view_caches[index]) {
+            view_caches[index] = std::make_unique<cache_t>();
+        }
+
+        auto& cache = static_cast<cache_t&>(*view_caches[index]);
+        if (cache.version != version) {
+            rebuild_view(cache);
+            cache.version = version;
+            cache.rebuilds++;
+        }
+        return ComponentView<T, Ts...>{ cache };
+    }
+
 	// access system
     template<class T>
     inline constexpr T& system() { return std::get<T>(state._systems); }
@@ -223,11 +358,25 @@ public:
 private:
     void draw(RenderTarget& target, RenderState state = RenderState()) const override;
 
+    struct update_step_t {
+        std::string_view name;
+        AccessMask access;
+        void(*update)(World&, secs);
+    };
+
+    // runs steps in order, consecutive steps with non-conflicting access run concurrently
+    struct update_step_channels_t {
+        telemetry::Channel time;
+        telemetry::Channel allocs;
+    };
+
+    void run_update_steps(std::span<const update_step_t> steps, std::span<const update_step_channels_t> channels, secs deltaTime);
+
     template<typename T_Actor, class... Args>
     requires valid_actor_ctor<T_Actor, Args...>
     bool create_actor(ID<Entity> id, Args&&... args) {
         auto& ent = state._entities.at(id);
-        ent.actor = components<Actor>().emplace(copyable_unique_ptr<Actor>{});
+        ent.actor = components<Actor>().create_empty();
         auto actor_id = ent.actor.value();
 
         auto init = ActorInit{
@@ -242,11 +391,66 @@ private:
         return at(actor_id).is_initialized();
     }
 
+    template<class T, class... Ts>
+    void rebuild_view(detail::view_cache<T, Ts...>& cache) {
+        cache.entries.clear();
+        for (auto [id, _] : components<T>()) {
+            if (in_batch() && !is_live(id)) {
+                continue;
+            }
+            T* cmp = get(id);
+            ID<Entity> ent;
+            if constexpr (std::same_as<T, Actor>) {
+                ent = cmp->entity_id;
+            }
+            else if constexpr (!(links_to<T, Ts> && ...)) {
+                ent = entity_of(id);
+            }
+
+            std::tuple<Ts*...> others{ find_for_view<T, Ts>(*cmp, ent)... };
+            bool matches = std::apply([](auto*... ptrs) { return ((ptrs != nullptr) && ...); }, others);
+            if (matches) {
+                cache.entries.push_back(std::tuple_cat(std::make_tuple(id, cmp), others));
+            }
+        }
+    }
+
+    template<class T, class Other>
+    Other* find_for_view(const T& cmp, ID<Entity> ent) {
+        if constexpr (links_to<T, Other>) {
+            return get(ID<Other>{ linked_id(cmp, std::type_identity<Other>{}) });
+        }
+        else if constexpr (std::same_as<Other, Actor>) {
+            return get(state._entities.at(ent).actor);
+        }
+        else {
+            for (auto& cid : state._entities.at(ent).components) {
+                if (auto* other_id = std::get_if<ID<Other>>(&cid)) {
+                    return get(*other_id);
+                }
+            }
+            return nullptr;
+        }
+    }
+
     template<typename T>
     void system_notify_created(ID<T> t_id) {
+        bump_version<T>();
+        bool deferred = false;
+        if constexpr (any_bulk_created<T>) {
+            if (in_batch()) {
+                std::get<std::vector<ID<T>>>(batch_state.created).push_back(t_id);
+                deferred = true;
+            }
+        }
         std::apply([&, this](auto&... system) {
             ([&, this]<class System>(System& sys){
-                if constexpr (requires(System s, ID<T> i, World& w) { s.notify_created(w, i); }) {
+                if constexpr (notified_in_bulk_created<System, T>) {
+                    if (!deferred) {
+                        sys.notify_created(*this, std::span<const ID<T>>{ &t_id, 1 });
+                    }
+                }
+                else if constexpr (requires(System s, ID<T> i, World& w) { s.notify_created(w, i); }) {
                     sys.notify_created(*this, t_id);
                 }
             }(system), ...);
@@ -255,15 +459,77 @@ private:
 
     template<typename T>
     void system_notify_erased(ID<T> t_id) {
+        bump_version<T>();
+        bool deferred = false;
+        if constexpr (any_bulk_erased<T>) {
+            if (in_batch()) {
+                // systems must hear of a creation before its erasure
+                flush_created<T>();
+                std::get<std::vector<ID<T>>>(batch_state.erased).push_back(t_id);
+                deferred = true;
+            }
+        }
+        else if constexpr (any_bulk_created<T>) {
+            if (in_batch()) {
+                flush_created<T>();
+            }
+        }
         std::apply([&, this](auto&... system) {
             ([&, this]<class System>(System& sys){
-                if constexpr (requires(System s, ID<T> i, World& w) { s.notify_erased(w, i); }) {
+                if constexpr (notified_in_bulk_erased<System, T>) {
+                    if (!deferred) {
+                        sys.notify_erased(*this, std::span<const ID<T>>{ &t_id, 1 });
+                    }
+                }
+                else if constexpr (requires(System s, ID<T> i, World& w) { s.notify_erased(w, i); }) {
                     sys.notify_erased(*this, t_id);
                 }
             }(system), ...);
         }, state._systems);
     }
 
+    // delivers pending bulk notifications for T
+    template<typename T>
+    void flush_created() {
+        auto& pending = std::get<std::vector<ID<T>>>(batch_state.created);
+        if (pending.empty())
+            return;
+
+        auto ids = std::move(pending);
+        pending.clear();
+        std::apply([&, this](auto&... system) {
+            ([&, this]<class System>(System& sys){
+                if constexpr (notified_in_bulk_created<System, T>) {
+                    sys.notify_created(*this, std::span<const ID<T>>{ ids });
+                }
+            }(system), ...);
+        }, state._systems);
+    }
+
+    template<typename T>
+    void flush_erased() {
+        auto& pending = std::get<std::vector<ID<T>>>(batch_state.erased);
+        if (pending.empty())
+            return;
+
+        auto ids = std::move(pending);
+        pending.clear();
+        std::apply([&, this](auto&... system) {
+            ([&, this]<class System>(System& sys){
+                if constexpr (notified_in_bulk_erased<System, T>) {
+                    sys.notify_erased(*this, std::span<const ID<T>>{ ids });
+                }
+            }(system), ...);
+        }, state._systems);
+    }
+
+    // exists, and hasn't been erased while waiting on the end of a batch
+    bool is_live(ComponentID component) const;
+    std::optional<ID<Entity>> find_entity_of(ComponentID id) const;
+
+    bool erase_actor(ID<Entity> entity_id);
+    void remove_component(ComponentID component);
+
     void tie_component_entity(ComponentID cmp, ID<Entity> ent);
     void untie_component_entity(ComponentID cmp, ID<Entity> ent);
 
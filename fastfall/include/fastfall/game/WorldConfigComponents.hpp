@@ -2,6 +2,7 @@
 
 #include <tuple>
 #include <variant>
+#include <vector>
 
 #include "fastfall/util/id_map.hpp"
 
@@ -33,6 +34,10 @@ struct ComponentConfig {
         ID<std::remove_pointer_t<Ts>>...
     >;
 
+    using IDVectorTuple = std::tuple<
+        std::vector<ID<std::remove_pointer_t<Ts>>>...
+    >;
+
     constexpr static size_t Count = sizeof...(Ts);
 };
 
@@ -11,8 +11,14 @@
 #include "fastfall/game/systems/PathSystem.hpp"
 #include "fastfall/game/systems/AudioSystem.hpp"
 
+#include "fastfall/game/WorldConfigComponents.hpp"
+
 #include <tuple>
 #include <variant>
+#include <cstdint>
+#include <algorithm>
+#include <concepts>
+#include <utility>
 
 namespace ff {
 
@@ -48,4 +54,136 @@ constexpr inline static std::string_view SystemNames[Systems::Count] = {
     "AudioSystem",
 };
 
-}
\ No newline at end of file
+// SYSTEM ACCESS
+// what a system's update may touch, used by World::update to run non-conflicting steps concurrently
+
+// shared state outside of the components
+struct DebugDrawAccess {}; // debug::draw
+struct InputAccess {};     // World input state
+
+namespace detail {
+    template<class T, class Tuple>
+    constexpr size_t tuple_index_of = []<size_t... N>(std::index_sequence<N...>) {
+        size_t ndx = sizeof...(N);
+        ((std::same_as<T, std::tuple_element_t<N, Tuple>> ? (ndx = N, true) : false) || ...);
+        return ndx;
+    }(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+
+    template<class T>
+    constexpr size_t component_index = (std::min)(
+            tuple_index_of<T, Components::Tuple>,
+            tuple_index_of<T*, Components::Tuple>);
+}
+
+// one bit per component, shared state and system
+template<class T>
+constexpr uint32_t access_bit() {
+    constexpr size_t resource_offset = Components::Count;
+    constexpr size_t system_offset   = Components::Count + 2;
+    static_assert(system_offset + Systems::Count <= 32);
+
+    if constexpr (std::same_as<T, DebugDrawAccess>) {
+        return 1u << resource_offset;
+    }
+    else if constexpr (std::same_as<T, InputAccess>) {
+        return 1u << (resource_offset + 1);
+    }
+    else if constexpr (detail::component_index<T> < Components::Count) {
+        return 1u << detail::component_index<T>;
+    }
+    else {
+        static_assert(detail::tuple_index_of<T, Systems::Tuple> < Systems::Count, "unknown access type");
+        return 1u << (system_offset + detail::tuple_index_of<T, Systems::Tuple>);
+    }
+}
+
+template<class... Ts>
+struct Access {
+    constexpr static uint32_t mask = (access_bit<Ts>() | ... | 0u);
+};
+
+struct AccessAll {
+    constexpr static uint32_t mask = ~0u;
+};
+
+struct AccessMask {
+    uint32_t reads  = ~0u;
+    uint32_t writes = ~0u;
+
+    constexpr bool conflicts(const AccessMask& other) const {
+        return (writes & (other.reads | other.writes)) != 0
+            || (reads & other.writes) != 0;
+    }
+
+    constexpr AccessMask& operator|=(const AccessMask& other) {
+        reads  |= other.reads;
+        writes |= other.writes;
+        return *this;
+    }
+};
+
+template<class Reads, class Writes>
+constexpr AccessMask access_mask() {
+    return { Reads::mask, Writes::mask };
+}
+
+// by default a system's update may touch anything (create entities, run actor callbacks, etc)
+// and is never run alongside another step
+template<class System>
+struct SystemAccess {
+    using reads  = AccessAll;
+    using writes = AccessAll;
+};
+
+template<class System>
+constexpr AccessMask system_access() {
+    return access_mask<typename SystemAccess<System>::reads, typename SystemAccess<System>::writes>();
+}
+
+// rolls scene configs' previous position
+template<>
+struct SystemAccess<SceneSystem> {
+    using reads  = Access<Drawable>;
+    using writes = Access<SceneSystem>;
+};
+
+// rolls attachpoints' previous position
+template<>
+struct SystemAccess<AttachSystem> {
+    using reads  = Access<>;
+    using writes = Access<AttachPoint, AttachSystem>;
+};
+
+template<>
+struct SystemAccess<LevelSystem> {
+    using reads  = Access<>;
+    using writes = Access<LevelSystem>;
+};
+
+template<>
+struct SystemAccess<PathSystem> {
+    using reads  = Access<>;
+    using writes = Access<PathMover, AttachPoint, PathSystem, DebugDrawAccess>;
+};
+
+// camera targets may only read actor and physics state
+template<>
+struct SystemAccess<CameraSystem> {
+    using reads  = Access<Actor, Collidable, ColliderRegion, AttachPoint, PathMover>;
+    using writes = Access<CameraTarget, CameraSystem, DebugDrawAccess>;
+};
+
+// particle simulation only, event callbacks are dispatched separately
+template<>
+struct SystemAccess<EmitterSystem> {
+    using reads  = Access<ColliderRegion>;
+    using writes = Access<Emitter, EmitterSystem, DebugDrawAccess>;
+};
+
+template<>
+struct SystemAccess<AudioSystem> {
+    using reads  = Access<>;
+    using writes = Access<AudioSystem>;
+};
+
+}
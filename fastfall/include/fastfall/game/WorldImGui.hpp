@@ -4,7 +4,9 @@
 
 #include "fastfall/game/Entity.hpp"
 #include "fastfall/game/ComponentID.hpp"
+#include "fastfall/game/phys/collision/CollisionTrace.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace ff {
@@ -33,6 +35,10 @@ public:
         size_t tab_id_counter = 0;
         std::vector<EntBrowserTab> tabs;
         char tab_name[64];
+
+        // attached to the world's collision system while recording
+        std::unique_ptr<CollisionTrace> collision_trace;
+        char trace_path[128] = "collision.trace";
     };
 
     WorldImGui();
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "fastfall/util/id.hpp"
+
+#include "fastfall/game/phys/Collidable.hpp"
+#include "fastfall/game/path/PathMover.hpp"
+#include "fastfall/game/attach/AttachPoint.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace ff {
+
+// components that own a component of another type, a view pairs them with that one
+// instead of whichever of that type is on the same entity
+inline ID<AttachPoint> linked_id(const Collidable& col, std::type_identity<AttachPoint>) { return col.get_attach_id(); }
+inline ID<AttachPoint> linked_id(const PathMover& pm, std::type_identity<AttachPoint>) { return pm.get_attach_id(); }
+
+template<class T, class Other>
+concept links_to = requires(const T& cmp) {
+    { linked_id(cmp, std::type_identity<Other>{}) } -> std::convertible_to<ID<Other>>;
+};
+
+namespace detail {
+
+    struct view_cache_base {
+        virtual ~view_cache_base() = default;
+        uint64_t version = UINT64_MAX;
+        uint64_t rebuilds = 0;
+    };
+
+    template<class T, class... Ts>
+    struct view_cache : view_cache_base {
+        std::vector<std::tuple<ID<T>, T*, Ts*...>> entries;
+    };
+
+    inline size_t next_view_index() {
+        static std::atomic<size_t> counter = 0;
+        return counter++;
+    }
+
+    // slot of a view type in a world's view caches
+    template<class... Ts>
+    size_t view_index() {
+        static const size_t index = next_view_index();
+        return index;
+    }
+
+}
+
+// T components paired with the Ts of the same entity, skipping entities missing any of them
+// points into the world's cache, so it must not be used after that cache is rebuilt:
+// entries stay valid until view() is called again after a component of one of the types is created or erased
+template<class T, class... Ts>
+class ComponentView {
+public:
+    using entry_type = std::tuple<ID<T>, T*, Ts*...>;
+    using value_type = std::tuple<ID<T>, T&, Ts&...>;
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = ComponentView::value_type;
+
+        iterator() = default;
+        explicit iterator(const entry_type* t_ptr) : ptr(t_ptr) {}
+
+        value_type operator*() const {
+            return std::apply([](ID<T> id, T* cmp, Ts*... others) {
+                return value_type{ id, *cmp, *others... };
+            }, *ptr);
+        }
+
+        iterator& operator++() { ++ptr; return *this; }
+        iterator operator++(int) { iterator it{ *this }; ++ptr; return it; }
+
+        bool operator==(const iterator& other) const = default;
+
+    private:
+        const entry_type* ptr = nullptr;
+    };
+
+    explicit ComponentView(const detail::view_cache<T, Ts...>& t_cache)
+        : cache(&t_cache)
+        , rebuilds(t_cache.rebuilds)
+    {
+    }
+
+    iterator begin() const { return iterator{ entries().data() }; }
+    iterator end() const { return iterator{ entries().data() + entries().size() }; }
+
+    size_t size() const { return entries().size(); }
+    bool empty() const { return entries().empty(); }
+
+private:
+    const std::vector<entry_type>& entries() const {
+        assert(cache->rebuilds == rebuilds && "view used after its cache was rebuilt");
+        return cache->entries;
+    }
+
+    const detail::view_cache<T, Ts...>* cache;
+    uint64_t rebuilds;
+};
+
+}
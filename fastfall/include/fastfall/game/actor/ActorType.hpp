@@ -5,7 +5,7 @@
 #include "fastfall/render/util/Color.hpp"
 #include "fastfall/util/tag.hpp"
 #include "fastfall/util/id.hpp"
-#include "fastfall/util/copyable_uniq_ptr.hpp"
+#include "fastfall/util/id_map.hpp"
 
 #include <variant>
 #include <functional>
@@ -29,7 +29,9 @@ struct ActorInit {
 
     uint8_t get_priority() const;
     ActorInit& type_or(const ActorType* n_type);
-    copyable_unique_ptr<Actor> create() const;
+
+    // builds the actor from the level object into its slot
+    bool create(poly_id_map<Actor>& actors) const;
 };
 
 struct ActorProperty
@@ -82,7 +84,7 @@ struct ActorTypeInfo {
 class ActorType : public ActorTypeInfo {
     explicit ActorType(const ActorTypeInfo& info) : ActorTypeInfo(info) {}
 
-    using builder_fn = copyable_unique_ptr<Actor>(*)(ActorInit, const LevelObjectData&);
+    using builder_fn = void(*)(poly_id_map<Actor>&, ActorInit, const LevelObjectData&);
     builder_fn builder = nullptr;
 
     using user_builder_fn = void(*)(ActorInit, const LevelObjectData&);
@@ -93,8 +95,8 @@ public:
     {
         auto type = ActorType{ info };
         if constexpr (std::is_constructible_v<T, ActorInit, const LevelObjectData&>) {
-            type.builder = [](ActorInit init, const LevelObjectData &data) -> copyable_unique_ptr<Actor> {
-                return make_copyable_unique<Actor, T>(init, data);
+            type.builder = [](poly_id_map<Actor>& actors, ActorInit init, const LevelObjectData &data) {
+                actors.emplace_at<T>(init.actor_id, init, data);
             };
         }
         return type;
@@ -104,8 +106,11 @@ public:
         return builder;
     }
 
-    copyable_unique_ptr<Actor> build_with_data(ActorInit init, const LevelObjectData &data) const {
-        return builder ? builder(init, data) : copyable_unique_ptr<Actor>{};
+    bool build_with_data(poly_id_map<Actor>& actors, ActorInit init, const LevelObjectData &data) const {
+        if (builder) {
+            builder(actors, init, data);
+        }
+        return builder;
     }
 
 };
@@ -16,8 +16,10 @@
 #include "fastfall/game/actor/Actor.hpp"
 
 #include <memory>
+#include <map>
 #include <set>
 #include <numeric>
+#include <span>
 
 namespace ff {
 
@@ -37,7 +39,13 @@ private:
         uint8_t timer_id   = TILEDATA_NONE;
 	};
 
-	grid_vector<TileDynamic> tiles_dyn;
+	// only tiles with logic or animation, most tiles have neither
+	std::map<Vec2u, TileDynamic> tiles_dyn;
+
+	TileDynamic getTileDynamic(Vec2u tile_pos) const {
+		auto it = tiles_dyn.find(tile_pos);
+		return it != tiles_dyn.end() ? it->second : TileDynamic{};
+	}
 
 	struct dyn_t {
 		struct parallax_dyn_t {
@@ -99,6 +107,16 @@ public:
 	void setTile(World& world, const Vec2u& position, TileID tile_id, const TilesetAsset& tileset);
 	void removeTile(World& world, const Vec2u& position);
 
+	// an edit without a tileset erases the tile
+	struct TileEdit {
+		Vec2u position;
+		TileID tile_id = {};
+		const TilesetAsset* tileset = nullptr;
+	};
+
+	// sets or erases many tiles, autotiles are solved once over the edited area instead of around each tile
+	void setTiles(World& world, std::span<const TileEdit> edits);
+
     void steal_tiles(World& w, TileLayer& from, Recti area);
 
 	void shallow_copy(World& world, const TileLayer& src, Rectu src_area, Vec2u dst);
@@ -171,6 +189,9 @@ protected:
             const Vec2u& at,
             uint8_t prev_tileset_ndx,
             const TilesetAsset* next_tileset);
+
+	// adds or drops chunks for tilesets the change created or erased, then updates the changed tiles
+	void applyTileChanges(World& world, const TileLayerData::TileChangeResult& result, const TilesetAsset* tileset);
 };
 
 }
@@ -164,7 +164,9 @@ namespace ff {
         Vec2f prev_velocity;
         bool is_enabled = true;
 
-        // bool parallelize = true;
+        // update and predraw may run on a worker thread
+        // disable if the strategy's transform callbacks touch state outside this emitter
+        bool parallelize = true;
         EmitterStrategy strategy;
 
         std::vector<Particle> particles;
@@ -192,6 +194,9 @@ namespace ff {
 
         void apply_collision(const poly_id_map<ColliderRegion>& colliders, event_out_iter* events_out = nullptr);
 
+        // debug draw is not thread-safe, called separately from update
+        void debug_draw(const poly_id_map<ColliderRegion>& colliders) const;
+
         void set_drawid(ID<VertexArray> id) { varr_id = id; }
         ID<VertexArray> get_drawid() const { return varr_id; }
 
@@ -117,6 +117,7 @@ public:
 
 	Vec2f get_friction() const noexcept;
 	Vec2f get_accel() const noexcept;
+	float get_decel() const noexcept;
 
 	void applyContact(const AppliedContact& contact, ContactType type);
 
@@ -130,8 +131,9 @@ public:
 
 	const std::vector<AppliedContact>& get_contacts()   const noexcept { return currContacts; };
 
+	// swaps curr_frame in, leaving the previous frame's buffer for the caller to reuse
 	void set_frame(poly_id_map<ColliderRegion>*  colliders,
-                   std::vector<AppliedContact>&& curr_frame);
+                   std::vector<AppliedContact>& curr_frame);
 
 	void    setSlip(slip_t set) noexcept { slip = set; };
 	bool    hasSlip()   const noexcept { return slip.leeway != 0.f; };
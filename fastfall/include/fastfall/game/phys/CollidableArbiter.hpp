@@ -4,7 +4,6 @@
 #include "fastfall/game/phys/RegionArbiter.hpp"
 #include "fastfall/util/id.hpp"
 
-#include "nlohmann/json_fwd.hpp"
 #include "fastfall/util/id_map.hpp"
 
 #include <span>
@@ -13,19 +12,24 @@
 namespace ff {
 
 class World;
+class CollisionSolver;
+class CollisionTrace;
 
 class CollidableArbiter {
 public:
     ID<Collidable> collidable_id;
 	std::unordered_map<ID<ColliderRegion>, RegionArbiter> region_arbiters;
 
+	// solver and contact_buffer are scratch space, reused from one collidable to the next
 	void gather_and_solve_collisions(
             World& world,
+            CollisionSolver& solver,
+            std::vector<AppliedContact>& contact_buffer,
 			secs deltaTime,
-			nlohmann::ordered_json* dump_ptr = nullptr)
+			CollisionTrace* tracer = nullptr)
 	{
-		gather_collisions(world, deltaTime, dump_ptr);
-		solve_collisions(world, deltaTime, dump_ptr);
+		gather_collisions(world, deltaTime, tracer);
+		solve_collisions(world, solver, contact_buffer, deltaTime, tracer);
 	}
 	void erase_region(ID<ColliderRegion> region);
 
@@ -35,12 +39,14 @@ private:
 	void gather_collisions(
             World& world,
             secs deltaTime,
-            nlohmann::ordered_json* dump_ptr = nullptr);
+            CollisionTrace* tracer = nullptr);
 
 	void solve_collisions(
             World& world,
+            CollisionSolver& solver,
+            std::vector<AppliedContact>& contact_buffer,
             secs deltaTime,
-            nlohmann::ordered_json* dump_ptr = nullptr);
+            CollisionTrace* tracer = nullptr);
 
 	void update_region_arbiters(
             World& world,
@@ -53,5 +59,54 @@ private:
 
 };
 
+// rest detection for one collidable
+// once its state has come back unchanged for sleep_ticks in a row without any region around it moving or
+// changing, it's asleep: it keeps its last contacts and skips update, gather and solve until woken
+class CollidableRest {
+public:
+	constexpr static size_t sleep_ticks = 30;
+
+	// before the collidable updates, returns true if it sleeps through this tick
+	// disturbed_areas are the world space areas of regions that moved or changed this tick
+	bool prepare(const Collidable& collidable, std::span<const Rectf> disturbed_areas);
+
+	// after an awake tick is solved
+	void update(const Collidable& collidable);
+
+	// in place of the update and solve while asleep
+	// timers and contact callbacks carry on as if the same contacts were solved again
+	void sleep(World& world, Collidable& collidable, secs deltaTime) const;
+
+	void wake();
+
+	[[nodiscard]] bool is_asleep() const { return asleep; }
+	[[nodiscard]] size_t get_rest_ticks() const { return rest_ticks; }
+
+private:
+	struct snapshot_t {
+		Vec2f pos;
+		Vec2f size;
+		Vec2f local_vel;
+		Vec2f parent_vel;
+		Vec2f surface_vel;
+		Vec2f friction;
+		Vec2f gravity;
+		size_t contact_count = 0;
+		bool has_tracker = false;
+
+		bool operator==(const snapshot_t&) const = default;
+	};
+
+	static snapshot_t take_snapshot(const Collidable& collidable);
+
+	snapshot_t last;
+	size_t rest_ticks = 0;
+	bool asleep = false;
+
+	// for the current tick
+	bool idle_input = false;
+	bool disturbed  = false;
+};
+
 }
 
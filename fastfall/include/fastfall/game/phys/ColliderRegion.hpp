@@ -6,6 +6,9 @@
 
 #include <assert.h>
 #include <math.h>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace ff {
 
@@ -129,6 +132,16 @@ public:
     [[nodiscard]] QuadArea in_rect(Rectf area, bool skip_empty = true) const { return { this, area, skip_empty }; }
     [[nodiscard]] QuadLine in_line(Linef line, bool skip_empty = true) const { return { this, line, skip_empty }; }
 
+    // bulk versions of in_rect and in_line, one virtual call per region instead of several per quad
+    // writes up to out.size() quads and returns how many were found, retry with more room if that's larger
+    // the area query always skips empty tiles
+    virtual size_t collect_quads(Rectf area, std::span<quad_iter> out) const = 0;
+    virtual size_t collect_quads(Linef line, std::span<quad_iter> out, bool skip_empty) const = 0;
+
+    // as above, growing buffer until every quad fits
+    [[nodiscard]] std::span<const quad_iter> quads_in_rect(Rectf area, std::vector<quad_iter>& buffer) const;
+    [[nodiscard]] std::span<const quad_iter> quads_in_line(Linef line, std::vector<quad_iter>& buffer, bool skip_empty = true) const;
+
 	virtual void update(secs deltaTime) = 0;
 
 	virtual const ColliderQuad* get_quad(QuadID quad_id) const noexcept = 0;
@@ -152,6 +165,10 @@ public:
     [[nodiscard]] Rectf getBoundingBox() const noexcept;
     [[nodiscard]] Rectf getSweptBoundingBox() const noexcept;
 
+	// world space area whose geometry changed in place since the last call, e.g. edited tiles or a teleport
+	// consumed by the collision system to wake collidables resting nearby
+	[[nodiscard]] std::optional<Rectf> takeChangedArea() noexcept;
+
 	Vec2f velocity;
 	Vec2f delta_velocity;
 
@@ -159,12 +176,16 @@ public:
 	virtual void on_postcontact(World& w, const AppliedContact& contact, secs deltaTime) const {};
 
 protected:
+	void markChanged(Rectf area) noexcept;
+
 	Rectf boundingBox;
 	Rectf prevBoundingBox;
 
 private:
 	Vec2f prevPosition;
 	Vec2f position;
+
+	std::optional<Rectf> changedArea;
 };
 
 void imgui_component(World&w , ID<ColliderRegion> id);
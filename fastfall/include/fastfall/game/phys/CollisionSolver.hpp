@@ -3,14 +3,16 @@
 #include "fastfall/game/phys/Collidable.hpp"
 #include "fastfall/game/phys/Arbiter.hpp"
 
-#include <array>
-#include <deque>
+#include "fastfall/util/inline_vector.hpp"
 
-#include "nlohmann/json_fwd.hpp"
+#include <array>
+#include <span>
+#include <vector>
 
 namespace ff {
 
 class CollidableArbiter;
+class CollisionTrace;
 
 enum class GhostEdge {
 	None,
@@ -33,32 +35,42 @@ public:
 	};
 
 
+	// a collidable rarely has more than a few contacts per side, more spill to the heap
+	using ContactStack = inline_vector<ContinuousContact*, 8>;
+
 private:
 	// stacks that the contact get organized into
-	std::deque<ContinuousContact*> north;
-	std::deque<ContinuousContact*> south;
-	std::deque<ContinuousContact*> east;
-	std::deque<ContinuousContact*> west;
+	ContactStack north;
+	ContactStack south;
+	ContactStack east;
+	ContactStack west;
 
 	// additional stacks for transposable north/south contacts
-	std::vector<ContinuousContact*> north_alt;
-	std::vector<ContinuousContact*> south_alt;
+	ContactStack north_alt;
+	ContactStack south_alt;
 
 	// the collidable we're solving for
-    Collidable* collidable;
-    poly_id_map<ColliderRegion>* colliders;
-    std::map<CollisionID, Arbiter*> arbiters;
+    Collidable* collidable = nullptr;
+    poly_id_map<ColliderRegion>* colliders = nullptr;
+
+	// sorted by id once all contacts are pushed
+    std::vector<std::pair<CollisionID, Arbiter*>> arbiters;
 
 	// collision set of arbiters to solve
 	std::vector<ContinuousContact*> contacts;
-	std::deque<ContinuousContact> created_contacts;
 
-	// json ptr that the solver will optionally output state to
+	// reserved up front for the most wedges possible, so pointers into it stay valid
+	std::vector<ContinuousContact> created_contacts;
+
+	// trace that the solver will optionally record state to
 	// may be nullptr
-	nlohmann::ordered_json* json_dump = nullptr;
+	CollisionTrace* tracer = nullptr;
+
+	// contacts that have been applied, in order of application
+	std::vector<AppliedContact>* frame = nullptr;
 
-	// vector of contacts that have been applied, in order of application
-	std::vector<AppliedContact> frame;
+	// arbiter of the contact, or nullptr
+	Arbiter* findArbiter(const std::optional<CollisionID>& id);
 
 	// pushes contact to appropriate north/south/east/west stack
 	void pushToAStack(std::vector<ContinuousContact*>& t_contact);
@@ -69,16 +81,16 @@ private:
 	bool apply(const ContinuousContact& contact, ContactType type = ContactType::SINGLE);
 
 	// returns true if any contact is applied
-	bool applyStack(std::deque<ContinuousContact*>& stack);
-	bool applyFirst(std::deque<ContinuousContact*>& stack);
-	bool applyThenUpdateStacks(std::deque<ContinuousContact*>& stack, std::deque<ContinuousContact*>& otherStack, bool which = true);
+	bool applyStack(ContactStack& stack);
+	bool applyFirst(ContactStack& stack);
+	bool applyThenUpdateStacks(ContactStack& stack, ContactStack& otherStack, bool which = true);
 
 	// pops front of stack if discard is true, returns !discard
-	bool canApplyElseDiscard(bool discard, std::deque<ContinuousContact*>& stack);
+	bool canApplyElseDiscard(bool discard, ContactStack& stack);
 
 	// returns true if any contact is applied
 	using PickerFn = CompResult(*)(const ContinuousContact*, const ContinuousContact*, const Collidable*);
-	bool solveAxis(std::deque<ContinuousContact*>& stackA, std::deque<ContinuousContact*>& stackB, PickerFn picker);
+	bool solveAxis(ContactStack& stackA, ContactStack& stackB, PickerFn picker);
 
 	// determine if internal state will allow steep contacts to be transposed
 	bool canApplyAlt() const;
@@ -93,20 +105,24 @@ private:
 	std::optional<ContinuousContact> detectWedge(const ContinuousContact* north, const ContinuousContact* south);
 
     void updateContact(ContinuousContact* contact);
-    void updateStack(std::deque<ContinuousContact*>& stack);
+    void updateStack(ContactStack& stack);
 public:
+	CollisionSolver() = default;
 	CollisionSolver(poly_id_map<ColliderRegion>* _colliders, Collidable* _collidable);
 
+	// clears the collision set to solve for another collidable
+	// keeps the buffers, so a solver reused between collidables stops allocating
+	void reset(poly_id_map<ColliderRegion>* _colliders, Collidable* _collidable);
+
 	// add an arbiter associated with the collidable to the collision set
 	inline void pushContact(Arbiter* arb) {
         contacts.push_back(&arb->getContact());
-        arbiters.emplace(arb->id, arb);
+        arbiters.emplace_back(arb->id, arb);
     };
 
 	// attempts to resolve the combination of collisions
-	// pushed contacts will be cleared after solving
-	// returns vector of applied contact in order of application
-    std::vector<AppliedContact>&& solve(nlohmann::ordered_json* dump_ptr = nullptr);
+	// out is cleared, then filled with the applied contacts in order of application
+    std::span<const AppliedContact> solve(std::vector<AppliedContact>& out, CollisionTrace* trace_ptr = nullptr);
 
 };
 
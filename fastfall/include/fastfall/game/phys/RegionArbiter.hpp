@@ -35,7 +35,7 @@ private:
 	ID<ColliderRegion> collider_id;
 	ID<Collidable> collidable_id;
 
-    std::vector<QuadID> currQuads;
+    std::vector<ColliderRegion::quad_iter> currQuads;
 	std::map<QuadID, Arbiter> quadArbiters;
 
 };
@@ -36,6 +36,9 @@ public:
 	SurfaceTracker(Collidable* t_owner, Angle ang_min, Angle ang_max, bool inclusive = true);
 
 	CollidablePreMove  premove_update(poly_id_map<ColliderRegion>* colliders, secs deltaTime);
+
+	// advance contact_time/air_time only, premove_update does this itself
+	void update_timers(secs deltaTime);
 	CollidablePostMove postmove_update(poly_id_map<ColliderRegion>* colliders, Vec2f wish_pos, Vec2f prev_pos) const;
 
     void update_collidable_ptr(Collidable* t_owner) { owner = t_owner; }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "fastfall/game/phys/ColliderRegion.hpp"
+#include "fastfall/util/math.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// collider region containing many static convex quads, e.g. off-grid terrain
+// quads are kept in a bounding volume hierarchy so area and line queries don't visit each one
+
+namespace ff {
+
+class ColliderMesh final : public ColliderRegion {
+public:
+	// quads are relative to the region's position
+	// they're reordered for the hierarchy and given new ids, their index in get_quads()
+	// quads without any surface are put last and never returned by queries
+	explicit ColliderMesh(std::vector<ColliderQuad> quads);
+
+	void update(secs deltaTime) override;
+	[[nodiscard]] const ColliderQuad* get_quad(QuadID quad_id) const noexcept override;
+	[[nodiscard]] Rectf tile_area(QuadID quad_id) const noexcept override;
+
+	[[nodiscard]] const std::vector<ColliderQuad>& get_quads() const { return quads; }
+
+	// quads along a line are ordered by where the line enters their bounds, which may overlap
+	size_t collect_quads(Rectf area, std::span<quad_iter> out) const override;
+	size_t collect_quads(Linef line, std::span<quad_iter> out, bool skip_empty) const override;
+
+	void set_on_precontact(std::function<bool(World&, const ContinuousContact&, secs)> func);
+	void set_on_postcontact(std::function<void(World&, const AppliedContact&, secs)> func);
+
+	bool on_precontact(World& w, const ContinuousContact& contact, secs duration) const override;
+	void on_postcontact(World& w, const AppliedContact& contact, secs deltaTime) const override;
+
+protected:
+    [[nodiscard]] std::optional<QuadID> first_quad_in_rect(Rectf area, Recti& tile_area, bool skip_empty) const override;
+    [[nodiscard]] std::optional<QuadID> next_quad_in_rect(Rectf area, QuadID quadid, const Recti& tile_area, bool skip_empty) const override;
+    [[nodiscard]] std::optional<QuadID> first_quad_in_line(Linef line, Recti& tile_area, bool skip_empty) const override;
+    [[nodiscard]] std::optional<QuadID> next_quad_in_line(Linef line, QuadID quadid, const Recti& tile_area, bool skip_empty) const override;
+
+private:
+	constexpr static uint32_t max_leaf_size = 4;
+
+	// quads [first, first + count) are under this node
+	// a leaf if right is 0, otherwise the left child follows this node
+	struct Node {
+		Rectf bounds;
+		uint32_t first = 0;
+		uint32_t count = 0;
+		uint32_t right = 0;
+	};
+
+	uint32_t build_node(std::vector<uint32_t>& order, uint32_t first, uint32_t count);
+	void connect_ghosts();
+
+	// first quad touching area with an index past after
+	[[nodiscard]] std::optional<QuadID> find_quad_in_rect(Rectf local_area, int after) const;
+
+	// first quad along line past (after_t, after), by entry then index
+	[[nodiscard]] std::optional<QuadID> find_quad_in_line(Linef local_line, float after_t, int after) const;
+
+	std::function<bool(World&, const ContinuousContact&, secs)> callback_on_precontact;
+	std::function<void(World&, const AppliedContact&, secs)> callback_on_postcontact;
+
+	std::vector<ColliderQuad> quads;
+	std::vector<Rectf> quadBounds;
+	std::vector<Node> nodes;
+
+	size_t validCollisionSize = 0;
+	bool update_debugDraw = true;
+};
+
+}
@@ -17,6 +17,9 @@ public:
 	void update(secs deltaTime) override;
 	[[nodiscard]] const ColliderQuad* get_quad(QuadID quad_id) const noexcept override;
 
+	size_t collect_quads(Rectf area, std::span<quad_iter> out) const override;
+	size_t collect_quads(Linef line, std::span<quad_iter> out, bool skip_empty) const override;
+
 	void set_on_precontact(std::function<bool(World&, const ContinuousContact&, secs)> func);
 	void set_on_postcontact(std::function<void(World&, const AppliedContact&, secs)> func);
 
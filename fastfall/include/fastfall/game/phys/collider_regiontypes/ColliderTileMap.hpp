@@ -7,6 +7,8 @@
 #include "fastfall/util/log.hpp"
 #include "fastfall/util/grid_vector.hpp"
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <queue>
 #include <utility>
@@ -84,6 +86,9 @@ public:
 
     [[nodiscard]] Rectf tile_area(QuadID quad_id) const noexcept override;
 
+	size_t collect_quads(Rectf area, std::span<quad_iter> out) const override;
+	size_t collect_quads(Linef line, std::span<quad_iter> out, bool skip_empty) const override;
+
 protected:
     [[nodiscard]] std::optional<QuadID> first_quad_in_rect(Rectf area, Recti& tile_area, bool skip_empty) const override;
     [[nodiscard]] std::optional<QuadID> next_quad_in_rect(Rectf area, QuadID quadid, const Recti& tile_area, bool skip_empty) const override;
@@ -104,6 +109,14 @@ private:
 
 	std::pair<ColliderQuad*, const ColliderTile*> get_tile(const Vec2i& at);
 
+	void set_has_tile(QuadID ndx, bool has_tile);
+
+	// edge length in tiles of the largest empty pyramid block containing at, 0 if none
+	[[nodiscard]] int empty_block_size(Vec2i at) const noexcept;
+
+	// first tile the line enters after leaving the block containing at
+	[[nodiscard]] Vec2i line_exit_block(const Linef& line, Vec2i at, int block) const noexcept;
+
 	template<typename Callable>
 	void for_adjacent_touching_quads(const ColliderTile& tile, Callable&& call)
 	{
@@ -146,6 +159,20 @@ private:
 	grid_vector<ColliderQuad>	tileCollisionMap;
 	grid_vector<TileTable>		tileShapeMap;
 
+	// one bit per tile, set where tileShapeMap has a tile, rows padded to whole words
+	// lets collect_quads skip empty tiles 64 at a time
+	std::vector<uint64_t>		occupancy;
+	size_t						occupancyStride = 0;
+
+	// tile counts per 16x16 and 4x4 block, coarsest first
+	// lets collect_quads step a line over an empty block at once
+	struct OccupancyLevel {
+		unsigned shift;
+		size_t width = 0;
+		std::vector<uint16_t> counts = {};
+	};
+	std::array<OccupancyLevel, 2> occupancyLevels{ OccupancyLevel{ 4 }, OccupancyLevel{ 2 } };
+
 	Vec2i size_min;
 	Vec2i size_max;
 	Vec2u collisionMapSize;
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "fastfall/engine/time/time.hpp"
+#include "fastfall/util/math.hpp"
+#include "fastfall/game/phys/collision/Contact.hpp"
+
+#include "nlohmann/json_fwd.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ff {
+
+// binary record of the collision system's work, cheap enough to leave on while reproducing a bug
+// every record is the same fixed size POD, written into a ring buffer that overwrites the oldest
+// records once full, so the last N records are always available to save or convert to json
+
+namespace trace {
+
+struct vec2 {
+    float x;
+    float y;
+};
+
+struct rect {
+    float left;
+    float top;
+    float width;
+    float height;
+};
+
+enum class kind : uint8_t {
+    Frame,          // start of a collision update
+    Collidable,     // start of a collidable's gather and solve
+    BroadPhase,     // bounds of the gather
+    BroadCollider,  // a region in the gather
+    Section,        // start of a solver section
+    Contact,        // state of a contact at some point in the solve
+    Compare,        // result of comparing two contacts
+    Stack,          // a contact in the sorted stacks before solving an axis
+    Event,          // discarded contact, picking between two, wedge between two
+};
+
+enum class section : uint8_t {
+    Solver,
+    Compare,
+    Apply,
+    XStack,
+    YStack,
+};
+
+enum class contact_stage : uint8_t {
+    Precompare,
+    Postcompare,
+    Wedge,
+    Applied,
+};
+
+enum class stack_side : uint8_t {
+    East,
+    West,
+    North,
+    South,
+};
+
+enum class event : uint8_t {
+    DiscardNoContact,
+    DiscardNoDir,
+    DiscardApply,
+    PickingFrom,
+    WedgeFrom,
+};
+
+struct frame_t {
+    double delta;
+};
+
+struct collidable_t {
+    uint64_t id;
+    vec2 pos;
+    vec2 delta_pos;
+    vec2 local_vel;
+    vec2 parent_vel;
+    vec2 global_vel;
+    vec2 size;
+    bool has_tracker;
+    bool tracker_has_contact;
+    uint64_t tracker_collider;
+    int32_t tracker_quad;
+};
+
+struct broad_phase_t {
+    rect init_bounds;
+    rect final_bounds;
+};
+
+struct broad_collider_t {
+    uint64_t id;
+    vec2 vel;
+    vec2 pos;
+    vec2 delta_pos;
+    uint32_t arbiter_count;
+};
+
+struct section_t {
+    section which;
+};
+
+// contacts are identified by address, like the pointers printed in the json dump
+struct contact_t {
+    uint64_t handle;
+    contact_stage stage;
+    ContactType type;
+    bool has_contact;
+    bool has_impact_time;
+    bool is_transposed;
+    float separation;
+    float impact_time;
+    float stick_offset;
+    vec2 surface_p1;
+    vec2 surface_p2;
+    vec2 ortho_n;
+    vec2 collider_n;
+    vec2 velocity;
+    vec2 stick_p1;
+    vec2 stick_p2;
+    uint64_t collidable;
+    uint64_t region;
+    int32_t quad;
+};
+
+struct compare_t {
+    uint64_t first;
+    uint64_t second;
+    bool discard_first;
+    bool discard_second;
+};
+
+struct stack_t {
+    uint64_t handle;
+    stack_side side;
+};
+
+struct event_t {
+    uint64_t first;
+    uint64_t second;
+    event which;
+};
+
+struct record {
+    kind type;
+    uint32_t frame;
+    union {
+        frame_t             frame_data;
+        collidable_t        collidable;
+        broad_phase_t       broad_phase;
+        broad_collider_t    broad_collider;
+        section_t           section_data;
+        contact_t           contact;
+        compare_t           compare;
+        stack_t             stack;
+        event_t             event_data;
+    };
+};
+
+static_assert(std::is_trivially_copyable_v<record>);
+
+inline vec2 to_trace(Vec2f v) { return { v.x, v.y }; }
+inline rect to_trace(Rectf r) { return { r.left, r.top, r.width, r.height }; }
+inline uint64_t to_handle(const void* ptr) { return reinterpret_cast<uintptr_t>(ptr); }
+
+}
+
+class CollisionTrace {
+public:
+    constexpr static size_t default_capacity = 1 << 16;
+
+    explicit CollisionTrace(size_t capacity = default_capacity);
+
+    // the frame number stamped on every record from here on
+    void begin_frame(uint32_t frame, secs delta);
+    uint32_t current_frame() const { return frame; }
+
+    // stored as is, e.g. to copy records from another trace
+    void record(const trace::record& rec);
+
+    // stamped with the current frame
+    void record(const trace::collidable_t& data);
+    void record(const trace::broad_phase_t& data);
+    void record(const trace::broad_collider_t& data);
+    void record(const trace::compare_t& data);
+
+    void record_contact(trace::contact_stage stage, const ContinuousContact& contact, ContactType type = ContactType::NO_SOLUTION);
+    void record_section(trace::section which);
+    void record_stack(trace::stack_side side, std::span<ContinuousContact* const> contacts);
+    void record_event(trace::event which, const void* first, const void* second = nullptr);
+
+    // records in order, oldest first
+    std::vector<trace::record> records() const;
+
+    size_t size() const { return count; }
+    size_t capacity() const { return buffer.size(); }
+
+    // total records written, including those since overwritten
+    uint64_t total_recorded() const { return total; }
+
+    void clear();
+
+    // raw records, oldest first, with a small header
+    bool save(const std::filesystem::path& path) const;
+    static std::optional<std::vector<trace::record>> load(const std::filesystem::path& path);
+
+private:
+    std::vector<trace::record> buffer;
+    size_t head  = 0;
+    size_t count = 0;
+    uint64_t total = 0;
+    uint32_t frame = 0;
+};
+
+// converts records to the collision dump's json format, an array with one object per frame
+// frames outside [first_frame, last_frame] are skipped, as is a frame cut off by the ring buffer
+nlohmann::ordered_json trace_to_json(
+        std::span<const trace::record> records,
+        uint32_t first_frame = 0,
+        uint32_t last_frame = UINT32_MAX);
+
+}
@@ -7,6 +7,7 @@
 
 #include <list>
 #include <map>
+#include <span>
 
 
 namespace ff {
@@ -18,8 +19,8 @@ public:
 	void update(World& world, secs deltaTime);
 	void predraw(World& world, predraw_state_t predraw_state);
 
-    void notify_created(World& world, ID<Actor> id);
-    void notify_erased(World& world, ID<Actor> id);
+    void notify_created(World& world, std::span<const ID<Actor>> ids);
+    void notify_erased(World& world, std::span<const ID<Actor>> ids);
 
 protected:
     void append_created(const World& world);
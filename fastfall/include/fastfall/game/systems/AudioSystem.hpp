@@ -1,6 +1,7 @@
 #pragma once
 
-#include <unordered_set>
+#include <optional>
+#include <vector>
 #include "fastfall/util/log.hpp"
 
 #include "fastfall/engine/audio.hpp"
@@ -10,6 +11,7 @@ namespace ff {
 
     class AudioSystem {
     public:
+        AudioSystem();
 
         std::optional<SoundHandle> play(std::string_view sound_asset_name, SoundCfg cfg = {}) {
             if (SoundAsset* asset = get_asset_impl(sound_asset_name))
@@ -19,23 +21,30 @@ namespace ff {
             return std::nullopt;
         }
 
-        std::optional<SoundHandle> play(SoundAsset& sound_asset, SoundCfg cfg = {}) {
-            SoundHandle sound_handle{"game"};
-            sound_handle.config = cfg;
-            sound_handle.apply_config();
-            sound_handle.set_sound(sound_asset);
-            sound_handle.play();
-            return sound_handle;
+        std::optional<SoundHandle> play(const SoundRef& sound, SoundCfg cfg = {}) {
+            if (const SoundAsset* asset = sound.get())
+            {
+                return play(*asset, cfg);
+            }
+            return std::nullopt;
         }
 
+        // nullopt if the sound already played this tick, or no voice could be had
+        std::optional<SoundHandle> play(const SoundAsset& sound_asset, SoundCfg cfg = {});
+
         void update(secs deltaTime);
 
+        uint64_t get_deduplicated_count() const { return deduplicated; }
+
     private:
         SoundAsset* get_asset_impl(std::string_view sound_asset_name);
 
         secs upTime = 0.0;
         MIX_Group* group = nullptr;
+
+        // sounds started since the last update
+        std::vector<const SoundAsset*> played_this_tick;
+        uint64_t deduplicated = 0;
     };
 
 }
-
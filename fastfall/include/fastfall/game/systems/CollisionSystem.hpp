@@ -2,15 +2,19 @@
 
 #include "fastfall/game/phys/ColliderRegion.hpp"
 #include "fastfall/game/phys/CollidableArbiter.hpp"
+#include "fastfall/game/phys/CollisionSolver.hpp"
 #include "fastfall/game/phys/RegionArbiter.hpp"
 #include "fastfall/game/phys/collision/Contact.hpp"
+#include "fastfall/game/phys/collision/CollisionTrace.hpp"
 
 //#include "ext/plf_colony.h"
 #include "nlohmann/json_fwd.hpp"
 
+#include <span>
 #include <vector>
 #include <list>
 #include <memory>
+#include <optional>
 
 namespace ff {
 
@@ -18,17 +22,33 @@ class World;
 
 class CollisionSystem {
 public:
+	CollisionSystem() = default;
+
+	// copies don't record into the original's trace or dump
+	CollisionSystem(const CollisionSystem& other);
+	CollisionSystem& operator=(const CollisionSystem& other);
+
+	CollisionSystem(CollisionSystem&&) = default;
+	CollisionSystem& operator=(CollisionSystem&&) = default;
+
 	void update(World& world, secs deltaTime);
 
     void notify_created(World& world, ID<Collidable> id);
     void notify_created(World& world, ID<ColliderRegion> id);
 
-    void notify_erased(World& world, ID<Collidable> id);
-    void notify_erased(World& world, ID<ColliderRegion> id);
+    void notify_erased(World& world, std::span<const ID<Collidable>> ids);
+    void notify_erased(World& world, std::span<const ID<ColliderRegion>> ids);
 
 	// dump collision data from this frame into json, is reset at the end of the update
+	// recorded as a trace like any other frame, then converted
 	inline void dumpCollisionDataThisFrame(nlohmann::ordered_json* dump_ptr) { collision_dump = dump_ptr; };
 
+	// record every frame into trace until unset, see CollisionTrace
+	// the trace is the update thread's while attached, only set it or touch it while the world isn't updating
+	// (imgui is built while the update thread is idle, see Engine::run_doubleThread)
+	inline void setTrace(CollisionTrace* t_trace) { trace = t_trace; };
+	inline CollisionTrace* getTrace() const { return trace; };
+
 	inline void resetFrameCount() { frame_count = 0; };
 	inline size_t getFrameCount() const { return frame_count; };
 
@@ -36,13 +56,28 @@ public:
         return arbiters.at(id);
     }
 
+    const CollidableRest& get_rest(ID<Collidable> id) const {
+        return rest_states.at(id);
+    }
+
 private:
     std::unordered_map<ID<Collidable>, CollidableArbiter> arbiters;
+    std::unordered_map<ID<Collidable>, CollidableRest> rest_states;
+
+    // areas of regions moved, changed or created this tick, wakes collidables resting there
+    std::vector<Rectf> disturbed_areas;
+    std::vector<ID<ColliderRegion>> created_regions;
+
+    // reused by each collidable's solve
+    CollisionSolver solver;
+    std::vector<AppliedContact> contact_buffer;
 
 	size_t frame_count = 0;
 	size_t frame_collision_count = 0;
 	
 	nlohmann::ordered_json* collision_dump = nullptr;
+	std::optional<CollisionTrace> dump_trace;
+	CollisionTrace* trace = nullptr;
     //World* world;
 
 };
@@ -8,7 +8,11 @@ class World;
 
 class EmitterSystem {
 public:
+    // simulates particles, collects events for dispatch_events
     void update(World& world, secs deltaTime);
+
+    // calls each emitter's events callback, may modify the world
+    void dispatch_events(World& world, secs deltaTime);
     void predraw(World& world, predraw_state_t predraw_state);
 
     void notify_created(World &world, ID<Emitter> id);
@@ -16,6 +20,10 @@ public:
 private:
     std::vector<ParticleEvent> events;
     std::vector<int>           events_per_emitter;
+
+    // scratch for fanning out emitters across the job system
+    std::vector<Emitter*>                   emitters;
+    std::vector<std::vector<ParticleEvent>> emitter_events;
 };
 
 }
\ No newline at end of file
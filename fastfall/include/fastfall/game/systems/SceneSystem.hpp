@@ -9,6 +9,7 @@
 #include "fastfall/engine/time/time.hpp"
 #include "fastfall/game/scene/SceneConfig.hpp"
 
+#include <span>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -26,9 +27,8 @@ public:
     };
 
     void notify_created(World& world, ID<Drawable> id);
-    void notify_erased(World& world, ID<Drawable> id);
+    void notify_erased(World& world, std::span<const ID<Drawable>> ids);
 
-	void set_cam_pos(Vec2f center);
 	void set_bg_color(Color color);
 	void set_size(Vec2u size);
 
@@ -50,9 +50,6 @@ public:
 
     void draw(const World& world, RenderTarget& target, RenderState state = RenderState()) const;
 private:
-    bool enableScissor(const RenderTarget& target, Vec2f viewPos) const;
-    void disableScissor() const;
-
     std::vector<proxy_drawable_t> scene_order;
     std::unordered_set<ID<Drawable>> to_add;
     std::unordered_set<ID<Drawable>> to_erase;
@@ -64,7 +61,6 @@ private:
 
 	ShapeRectangle background;
 	Vec2f scene_size;
-	Vec2f cam_pos;
 
 };
 
@@ -4,6 +4,7 @@
 #include "fastfall/util/slot_map.hpp"
 
 #include <set>
+#include <span>
 
 namespace ff {
 
@@ -13,7 +14,7 @@ class TriggerSystem {
 public:
     void update(World& world, secs deltaTime);
     void notify_created(World& world, ID<Trigger> id);
-    void notify_erased(World& world, ID<Trigger> id);
+    void notify_erased(World& world, std::span<const ID<Trigger>> ids);
 
 private:
 	void compareTriggers(World& w, Trigger& A, Trigger& B, secs deltaTime);
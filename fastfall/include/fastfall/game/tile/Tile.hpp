@@ -7,7 +7,9 @@
 #include "fastfall/util/direction.hpp"
 #include "fastfall/util/grid_vector.hpp"
 
+#include <array>
 #include <variant>
+#include <vector>
 
 namespace ff {
 
@@ -67,6 +69,19 @@ namespace ff {
 		AutoTileOffGridSubstitute offgrid_shape
 	);
 
+	// get_autotile_state for every cell of area, in row order, using each cell's own shape
+	// each shape is read once per pass instead of once per neighbor
+	// with AUTOTILE_GRID_WRAP area may extend past the grid, positions wrap around it
+	void get_autotile_states(
+		grid_view<TileShape> grid,
+		Recti area,
+		AutoTileOffGridSubstitute offgrid_shape,
+		std::vector<TileState>& out
+	);
+
+	// occupied edges in the low four bits, inner corners in the high four
+	uint8_t autotile_mask(const TileState& state);
+
 	// Tile Constraint
 
 	namespace tile_constraint_options {
@@ -90,6 +105,35 @@ namespace ff {
 		const std::vector<TileConstraint>& constraints,
 		unsigned seed = time(0));
 
+	// auto_best_tile's candidates for every shape and autotile_mask, precomputed
+	class AutotileTable {
+	public:
+		AutotileTable() = default;
+		explicit AutotileTable(const std::vector<TileConstraint>& constraints);
+
+		// same tile as auto_best_tile with the constraints this was built from
+		std::optional<TileID> best_tile(const TileState& state, unsigned seed = time(0)) const;
+
+	private:
+		struct Candidates {
+			uint32_t first = 0;
+			uint32_t count = 0;
+		};
+
+		struct ShapeTable {
+			TileShape shape;
+
+			// a constraint tests a neighbor's shape, which the mask doesn't hold
+			// then the shape's constraints are matched as usual
+			std::vector<TileConstraint> shape_constraints;
+
+			std::array<Candidates, 256> by_mask;
+		};
+
+		std::vector<ShapeTable> shapes;
+		std::vector<TileID> candidates;
+	};
+
 	// Tile Material
 
 	struct SurfaceMaterial {
@@ -20,7 +20,7 @@ public:
 	ChunkVertexArray(ChunkVertexArray&&) noexcept = default;
 	ChunkVertexArray& operator=(ChunkVertexArray&&) noexcept = default;
 
-	void setTexture(const Texture& texture) noexcept;
+	void setTexture(const Texture& texture, Recti area = {}) noexcept;
 	const TextureRef& getTexture() const noexcept;
 
 	void setTile(Vec2u at, TileID tile) { 
@@ -73,6 +73,7 @@ private:
 	Vec2u m_chunk_size;
 
 	TextureRef m_tex;
+	Recti m_tex_area;
 	std::vector<Chunk> m_chunks;
 
 	struct Command {
@@ -3,6 +3,7 @@
 #include "fastfall/render/drawable/VertexArray.hpp"
 #include "Drawable.hpp"
 #include "fastfall/render/util/Font.hpp"
+#include "fastfall/render/util/TextLayout.hpp"
 
 #include "fastfall/util/math.hpp"
 
@@ -18,6 +19,14 @@ namespace ff {
 		Text(Font& font);
 		Text(Font& font, unsigned size);
 		Text(Font& font, unsigned size, std::string_view text);
+		~Text();
+
+		// copies get their own gpu buffers
+		Text(const Text& rhs);
+		Text& operator=(const Text& rhs);
+
+		Text(Text&& rhs) noexcept;
+		Text& operator=(Text&& rhs) noexcept;
 
 		using const_font_ref = std::reference_wrapper<const Font>;
 
@@ -41,7 +50,12 @@ namespace ff {
 		};
 		Color getColor() const { return m_color; }
 
-		void setVertSpacing(float spacing_factor) { v_spacing = spacing_factor; };
+		void setVertSpacing(float spacing_factor) {
+			if (v_spacing != spacing_factor) {
+				v_spacing = spacing_factor;
+				gl_text_fresh = false;
+			}
+		};
 
 	private:
 
@@ -62,6 +76,8 @@ namespace ff {
 			bool m_bound = false;
 
 			bool sync = false;
+			// first character changed since the last transfer
+			size_t dirty_begin = 0;
 		} mutable gl;
 
 		friend class RenderTarget;
@@ -72,10 +88,13 @@ namespace ff {
 		void update_text();
 
 		std::string m_text;
+		TextLayout m_layout;
 		//VertexArray m_varr;
 		Rectf bounding_size;
 
-		TextureRef bitmap_texture;
+		// refreshed by RenderTarget once the font loads the bitmap
+		mutable TextureRef bitmap_texture;
+		mutable Recti bitmap_area;
 
 		unsigned px_size = 0;
 
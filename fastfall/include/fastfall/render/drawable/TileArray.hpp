@@ -23,7 +23,8 @@ public:
 	TileArray(TileArray&& rhs) noexcept;
 	TileArray& operator=(TileArray&& rhs) noexcept;
 
-	void setTexture(const Texture& texture) noexcept;
+	// area is the tileset's place on the texture, empty for the whole texture
+	void setTexture(const Texture& texture, Recti area = {}) noexcept;
 	const TextureRef& getTexture() const noexcept;
 	void setTile(Vec2u at, TileID tile);
 	void blank(Vec2u at);
@@ -53,6 +54,7 @@ private:
 
 private:
 	TextureRef m_tex;
+	Recti m_tex_area;
 
 	Vec2u m_size;
 
@@ -29,6 +29,7 @@ namespace ff::render {
 
 namespace ff {
 	void ImGuiNewFrame(Window& window);
+	void ImGuiEndFrame(); // finishes the frame's draw data, no opengl calls
 	void ImGuiRender();
 }
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "RenderTarget.hpp"
+
+#include "fastfall/render/drawable/VertexArray.hpp"
+#include "fastfall/render/drawable/TileArray.hpp"
+#include "fastfall/render/drawable/Text.hpp"
+
+#include <vector>
+
+namespace ff {
+
+// records what is drawn to it, to be replayed onto another target later, possibly from another thread
+// vertex, tile and text data is copied as it's drawn, the drawables are free to change once recording is done
+// recording makes no opengl calls, debug draws can't be recorded
+class DrawList : public RenderTarget {
+public:
+	using RenderTarget::draw;
+
+	glm::ivec2 getSize() const override { return { 0, 0 }; };
+
+	void draw(const VertexArray& varray, const RenderState& state = RenderState()) override;
+	void draw(const TileArray& tarray, RenderState state = RenderState()) override;
+	void draw(const Text& text, RenderState state = RenderState()) override;
+
+	void enableScissor(Rectf area) override;
+	void disableScissor() override;
+
+	// forget the recorded draws, the copies are kept so the next recording reuses them and their gpu buffers
+	void reset();
+
+	void replay(RenderTarget& target) const;
+
+	size_t size() const { return m_commands.size(); };
+
+private:
+	enum class Command : uint8_t {
+		VertexArray,
+		TileArray,
+		Text,
+		EnableScissor,
+		DisableScissor
+	};
+
+	struct command_t {
+		Command type;
+		size_t index = 0; // into the copies of its type
+		RenderState state;
+		Rectf area;
+	};
+
+	template<class T>
+	struct copies_t {
+		std::vector<T> items;
+		size_t count = 0;
+
+		size_t copy(const T& drawable) {
+			if (count < items.size()) {
+				items[count] = drawable;
+			}
+			else {
+				items.push_back(drawable);
+			}
+			return count++;
+		}
+
+		void reset() {
+			count = 0;
+		}
+	};
+
+	std::vector<command_t> m_commands;
+
+	copies_t<VertexArray> m_varrays;
+	copies_t<TileArray>   m_tarrays;
+	copies_t<Text>        m_texts;
+};
+
+}
@@ -3,6 +3,7 @@
 #include "fastfall/render/util/Color.hpp"
 #include "fastfall/render/util/View.hpp"
 #include "fastfall/render/util/RenderState.hpp"
+#include "fastfall/util/Rect.hpp"
 //#include "VertexArray.hpp"
 //#include "TileArray.hpp"
 
@@ -39,11 +40,15 @@ public:
 	void setDefaultView();
 
 	void draw(const Drawable& drawable, const RenderState& state = RenderState());
-	void draw(const VertexArray& varray, const RenderState& state = RenderState());
-	void draw(const TileArray& varray, RenderState state = RenderState());
-	void draw(const Text& text, RenderState state = RenderState());
+	virtual void draw(const VertexArray& varray, const RenderState& state = RenderState());
+	virtual void draw(const TileArray& varray, RenderState state = RenderState());
+	virtual void draw(const Text& text, RenderState state = RenderState());
     void draw(debug::detail::state_t& debug, debug::detail::gpu_state_t& gl, RenderState state = RenderState());
 
+	// clip draws to the part of the viewport showing area, the whole viewport if area is empty
+	virtual void enableScissor(Rectf area);
+	virtual void disableScissor();
+
 	size_t getVertexCounter() { return vertex_draw_counter; }
 	void resetVertexCounter() { vertex_draw_counter = 0; }
 
@@ -72,12 +77,15 @@ private:
 	void bindFramebuffer() const;
 
 	void applyBlend(const BlendMode& blend) const;
-	void applyShader(const ShaderProgram* shader) const;
+	bool shaderChanged(const ShaderProgram* shader) const;
+	void applyShader(const ShaderProgram* shader);
 	void applyUniforms(const Transform& transform, const RenderState& state) const;
 	void applyTexture(const TextureRef& texture) const;
 
 	size_t vertex_draw_counter = 0;
 	size_t draw_call_counter = 0;
+
+	uint32_t boundShaderGeneration = 0;
 };
 
 }
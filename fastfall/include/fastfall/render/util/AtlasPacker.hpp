@@ -0,0 +1,78 @@
+#pragma once
+
+#include "fastfall/util/math.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace ff {
+
+// location of an image packed into an atlas, area is in page pixels
+struct AtlasRegion {
+	unsigned page = 0;
+	Recti area;
+
+	// maps a pixel rect of the source image to page pixels
+	Rectf toPage(Rectf local) const {
+		return Rectf{ local.left + area.left, local.top + area.top, local.width, local.height };
+	}
+
+	// maps a pixel position of the source image to normalized page coordinates
+	Vec2f toUV(Vec2f local, Vec2u page_size) const {
+		return Vec2f{
+			(local.x + area.left) / static_cast<float>(page_size.x),
+			(local.y + area.top)  / static_cast<float>(page_size.y)
+		};
+	}
+
+	bool operator==(const AtlasRegion&) const = default;
+};
+
+// skyline bottom-left packer
+// places rects on the lowest fitting spot of a page, opening a new page when none of the current ones fit
+class AtlasPacker {
+public:
+	explicit AtlasPacker(Vec2u t_page_size, unsigned t_padding = 1);
+
+	// nullopt if size is empty or larger than a page
+	std::optional<AtlasRegion> insert(Vec2u size);
+
+	// packs tallest first for a tighter fit, results are in the order of sizes
+	std::vector<std::optional<AtlasRegion>> insert(std::span<const Vec2u> sizes);
+
+	void clear();
+
+	size_t pageCount() const { return pages.size(); }
+	Vec2u pageSize() const { return page_size; }
+	unsigned padding() const { return pad; }
+
+	// fraction of the page covered by packed rects, padding excluded
+	float occupancy(unsigned page) const;
+
+private:
+	// top edge of the packed area over [x, x + width)
+	struct Segment {
+		int x;
+		int y;
+		int width;
+	};
+
+	struct Page {
+		std::vector<Segment> skyline;
+		size_t used_area = 0;
+	};
+
+	std::optional<Vec2i> findPosition(const Page& page, Vec2i size, size_t& segment) const;
+	void place(Page& page, size_t segment, Vec2i pos, Vec2i size);
+
+	Vec2u page_size;
+	unsigned pad;
+	std::vector<Page> pages;
+};
+
+// copies a tightly packed rgba image into a page's pixel buffer at the region's area
+void atlasBlit(std::span<uint8_t> page_pixels, Vec2u page_size, const AtlasRegion& region, const uint8_t* src_pixels, size_t src_pitch);
+
+}
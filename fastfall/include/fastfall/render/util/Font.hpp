@@ -7,6 +7,7 @@
 #include "fastfall/util/Vec2.hpp"
 #include "fastfall/render/external/freetype.hpp"
 #include "Texture.hpp"
+#include "TextureAtlas.hpp"
 
 namespace ff {
 
@@ -40,9 +41,20 @@ public:
 	bool cachePixelSize(unsigned pixel_size) const;
 	bool setPixelSize(unsigned pixel_size) const;
 
-	const Texture& getBitmapTex() const { return curr_cache->bitmap_texture; };
+	const Texture& getBitmapTex() const { return curr_cache->getTexture(); };
+	Recti getBitmapArea() const { return curr_cache->getArea(); };
 	void loadBitmapTex(unsigned px_size) const;
 
+	struct Bitmap {
+		const Texture* texture = nullptr;
+		Recti area;
+	};
+	// texture is null if the size isn't cached
+	Bitmap getBitmap(unsigned px_size) const;
+
+	// glyph bitmaps are packed into the atlas when loaded, null for a texture per pixel size
+	static void setGlyphAtlas(TextureAtlas* atlas) { glyph_atlas = atlas; }
+
 	const GlyphMetrics& getMetrics(unsigned char ch) const { return curr_cache->glyph_metrics[ch]; };
 	glm::i64vec2		getGlyphSize() const { return curr_cache->glyph_max_size; };
 	unsigned			getPixelSize() const { return curr_cache->px_size; };
@@ -53,6 +65,9 @@ public:
 
 	bool isLoaded() const { return m_face != nullptr; }
 
+	// unique per loaded face, zero if unloaded
+	uint64_t getId() const { return m_id; }
+
 	constexpr static uint8_t CHAR_COUNT = 128;
 
 private:
@@ -78,17 +93,30 @@ private:
 		SDL_Surface* bitmap_surface = nullptr;
 		Texture bitmap_texture;
 
+		const Texture* atlas_page = nullptr;
+		Recti atlas_area;
+
+		const Texture& getTexture() const { return atlas_page ? *atlas_page : bitmap_texture; }
+		Recti getArea() const {
+			return atlas_page ? atlas_area : Recti{ Vec2i{}, Vec2i{ (int)bitmap_texture.size().x, (int)bitmap_texture.size().y } };
+		}
+
 		glm::i64vec2 glyph_max_size = { 0, 0 };
 		std::array<GlyphMetrics, CHAR_COUNT> glyph_metrics;
 	};
 
+	FontCache* find_cache(unsigned size) const;
 	FontCache* cache_for_size(unsigned size) const;
 
 	FT_Face m_face = nullptr;
+	uint64_t m_id = 0;
 
 	mutable std::vector<std::unique_ptr<FontCache>> caches;
 	mutable FontCache* curr_cache = nullptr;
 
+	static TextureAtlas* glyph_atlas;
+	static uint64_t id_counter;
+
 };
 
 }
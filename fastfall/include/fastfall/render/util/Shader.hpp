@@ -6,13 +6,23 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #include "GL/glew.h"
 #include "SDL3/SDL.h"
 #include "SDL3/SDL_opengl.h"
 
+#include "glm/glm.hpp"
+
 namespace ff {
 
+template<class T>
+struct Uniform;
+
 enum class ShaderType {
 	VERTEX,
 	FRAGMENT,
@@ -31,8 +41,16 @@ public:
         GLint       loc;
         GLenum      type;
         std::string name;
+
+        // last value sent to this uniform, so unchanged values aren't re-sent
+        mutable std::array<std::byte, sizeof(glm::mat4)> cached_value{};
+        mutable bool has_cached_value = false;
     };
 
+    // interned uniform name, resolved to a uniform once per linked program
+    using UniformID = uint16_t;
+    static UniformID uniformID(std::string_view name);
+
 	ShaderProgram() = default;
     ShaderProgram(const ShaderProgram& other) = delete;
     ShaderProgram(ShaderProgram&& other) noexcept;
@@ -48,6 +66,11 @@ public:
 	void use() const;
 
     const gl_uniform*   getUniform(std::string_view name) const;
+    const gl_uniform*   getUniform(UniformID uniform_id) const;
+
+    // program must be in use, returns false if the program has no such uniform
+    template<class T>
+    bool setUniform(const Uniform<T>& uniform, const T& value) const;
     const gl_attribute* getAttribute(std::string_view name) const;
 
     const std::vector<gl_attribute>& all_attributes() const { return attributes; }
@@ -60,16 +83,62 @@ public:
 	bool isInitialized() const { return id != 0; };
 	unsigned int getID() const { return id; };
 
+	// unique to each link, changes when the program is recompiled (such as on hot reload)
+	uint32_t getGeneration() const { return generation; };
+
 private:
     unsigned int id  = 0;
+    uint32_t generation = 0;
 	bool initialized = false;
     bool m_is_linked = false;
 
     std::vector<gl_attribute> attributes;
     std::vector<gl_uniform>   uniforms;
 	std::vector<unsigned int> shaders;
+
+    // UniformID to index in uniforms, filled in as ids are looked up
+    constexpr static int16_t UniformUnresolved = -2;
+    constexpr static int16_t UniformMissing    = -1;
+    mutable std::vector<int16_t> uniform_lookup;
 };
 
+namespace detail {
+    void uploadUniform(GLint loc, GLint value);
+    void uploadUniform(GLint loc, GLuint value);
+    void uploadUniform(GLint loc, float value);
+    void uploadUniform(GLint loc, const glm::vec2& value);
+    void uploadUniform(GLint loc, const glm::vec4& value);
+    void uploadUniform(GLint loc, const glm::mat3& value);
+}
+
+template<class T>
+struct Uniform {
+    explicit Uniform(std::string_view name)
+        : id(ShaderProgram::uniformID(name))
+    {
+    }
+
+    ShaderProgram::UniformID id;
+};
+
+template<class T>
+bool ShaderProgram::setUniform(const Uniform<T>& uniform, const T& value) const {
+    static_assert(sizeof(T) <= sizeof(gl_uniform::cached_value));
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    const gl_uniform* uni = getUniform(uniform.id);
+    if (!uni)
+        return false;
+
+    if (uni->has_cached_value && std::memcmp(uni->cached_value.data(), &value, sizeof(T)) == 0)
+        return true;
+
+    detail::uploadUniform(uni->loc, value);
+    std::memcpy(uni->cached_value.data(), &value, sizeof(T));
+    uni->has_cached_value = true;
+    return true;
+}
+
 std::string_view uniformTypeEnumToString(GLenum type);
 
 }
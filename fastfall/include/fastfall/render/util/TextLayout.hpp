@@ -0,0 +1,92 @@
+#pragma once
+
+#include "fastfall/util/math.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ff {
+
+class Font;
+
+// glyph positions for a string at a font and pixel size, independent of color and transform
+struct TextLayout {
+	struct Glyph {
+		Vec2f offset;
+		uint8_t character = 0;
+
+		bool operator==(const Glyph&) const = default;
+	};
+
+	// pen state before each character of the text, lets a layout resume partway through
+	struct Step {
+		Vec2f pen;
+		Rectf bounds;
+		uint32_t glyph_count = 0;
+	};
+
+	uint64_t font_id = 0;
+	unsigned px_size = 0;
+	float v_spacing = 1.f;
+	std::string text;
+
+	std::vector<Glyph> glyphs;
+	std::vector<Step> steps;
+	Rectf bounds;
+
+	bool matches(uint64_t t_font_id, unsigned t_px_size, float t_v_spacing, std::string_view t_text) const {
+		return font_id == t_font_id
+			&& px_size == t_px_size
+			&& v_spacing == t_v_spacing
+			&& text == t_text;
+	}
+
+	// lays out text, only characters after the prefix shared with the previous text are redone
+	// returns false if the font can't be set to the pixel size
+	bool build(const Font& font, unsigned t_px_size, float t_v_spacing, std::string_view t_text);
+
+	void clear();
+};
+
+// recently built layouts, least recently used is replaced when full
+// for text that cycles between a few strings, or many texts showing the same string
+class TextLayoutCache {
+public:
+	explicit TextLayoutCache(size_t t_capacity = 64);
+
+	// null on miss
+	const TextLayout* find(uint64_t font_id, unsigned px_size, float v_spacing, std::string_view text);
+
+	// copies the layout into the cache
+	void insert(const TextLayout& layout);
+
+	void clear();
+
+	size_t size() const { return entries.size(); }
+	size_t capacity() const { return max_entries; }
+
+	size_t hits() const { return hit_count; }
+	size_t misses() const { return miss_count; }
+
+private:
+	static uint64_t hash(uint64_t font_id, unsigned px_size, float v_spacing, std::string_view text);
+
+	struct Entry {
+		uint64_t key = 0;
+		uint64_t last_used = 0;
+		TextLayout layout;
+	};
+
+	Entry* find_entry(uint64_t key, uint64_t font_id, unsigned px_size, float v_spacing, std::string_view text);
+
+	std::vector<Entry> entries;
+	size_t max_entries;
+	uint64_t use_counter = 0;
+
+	size_t hit_count = 0;
+	size_t miss_count = 0;
+};
+
+}
@@ -51,6 +51,10 @@ public:
     bool loadFromFile(const std::filesystem::path& filename);
 	bool loadFromStream(const void* data, short length);
 	bool loadFromSurface(const SDL_Surface* surface);
+	bool loadFromPixels(const void* rgba, glm::uvec2 size);
+
+	// overwrites part of the texture with tightly packed rgba pixels
+	bool update(const void* rgba, glm::uvec2 offset, glm::uvec2 size);
 
 	bool create(glm::uvec2 size);
 	bool create(unsigned sizeX, unsigned sizeY);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "fastfall/render/util/AtlasPacker.hpp"
+#include "fastfall/render/util/Texture.hpp"
+
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace ff {
+
+// packs images into a few large texture pages so drawables sharing a page don't rebind textures
+// pages are assembled on the cpu and sent to the gpu on upload(),
+// images added to a page that's already on the gpu are uploaded immediately
+class TextureAtlas {
+public:
+	static constexpr Vec2u DefaultPageSize = { 2048, 2048 };
+
+	explicit TextureAtlas(Vec2u page_size = DefaultPageSize, unsigned padding = 1);
+
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+	// nullopt if the image doesn't fit on a page
+	std::optional<AtlasRegion> add(const SDL_Surface* surface);
+
+	// overwrites a region with an image of the same size
+	bool replace(const AtlasRegion& region, const SDL_Surface* surface);
+
+	void upload();
+	void clear();
+
+	// page textures keep their address until clear()
+	const Texture& getPage(unsigned page) const { return pages.at(page).texture; }
+	size_t pageCount() const { return pages.size(); }
+	Vec2u pageSize() const { return packer.pageSize(); }
+	float occupancy(unsigned page) const { return packer.occupancy(page); }
+
+private:
+	struct Page {
+		std::vector<uint8_t> pixels;
+		Texture texture;
+	};
+
+	bool copySurface(const AtlasRegion& region, const SDL_Surface* surface);
+
+	AtlasPacker packer;
+	std::deque<Page> pages;
+};
+
+}
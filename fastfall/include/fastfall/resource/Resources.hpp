@@ -46,6 +46,12 @@ private:
 
     std::filesystem::path curr_root;
 
+    // incremented whenever assets are added or removed, for handles caching asset pointers
+    uint32_t generation = 1;
+
+    // shared by sprite, tileset and glyph images
+    TextureAtlas atlas;
+
     constexpr auto all_asset_types() {
         return std::tie(
             shaders,
@@ -85,6 +91,9 @@ private:
 
     bool loadAssetsFromDirectory(const std::filesystem::path& asset_dir);
 
+    // packs sprite and tileset images loaded since the last call into the atlas
+    void packTextures();
+
 
 
 public:
@@ -109,9 +118,14 @@ public:
         static std::mutex mut;
         const std::lock_guard<std::mutex> lock(mut);
         auto r = resource.asset_map_for<Type>().emplace(filename, std::move(asset));
+        resource.generation++;
         return *r.first->second.get();
     }
 
+    static uint32_t getGeneration() { return resource.generation; }
+
+    static const TextureAtlas& getAtlas() { return resource.atlas; }
+
     static bool loadAll(std::filesystem::path root);
     static void unloadAll();
 	static bool reloadOutOfDateAssets();
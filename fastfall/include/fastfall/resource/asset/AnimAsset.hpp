@@ -49,6 +49,9 @@ public:
 	const std::string_view get_sprite_name() const noexcept;
 	const Texture& get_sprite_texture() const noexcept;
 
+	// area of the animation's first frame on get_sprite_texture()
+	Recti get_texture_area() const noexcept;
+
 	std::string anim_name;
 	AnimID anim_id;
 
@@ -35,4 +35,24 @@ private:
     std::vector<std::string> uniforms;
 };
 
+// shader asset resolved by name once, instead of a lookup per draw
+// re-resolved only when resources are loaded or unloaded, hot reloading keeps the same asset
+class ShaderHandle {
+public:
+    explicit constexpr ShaderHandle(std::string_view asset_name)
+        : name(asset_name)
+    {
+    }
+
+    // nullptr if the shader isn't loaded
+    const ShaderProgram* get() const;
+
+    std::string_view getName() const { return name; }
+
+private:
+    std::string_view name;
+    mutable ShaderAsset* asset = nullptr;
+    mutable uint32_t resources_generation = 0;
+};
+
 }
\ No newline at end of file
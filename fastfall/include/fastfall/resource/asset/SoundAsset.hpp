@@ -24,4 +24,24 @@ private:
     MIX_Audio* audio_impl = nullptr;
 };
 
+// sound asset resolved by name once, instead of a lookup per play
+// re-resolved only when resources are loaded or unloaded
+class SoundRef {
+public:
+    explicit constexpr SoundRef(std::string_view asset_name)
+        : name(asset_name)
+    {
+    }
+
+    // nullptr if the sound isn't loaded
+    const SoundAsset* get() const;
+
+    std::string_view get_name() const { return name; }
+
+private:
+    std::string_view name;
+    mutable const SoundAsset* asset = nullptr;
+    mutable uint32_t resources_generation = 0;
+};
+
 }
\ No newline at end of file
@@ -4,6 +4,10 @@
 //#include <SFML/Graphics.hpp>
 
 #include "fastfall/render/util/Texture.hpp"
+#include "fastfall/render/util/TextureAtlas.hpp"
+
+#include <memory>
+#include <optional>
 
 namespace ff {
 
@@ -11,10 +15,22 @@ class TextureAsset : public Asset {
 public:
 	TextureAsset(const std::filesystem::path& t_asset_path);
 
+	// the atlas page once packed
 	inline const Texture& getTexture() const noexcept {
-		return tex;
+		return atlas_region ? packed_atlas->getPage(atlas_region->page) : tex;
 	}
 
+	// area of the image on getTexture()
+	Recti getTextureArea() const noexcept;
+
+	// moves the image loaded since the last pack into the atlas,
+	// a reloaded image of the same size overwrites its old region.
+	// the image is only uploaded to a texture of its own if it doesn't fit
+	void packIntoAtlas(TextureAtlas& atlas);
+
+	bool hasUnpackedImage() const noexcept { return image != nullptr; }
+	Vec2u getImageSize() const noexcept { return image_size; }
+
     void set_texture_path(const std::filesystem::path& t_tex_path);
 
 	bool loadFromFile() override;
@@ -26,6 +42,8 @@ public:
 	inline auto get_texture_path() const noexcept { return texture_path; };
 
 protected:
+	bool loadImage();
+	void ImGui_image() const;
 
     std::filesystem::path texture_path;
 
@@ -33,6 +51,17 @@ protected:
 	bool imgui_showTex = false;
 
 	Texture tex;
+
+	struct SurfaceDeleter {
+		void operator()(SDL_Surface* surface) const { SDL_DestroySurface(surface); }
+	};
+
+	// cpu copy of the image, kept until packed
+	std::unique_ptr<SDL_Surface, SurfaceDeleter> image;
+	Vec2u image_size;
+
+	TextureAtlas* packed_atlas = nullptr;
+	std::optional<AtlasRegion> atlas_region;
 };
 
 }
\ No newline at end of file
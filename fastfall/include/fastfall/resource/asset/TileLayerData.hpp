@@ -18,14 +18,17 @@ namespace ff {
 // represents a layer of tile data
 class TileLayerData {
 private:
+    // one cell, packed into 32 bits. its position is its place in the grid
     struct TileData {
-        bool has_tile		= false;
-        bool is_autotile	= false;
-        Vec2u	pos			= {};
-        TileID	base_id		= {};
-        TileID	tile_id		= {};
-        uint8_t tileset_ndx = UINT8_MAX;
+        TileID	tile_id		    = {};
+        uint8_t tileset_ndx     = UINT8_MAX;
+        uint8_t autotile_ndx    = UINT8_MAX; // into autotile_bases
+
+        inline bool has_tile() const { return tileset_ndx != UINT8_MAX; }
+        inline bool is_autotile() const { return autotile_ndx != UINT8_MAX; }
     };
+    static_assert(sizeof(TileData) == 4);
+
     struct TilesetData {
         const TilesetAsset* tileset;
         unsigned tile_count;
@@ -46,6 +49,9 @@ private:
 	grid_vector<TileShape>      shapes;
 	std::vector<TilesetData>    tilesets;
 
+	// tiles placed as autotiles, a layer rarely uses more than a few
+	std::vector<TileID>         autotile_bases;
+
 public:
 
 	struct TileChange {
@@ -68,6 +74,7 @@ public:
 	struct TileChangeResult {
         uint8_t erased_tileset = UINT8_MAX;
         bool created_tileset = false;
+        bool shape_changed = false;
 		TileChangeArray changes;
 	};
 
@@ -100,6 +107,14 @@ public:
 	TileChangeResult setTile(Vec2u at, TileID tile_id, const TilesetAsset& tileset);
 	TileChangeResult removeTile(Vec2u at);
 
+	// for editing many tiles at once, setTile and removeTile without autotiling the tile or its neighbors
+	// follow with solveAutotiles over the edited area, grown by a tile if any shape changed
+	TileChangeResult placeTile(Vec2u at, TileID tile_id, const TilesetAsset& tileset);
+	TileChangeResult clearTile(Vec2u at);
+
+	// picks tiles for each autotile in area from their neighbors' shapes, appending the tiles that changed
+	void solveAutotiles(Recti area, std::vector<TileChange>& changes);
+
 	std::string_view getName() const { return layer_name; };
 	void setName(std::string_view name) { layer_name = name; };
 
@@ -114,6 +129,11 @@ public:
 		return ndx < tilesets.size() ? tilesets.at(ndx).tileset : nullptr;
 	}
 
+	// the tile as placed, before autotiling substituted it
+	TileID getBaseID(const TileData& tile) const {
+		return tile.is_autotile() ? autotile_bases[tile.autotile_ndx] : tile.tile_id;
+	}
+
     void set_autotile_substitute(TileShape sub) noexcept { autotile_default = sub; }
     TileShape get_autotile_substitute() const noexcept { return autotile_default; }
 
@@ -128,7 +148,15 @@ private:
     tileset_state_t decrTileset(const TilesetAsset& asset);
     tileset_state_t decrTileset(uint8_t asset_ndx);
 
-	void setShape(Vec2u at, TileShape shape, TileChangeArray& changes);
+    uint8_t autotileNdx(TileID base_id);
+
+	bool setShape(Vec2u at, TileShape shape);
+
+	// changes gets the tiles that changed, tiles solved outside the grid wrap around it when scrolling
+	void solveAutotiles(Recti area, TileChangeArray* changes = nullptr);
+
+	template<class OnChange>
+	void solveAutotilesImpl(Recti area, OnChange&& on_change);
 };
 
 }
\ No newline at end of file
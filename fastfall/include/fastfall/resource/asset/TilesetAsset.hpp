@@ -52,6 +52,7 @@ protected:
 	std::vector<TilesetLogic>	tileLogic;	// name and params of tile logic
 	std::vector<std::string>	tileMat;	// name of material
 	std::vector<TileConstraint> constraints;
+	AutotileTable               autotileTable;
 
 	const static std::map<std::string, void(*)(TilesetAsset&, TileData&, char*)> tileProperties;
 
@@ -86,6 +87,7 @@ public:
     uint8_t             getFrameDelay(TileID tile_id) const;
 
 	const std::vector<TileConstraint>& getConstraints() const { return constraints; };
+	const AutotileTable& getAutotileTable() const { return autotileTable; };
 	std::optional<TileID> getAutoTileForShape(TileShape shape) const;
 
     std::vector<std::filesystem::path> getDependencies() const override {
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// heap allocation counting
+// when linked with fastfall_alloc_hook the global operator new is replaced to count allocations,
+// counting is off until set_enabled(true), so the cost otherwise is a single relaxed load per allocation
+
+namespace ff::alloc {
+
+struct Stats {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+
+    Stats& operator+=(const Stats& other) {
+        count += other.count;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+class Scope;
+
+namespace detail {
+    void track(size_t size);
+
+    // called by the hook when it's linked in
+    void set_hook_installed();
+}
+
+// true if the allocation hook was linked in
+bool hook_installed();
+
+void set_enabled(bool enabled);
+bool is_enabled();
+
+// allocations counted across all threads
+Stats global_stats();
+
+// attributes allocations made on this thread while alive to the innermost scope,
+// a scope's stats include those of the scopes nested in it once they've ended
+class Scope {
+public:
+    Scope();
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    const Stats& stats() const { return totals; }
+
+private:
+    Scope* parent;
+    Stats totals;
+
+    friend void detail::track(size_t size);
+};
+
+// counts the allocations fn makes on the calling thread
+// jobs fn hands to other threads are not counted
+template<class Fn>
+Stats count_allocations(Fn&& fn) {
+    bool was_enabled = is_enabled();
+    set_enabled(true);
+
+    Stats stats;
+    {
+        Scope scope;
+        std::forward<Fn>(fn)();
+        stats = scope.stats();
+    }
+
+    set_enabled(was_enabled);
+    return stats;
+}
+
+}
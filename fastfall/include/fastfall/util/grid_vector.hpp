@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <stdexcept>
 
+#include <bit>
 #include <concepts>
 #include <optional>
 
@@ -16,19 +17,92 @@ namespace ff {
 			{ v.x } -> std::convertible_to<std::size_t>;
 			{ v.y } -> std::convertible_to<std::size_t>;
 		};
+
+		// where a view or iterator over a layout that isn't linear sits in its source grid
+		// linear layouts step a pointer instead, so they store none of it
+		template<typename Ptr, bool IsLinear>
+		struct grid_origin {
+			constexpr grid_origin() noexcept = default;
+			constexpr grid_origin(Ptr base, std::size_t left, std::size_t top, std::size_t src_columns) noexcept
+				: m_base(base)
+				, m_left(left)
+				, m_top(top)
+				, m_src_columns(src_columns)
+			{
+			}
+
+			constexpr grid_origin offset_by(std::size_t left, std::size_t top) const noexcept {
+				return { m_base, m_left + left, m_top + top, m_src_columns };
+			}
+
+			Ptr m_base = nullptr;
+			std::size_t m_left = 0;
+			std::size_t m_top = 0;
+			std::size_t m_src_columns = 0;
+		};
+
+		template<typename Ptr>
+		struct grid_origin<Ptr, true> {
+			constexpr grid_origin() noexcept = default;
+			constexpr grid_origin(Ptr, std::size_t, std::size_t, std::size_t) noexcept {}
+
+			constexpr grid_origin offset_by(std::size_t, std::size_t) const noexcept { return {}; }
+		};
 	}
 
-	template<typename T>
+	// where a grid's cells are stored, a layout provides:
+	//   is_linear, whether rows are stored one after another
+	//   storage_size(columns, rows), cells allocated for a grid of that size
+	//   offset(column, row, columns), index of that cell in storage
+	namespace grid_layout {
+
+		struct row_major {
+			static constexpr bool is_linear = true;
+
+			static constexpr size_t storage_size(size_t columns, size_t rows) noexcept {
+				return columns * rows;
+			}
+			static constexpr size_t offset(size_t column, size_t row, size_t columns) noexcept {
+				return row * columns + column;
+			}
+		};
+
+		// square blocks of cells stored one after another, blocks in row order
+		// a cell's neighbors are usually in its own block, instead of a whole row away
+		// the grid is padded out to whole blocks
+		template<size_t BlockSize = 8>
+		struct blocked {
+			static_assert(std::has_single_bit(BlockSize), "block size must be a power of two");
+
+			static constexpr bool is_linear = false;
+
+			static constexpr size_t padded(size_t count) noexcept {
+				return (count + BlockSize - 1) & ~(BlockSize - 1);
+			}
+			static constexpr size_t storage_size(size_t columns, size_t rows) noexcept {
+				return padded(columns) * padded(rows);
+			}
+			static constexpr size_t offset(size_t column, size_t row, size_t columns) noexcept {
+				size_t block = (row / BlockSize) * (padded(columns) / BlockSize) + (column / BlockSize);
+				return block * BlockSize * BlockSize
+					+ (row & (BlockSize - 1)) * BlockSize
+					+ (column & (BlockSize - 1));
+			}
+		};
+
+	}
+
+	template<typename T, typename Layout = grid_layout::row_major>
 	class grid_vector;
 
-	template<typename T>
+	template<typename T, typename Layout = grid_layout::row_major>
 	class grid_view;
 
-	template<typename T>
+	template<typename T, typename Layout = grid_layout::row_major>
 	struct grid_const_iterator;
 
-	template<typename T>
-	struct grid_iterator
+	template<typename T, typename Layout = grid_layout::row_major>
+	struct grid_iterator : private detail::grid_origin<T*, Layout::is_linear>
 	{
 		using value_type = T;
 
@@ -54,6 +128,7 @@ namespace ff {
                 m_curr_row = other.m_curr_row;
                 m_columns = other.m_columns;
                 m_row_stride = other.m_row_stride;
+                origin() = other.origin();
             }
 			return *this;
 		}
@@ -65,10 +140,12 @@ namespace ff {
 			{
 				m_curr_column = 0;
 				m_curr_row++;
-				m_ptr += m_row_stride + 1;
+				if constexpr (Layout::is_linear)
+					m_ptr += m_row_stride + 1;
 			}
 			else {
-				m_ptr++;
+				if constexpr (Layout::is_linear)
+					m_ptr++;
 				m_curr_column++;
 			}
 			return *this;
@@ -85,11 +162,13 @@ namespace ff {
 			if (m_curr_column == 0)
 			{
 				m_curr_column = m_columns - 1;
-				m_ptr -= m_row_stride + 1;
+				if constexpr (Layout::is_linear)
+					m_ptr -= m_row_stride + 1;
 				m_curr_row--;
 			}
 			else {
-				m_ptr--;
+				if constexpr (Layout::is_linear)
+					m_ptr--;
 				m_curr_column--;
 			}
 			return *this;
@@ -99,17 +178,17 @@ namespace ff {
 			auto temp = *this;
 			return temp;
 		}
-		constexpr value_type* operator->() { return m_ptr; }
-		constexpr const value_type* operator->() const { return m_ptr; }
+		constexpr value_type* operator->() { return get(); }
+		constexpr const value_type* operator->() const { return get(); }
 
-		constexpr value_type& operator* () { return *m_ptr; }
-		constexpr const value_type& operator* () const { return *m_ptr; }
+		constexpr value_type& operator* () { return *get(); }
+		constexpr const value_type& operator* () const { return *get(); }
 
-		constexpr bool operator==(const grid_iterator& other) const noexcept { return m_ptr == other.m_ptr; };
-		constexpr bool operator!=(const grid_iterator& other) const noexcept { return m_ptr != other.m_ptr; };
+		constexpr bool operator==(const grid_iterator& other) const noexcept { return same_cell(other); };
+		constexpr bool operator!=(const grid_iterator& other) const noexcept { return !same_cell(other); };
 
-		constexpr bool operator==(const grid_const_iterator<T>& other) const noexcept { return m_ptr == other.m_ptr; };
-		constexpr bool operator!=(const grid_const_iterator<T>& other) const noexcept { return m_ptr != other.m_ptr; };
+		constexpr bool operator==(const grid_const_iterator<T, Layout>& other) const noexcept { return same_cell(other); };
+		constexpr bool operator!=(const grid_const_iterator<T, Layout>& other) const noexcept { return !same_cell(other); };
 
 		constexpr size_type column() const { return m_curr_column; };
 		constexpr size_type row() const { return m_curr_row; };
@@ -125,8 +204,41 @@ namespace ff {
 		{
 		}
 
-		friend class grid_view<T>;
-		friend class grid_vector<T>;
+		// cells found through Layout, relative to (left, top) of a grid src_columns wide
+		constexpr grid_iterator(value_type* base, size_type left, size_type top, size_type src_columns, size_type column, size_type row, size_type column_count) noexcept
+			: origin_type(base, left, top, src_columns)
+			, m_curr_column(column)
+			, m_curr_row(row)
+			, m_columns(column_count)
+		{
+		}
+
+		constexpr value_type* get() const {
+			if constexpr (Layout::is_linear) {
+				return m_ptr;
+			}
+			else {
+				return this->m_base + Layout::offset(this->m_left + m_curr_column, this->m_top + m_curr_row, this->m_src_columns);
+			}
+		}
+
+		template<typename It>
+		constexpr bool same_cell(const It& other) const noexcept {
+			if constexpr (Layout::is_linear) {
+				return m_ptr == other.m_ptr;
+			}
+			else {
+				return m_curr_column == other.m_curr_column && m_curr_row == other.m_curr_row;
+			}
+		}
+
+		using origin_type = detail::grid_origin<T*, Layout::is_linear>;
+		constexpr origin_type& origin() noexcept { return *this; }
+		constexpr const origin_type& origin() const noexcept { return *this; }
+
+		friend class grid_view<T, Layout>;
+		friend class grid_vector<T, Layout>;
+		friend struct grid_const_iterator<T, Layout>;
 
 		value_type* m_ptr = nullptr;
 
@@ -137,8 +249,8 @@ namespace ff {
 		size_type m_row_stride = 0;
 	};
 
-	template<typename T>
-	struct grid_const_iterator
+	template<typename T, typename Layout>
+	struct grid_const_iterator : private detail::grid_origin<const T*, Layout::is_linear>
 	{
 		using value_type = T;
 
@@ -163,6 +275,7 @@ namespace ff {
 			m_curr_row = other.m_curr_row;
 			m_columns = other.m_columns;
 			m_row_stride = other.m_row_stride;
+			origin() = other.origin();
 			return *this;
 		}
 
@@ -172,10 +285,12 @@ namespace ff {
 			{
 				m_curr_column = 0;
 				m_curr_row++;
-				m_ptr += m_row_stride + 1;
+				if constexpr (Layout::is_linear)
+					m_ptr += m_row_stride + 1;
 			}
 			else {
-				m_ptr++;
+				if constexpr (Layout::is_linear)
+					m_ptr++;
 				m_curr_column++;
 			}
 			return *this;
@@ -192,11 +307,13 @@ namespace ff {
 			if (m_curr_column == 0)
 			{
 				m_curr_column = m_columns - 1;
-				m_ptr -= m_row_stride + 1;
+				if constexpr (Layout::is_linear)
+					m_ptr -= m_row_stride + 1;
 				m_curr_row--;
 			}
 			else {
-				m_ptr--;
+				if constexpr (Layout::is_linear)
+					m_ptr--;
 				m_curr_column--;
 			}
 			return *this;
@@ -207,15 +324,15 @@ namespace ff {
 			return temp;
 		}
 
-		constexpr const value_type* operator->() const { return m_ptr; }
+		constexpr const value_type* operator->() const { return get(); }
 
-		constexpr const value_type& operator* () const { return *m_ptr; }
+		constexpr const value_type& operator* () const { return *get(); }
 
-		constexpr bool operator==(const grid_iterator<T>& other) const noexcept { return m_ptr == other.m_ptr; };
-		constexpr bool operator!=(const grid_iterator<T>& other) const noexcept { return m_ptr != other.m_ptr; };
+		constexpr bool operator==(const grid_iterator<T, Layout>& other) const noexcept { return same_cell(other); };
+		constexpr bool operator!=(const grid_iterator<T, Layout>& other) const noexcept { return !same_cell(other); };
 
-		constexpr bool operator==(const grid_const_iterator& other) const noexcept { return m_ptr == other.m_ptr; };
-		constexpr bool operator!=(const grid_const_iterator& other) const noexcept { return m_ptr != other.m_ptr; };
+		constexpr bool operator==(const grid_const_iterator& other) const noexcept { return same_cell(other); };
+		constexpr bool operator!=(const grid_const_iterator& other) const noexcept { return !same_cell(other); };
 
 		constexpr size_type column() const noexcept { return m_curr_column; };
 		constexpr size_type row() const noexcept { return m_curr_row; };
@@ -231,8 +348,41 @@ namespace ff {
 		{
 		}
 
-		friend class grid_view<T>;
-		friend class grid_vector<T>;
+		// cells found through Layout, relative to (left, top) of a grid src_columns wide
+		constexpr grid_const_iterator(const value_type* base, size_type left, size_type top, size_type src_columns, size_type column, size_type row, size_type column_count) noexcept
+			: origin_type(base, left, top, src_columns)
+			, m_curr_column(column)
+			, m_curr_row(row)
+			, m_columns(column_count)
+		{
+		}
+
+		constexpr const value_type* get() const {
+			if constexpr (Layout::is_linear) {
+				return m_ptr;
+			}
+			else {
+				return this->m_base + Layout::offset(this->m_left + m_curr_column, this->m_top + m_curr_row, this->m_src_columns);
+			}
+		}
+
+		template<typename It>
+		constexpr bool same_cell(const It& other) const noexcept {
+			if constexpr (Layout::is_linear) {
+				return m_ptr == other.m_ptr;
+			}
+			else {
+				return m_curr_column == other.m_curr_column && m_curr_row == other.m_curr_row;
+			}
+		}
+
+		using origin_type = detail::grid_origin<const T*, Layout::is_linear>;
+		constexpr origin_type& origin() noexcept { return *this; }
+		constexpr const origin_type& origin() const noexcept { return *this; }
+
+		friend class grid_view<T, Layout>;
+		friend class grid_vector<T, Layout>;
+		friend struct grid_iterator<T, Layout>;
 
 		const value_type* m_ptr = nullptr;
 
@@ -244,8 +394,8 @@ namespace ff {
 	};
 
 
-	template <class T>
-	class grid_view
+	template <class T, class Layout>
+	class grid_view : private detail::grid_origin<const T*, Layout::is_linear>
 	{
 	public:
 		using value_type = T;
@@ -258,8 +408,8 @@ namespace ff {
 		using size_type = size_t;
 		using difference_type = ptrdiff_t;
 
-		using iterator = grid_iterator<value_type>;
-		using const_iterator = grid_const_iterator<value_type>;
+		using iterator = grid_iterator<value_type, Layout>;
+		using const_iterator = grid_const_iterator<value_type, Layout>;
 		using reverse_iterator = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
@@ -267,18 +417,13 @@ namespace ff {
 		constexpr grid_view() noexcept
 		{
 		}
-		constexpr grid_view(const grid_view<T>& x) noexcept
-			: m_ptr(x.m_ptr)
-			, m_stride(x.m_stride)
-			, m_columns(x.m_columns)
-			, m_rows(x.m_rows)
-		{
-		}
-		constexpr grid_view(const grid_vector<T>& src) noexcept;
+		constexpr grid_view(const grid_view& x) noexcept = default;
+		constexpr grid_view(const grid_vector<T, Layout>& src) noexcept;
 
-		constexpr grid_view(const grid_view<T>& src, size_type left, size_type top, size_type columns, size_type rows)
-			: m_ptr(&src.at(left, top))
-			, m_stride((src->column_count() + src.m_stride) - columns)
+		constexpr grid_view(const grid_view& src, size_type left, size_type top, size_type columns, size_type rows)
+			: origin_type(src.origin().offset_by(left, top))
+			, m_ptr(&src.at(left, top))
+			, m_stride((src.column_count() + src.m_stride) - columns)
 			, m_columns(columns)
 			, m_rows(rows)
 		{
@@ -290,39 +435,38 @@ namespace ff {
 		}
 
 		template<detail::vector_type Vec>
-		constexpr grid_view(const grid_view<T>& src, const Vec& left_top, const Vec& columns_rows)
+		constexpr grid_view(const grid_view& src, const Vec& left_top, const Vec& columns_rows)
 			: grid_view(src, left_top.x, left_top.y, columns_rows.x, columns_rows.y)
 		{
 		}
 
-		constexpr grid_view(const grid_vector<T>& src, size_type left, size_type top, size_type columns, size_type rows);
+		constexpr grid_view(const grid_vector<T, Layout>& src, size_type left, size_type top, size_type columns, size_type rows);
 
 		template<detail::vector_type Vec>
-		constexpr grid_view(const grid_vector<T>& src, const Vec& left_top, const Vec& columns_rows)
+		constexpr grid_view(const grid_vector<T, Layout>& src, const Vec& left_top, const Vec& columns_rows)
 			: grid_view(src, left_top.x, left_top.y, columns_rows.x, columns_rows.y)
 		{
 		}
 
-		constexpr grid_view<T>& operator=(const grid_view<T>& x)
-		{
-			m_ptr = x.m_ptr;
-			m_stride = x.m_stride;
-			m_columns = x.m_columns;
-			m_rows = x.m_rows;
-			return *this;
-		}
+		constexpr grid_view& operator=(const grid_view& x) noexcept = default;
 
 		constexpr const_iterator begin() {
-			return const_iterator{ m_ptr, 0, 0, m_columns, m_stride };
+			return cbegin();
 		}
 		constexpr const_iterator end() {
-			return const_iterator{ m_ptr + size() + m_stride * m_rows, 0, m_rows, m_columns, m_stride };
+			return cend();
 		}
 		constexpr const_iterator cbegin() const {
-			return const_iterator{ m_ptr, 0, 0, m_columns, m_stride };
+			if constexpr (Layout::is_linear)
+				return const_iterator{ m_ptr, 0, 0, m_columns, m_stride };
+			else
+				return const_iterator{ this->m_base, this->m_left, this->m_top, this->m_src_columns, 0, 0, m_columns };
 		}
 		constexpr const_iterator cend() const {
-			return const_iterator{ m_ptr + size() + m_stride * m_rows, 0, m_rows, m_columns, m_stride };
+			if constexpr (Layout::is_linear)
+				return const_iterator{ m_ptr + size() + m_stride * m_rows, 0, m_rows, m_columns, m_stride };
+			else
+				return const_iterator{ this->m_base, this->m_left, this->m_top, this->m_src_columns, 0, m_rows, m_columns };
 		}
 		constexpr reverse_iterator rbegin() {
 			return reverse_iterator{ m_ptr, 0, 0, m_columns, m_stride };
@@ -339,7 +483,10 @@ namespace ff {
 
 		constexpr const_reference at(size_type column_x, size_type row_y) const
 		{
-			return m_ptr[(row_y * (m_columns + m_stride)) + column_x];
+			if constexpr (Layout::is_linear)
+				return m_ptr[(row_y * (m_columns + m_stride)) + column_x];
+			else
+				return this->m_base[Layout::offset(this->m_left + column_x, this->m_top + row_y, this->m_src_columns)];
 		}
 
 		template<detail::vector_type Vec>
@@ -361,20 +508,20 @@ namespace ff {
 			return at(position);
 		}
 
-		constexpr grid_view<T> take_view() const
+		constexpr grid_view take_view() const
 		{
-			return grid_view<T>(*this);
+			return grid_view(*this);
 		}
 
-		constexpr grid_view<T> take_view(size_type left, size_type top, size_type columns, size_type rows) const
+		constexpr grid_view take_view(size_type left, size_type top, size_type columns, size_type rows) const
 		{
-			return grid_view<T>(*this, left, top, columns, rows);
+			return grid_view(*this, left, top, columns, rows);
 		}
 
 		template<detail::vector_type Vec>
-		constexpr grid_view<T> take_view(const Vec& left_top, const Vec& columns_rows) const
+		constexpr grid_view take_view(const Vec& left_top, const Vec& columns_rows) const
 		{
-			return grid_view<T>(*this, left_top.x, left_top.y, columns_rows.x, columns_rows.y);
+			return grid_view(*this, left_top.x, left_top.y, columns_rows.x, columns_rows.y);
 		}
 
 		constexpr bool empty() const noexcept { return !m_ptr; }
@@ -404,6 +551,9 @@ namespace ff {
 		}
 
 	private:
+		using origin_type = detail::grid_origin<const T*, Layout::is_linear>;
+		constexpr const origin_type& origin() const noexcept { return *this; }
+
 		const value_type* m_ptr = nullptr;
 
 		size_type m_stride = 0;
@@ -412,12 +562,13 @@ namespace ff {
 	};
 
 
-	template <class T>
+	template <class T, class Layout>
 	class grid_vector
 	{
 	public:
 		// traits
 		using value_type = T;
+		using layout_type = Layout;
 
 		using reference = T&;
 		using const_reference = const T&;
@@ -427,8 +578,8 @@ namespace ff {
 		using size_type = size_t;
 		using difference_type = ptrdiff_t;
 
-		using iterator = grid_iterator<value_type>;
-		using const_iterator = grid_const_iterator<value_type>;
+		using iterator = grid_iterator<value_type, Layout>;
+		using const_iterator = grid_const_iterator<value_type, Layout>;
 		using reverse_iterator = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
@@ -443,7 +594,7 @@ namespace ff {
 			, m_rows(rows)
 		{
 			if (size() > 0) {
-				m_ptr = new T[m_rows * m_columns]();
+				m_ptr = new T[storage_size()]();
 			}
 			else {
 				clear();
@@ -461,7 +612,7 @@ namespace ff {
 			, m_rows(rows)
 		{
 			if (size() > 0) {
-				m_ptr = new T[m_rows * m_columns](value);
+				m_ptr = new T[storage_size()](value);
 				// std::fill_n(m_ptr, size(), value);
 			}
 			else {
@@ -478,8 +629,8 @@ namespace ff {
 			: m_columns(x.m_columns)
 			, m_rows(x.m_rows)
 		{
-			m_ptr = new T[m_rows * m_columns];
-			std::copy_n(x.m_ptr, size(), m_ptr);
+			m_ptr = new T[storage_size()];
+			std::copy_n(x.m_ptr, storage_size(), m_ptr);
 		};
 
 		constexpr grid_vector(grid_vector&& x) noexcept
@@ -487,11 +638,11 @@ namespace ff {
 			swap(x);
 		};
 
-		constexpr grid_vector(grid_view<T> x)
+		constexpr grid_vector(grid_view<T, Layout> x)
 			: m_columns(x.column_count())
 			, m_rows(x.row_count())
 		{
-			m_ptr = new T[m_rows * m_columns];
+			m_ptr = new T[storage_size()]();
 			std::copy(x.begin(), x.end(), begin());
 		};
 
@@ -512,8 +663,8 @@ namespace ff {
 			clear();
 			m_rows = x.m_rows;
 			m_columns = x.m_columns;
-			m_ptr = new T[size()];
-			std::copy_n(x.data(), size(), m_ptr);
+			m_ptr = new T[storage_size()];
+			std::copy_n(x.data(), storage_size(), m_ptr);
 			return *this;
 		}
 
@@ -523,12 +674,12 @@ namespace ff {
 			return *this;
 		}
 
-		constexpr grid_vector& operator=(grid_view<T> x)
+		constexpr grid_vector& operator=(grid_view<T, Layout> x)
 		{
 			clear();
-			m_rows = x.row_size();
-			m_columns = x.column_size();
-			m_ptr = new T[size()];
+			m_rows = x.row_count();
+			m_columns = x.column_count();
+			m_ptr = new T[storage_size()]();
 			std::copy(x.begin(), x.end(), begin());
 			return *this;
 		}
@@ -540,40 +691,60 @@ namespace ff {
 			return *this;
 		}
 
-		constexpr iterator begin() { return iterator{ m_ptr, 0, 0, m_columns }; }
-		constexpr iterator end() { return iterator{ m_ptr + size(), 0, m_rows, m_columns }; }
+		constexpr iterator begin() {
+			if constexpr (Layout::is_linear)
+				return iterator{ m_ptr, 0, 0, m_columns };
+			else
+				return iterator{ m_ptr, 0, 0, m_columns, 0, 0, m_columns };
+		}
+		constexpr iterator end() {
+			if constexpr (Layout::is_linear)
+				return iterator{ m_ptr + size(), 0, m_rows, m_columns };
+			else
+				return iterator{ m_ptr, 0, 0, m_columns, 0, m_rows, m_columns };
+		}
 		constexpr const_iterator begin() const { return cbegin(); }
 		constexpr const_iterator end() const { return cend(); }
-		constexpr const_iterator cbegin() const { return const_iterator{ m_ptr, 0, 0, m_columns }; }
-		constexpr const_iterator cend() const { return const_iterator{ m_ptr + size(), 0, m_rows, m_columns }; }
+		constexpr const_iterator cbegin() const {
+			if constexpr (Layout::is_linear)
+				return const_iterator{ m_ptr, 0, 0, m_columns };
+			else
+				return const_iterator{ m_ptr, 0, 0, m_columns, 0, 0, m_columns };
+		}
+		constexpr const_iterator cend() const {
+			if constexpr (Layout::is_linear)
+				return const_iterator{ m_ptr + size(), 0, m_rows, m_columns };
+			else
+				return const_iterator{ m_ptr, 0, 0, m_columns, 0, m_rows, m_columns };
+		}
 		constexpr reverse_iterator rbegin() { return reverse_iterator{ m_ptr, 0, 0, m_columns }; }
 		constexpr reverse_iterator rend() { return reverse_iterator{ m_ptr + size(), 0, m_rows, m_columns }; }
 		constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator{ m_ptr, 0, 0, m_columns }; }
 		constexpr const_reverse_iterator crend() const { return const_reverse_iterator{ m_ptr + size(), 0, m_rows, m_columns }; }
 
-		constexpr grid_view<T> take_view() const
+		constexpr grid_view<T, Layout> take_view() const
 		{
-			return grid_view<T>(*this);
+			return grid_view<T, Layout>(*this);
 		}
 
-		constexpr grid_view<T> take_view(size_type left, size_type top, size_type columns, size_type rows) const
+		constexpr grid_view<T, Layout> take_view(size_type left, size_type top, size_type columns, size_type rows) const
 		{
-			return grid_view<T>(*this, left, top, columns, rows);
+			return grid_view<T, Layout>(*this, left, top, columns, rows);
 		}
 
 		template<detail::vector_type Vec>
-		constexpr grid_view<T> take_view(const Vec& left_top, const Vec& columns_rows) const
+		constexpr grid_view<T, Layout> take_view(const Vec& left_top, const Vec& columns_rows) const
 		{
-			return grid_view<T>(*this, left_top.x, left_top.y, columns_rows.x, columns_rows.y);
+			return grid_view<T, Layout>(*this, left_top.x, left_top.y, columns_rows.x, columns_rows.y);
 		}
 
 		constexpr reference at(size_type column_x, size_type row_y)
 		{
-			return m_ptr[(row_y * m_columns) + column_x];
+			return m_ptr[Layout::offset(column_x, row_y, m_columns)];
 		}
 		constexpr const_reference at(size_type column_x, size_type row_y) const
 		{
-			return m_ptr[(row_y * m_columns) + column_x];
+			return m_ptr[Layout::offset(column_x, row_y, m_columns)];
 		}
 
 		template<detail::vector_type Vec>
@@ -588,14 +759,21 @@ namespace ff {
 			return at(position.x, position.y);
 		}
 
+		// ndx in row order, whatever the layout
 		constexpr reference operator[] (size_type ndx)
 		{
-			return m_ptr[ndx];
+			if constexpr (Layout::is_linear)
+				return m_ptr[ndx];
+			else
+				return at(ndx % m_columns, ndx / m_columns);
 		}
 
 		constexpr const_reference operator[] (size_type ndx) const
 		{
-			return m_ptr[ndx];
+			if constexpr (Layout::is_linear)
+				return m_ptr[ndx];
+			else
+				return at(ndx % m_columns, ndx / m_columns);
 		}
 
 		template<detail::vector_type Vec>
@@ -613,6 +791,10 @@ namespace ff {
 		constexpr bool empty() const noexcept { return !m_ptr; }
 		constexpr size_type size() const noexcept { return m_rows * m_columns; };
 
+		// cells allocated, including any padding the layout needs
+		constexpr size_type storage_size() const noexcept { return Layout::storage_size(m_columns, m_rows); };
+
+		// cells in Layout order
 		constexpr value_type* data() noexcept { return m_ptr; }
 		constexpr const value_type* data() const noexcept { return m_ptr; }
 
@@ -662,13 +844,22 @@ namespace ff {
 				if (!m_ptr)
 				{
 					m_columns = row_il.size();
-					m_ptr = new T[m_rows * m_columns];
+					m_ptr = new T[storage_size()]();
 				}
 				else if (row_il.size() != m_columns)
 				{
 					throw std::invalid_argument("row length mismatch");
 				}
-				std::copy(row_il.begin(), row_il.end(), m_ptr + (row * m_columns));
+
+				if constexpr (Layout::is_linear) {
+					std::copy(row_il.begin(), row_il.end(), m_ptr + (row * m_columns));
+				}
+				else {
+					size_type column = 0;
+					for (auto& value : row_il) {
+						at(column++, row) = value;
+					}
+				}
 				row++;
 			}
 		}
@@ -678,18 +869,20 @@ namespace ff {
 		value_type* m_ptr = nullptr;
 	};
 
-	template<typename T>
-	constexpr grid_view<T>::grid_view(const grid_vector<T>& src) noexcept
-		: m_ptr(src.data())
+	template<typename T, typename Layout>
+	constexpr grid_view<T, Layout>::grid_view(const grid_vector<T, Layout>& src) noexcept
+		: origin_type(src.data(), 0, 0, src.column_count())
+		, m_ptr(src.data())
 		, m_stride(0)
 		, m_columns(src.column_count())
 		, m_rows(src.row_count())
 	{
 	}
 
-	template<typename T>
-	constexpr grid_view<T>::grid_view(const grid_vector<T>& src, size_type left, size_type top, size_type columns, size_type rows)
-		: m_ptr(&src.at(left, top))
+	template<typename T, typename Layout>
+	constexpr grid_view<T, Layout>::grid_view(const grid_vector<T, Layout>& src, size_type left, size_type top, size_type columns, size_type rows)
+		: origin_type(src.data(), left, top, src.column_count())
+		, m_ptr(&src.at(left, top))
 		, m_stride(src.column_count() - columns)
 		, m_columns(columns)
 		, m_rows(rows)
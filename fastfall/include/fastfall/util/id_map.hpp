@@ -1,7 +1,7 @@
 #pragma once
 
 #include "fastfall/util/slot_map.hpp"
-#include "fastfall/util/copyable_uniq_ptr.hpp"
+#include "fastfall/util/poly_pool.hpp"
 #include "fastfall/util/id.hpp"
 
 #include <span>
@@ -128,6 +128,8 @@ public:
 
     size_t size() const { return components.size(); }
 
+    void reserve(size_t count) { components.reserve(count); }
+
 	inline auto begin() { return iterator{ components.data() }; }
 	inline auto begin() const { return const_iterator{ components.data() }; }
 	inline auto cbegin() const { return const_iterator{ components.data() }; }
@@ -147,12 +149,13 @@ public:
     ID<T> peek_next_id() const { return { components.peek_next_key() }; }
 };
 
+// components of types derived from T, each concrete type pooled separately
 template<class T>
 class poly_id_map
 {
 public:
     using base_type = T;
-    using value_type = copyable_unique_ptr<T>;
+    using value_type = pool_ptr<T>;
     using span = std::span<value_type>;
     constexpr static bool is_poly = true;
 
@@ -161,30 +164,86 @@ public:
 
 private:
 	slot_map<value_type> components;
+    std::vector<std::unique_ptr<poly_pool_base<T>>> pools;
+
+    template<std::derived_from<T> Type, class... Args>
+    value_type construct(Args&&... args) {
+        uint32_t type = pool_type_index<T, Type>();
+        if (pools.size() <= type) {
+            pools.resize(type + 1);
+        }
+        if (!pools[type]) {
+            pools[type] = std::make_unique<poly_pool<T, Type>>();
+        }
+        return static_cast<poly_pool<T, Type>&>(*pools[type]).create(std::forward<Args>(args)...);
+    }
+
+    void destroy(value_type& val) {
+        if (val) {
+            pools[val.type]->destroy(val.slot);
+            val = {};
+        }
+    }
 
 public:
     using iterator = id_iterator<value_type, base_type>;
     using const_iterator = id_iterator<const value_type, base_type>;
 
+    poly_id_map() = default;
+
+    // copies each pool whole, then points the handles at the copies
+    poly_id_map(const poly_id_map& other)
+        : components{ other.components }
+    {
+        pools.reserve(other.pools.size());
+        for (auto& pool : other.pools) {
+            pools.push_back(pool ? pool->clone() : nullptr);
+        }
+        for (auto& [key, val] : components) {
+            if (val) {
+                val.ptr = pools[val.type]->address(val.slot);
+            }
+        }
+    }
+
+    poly_id_map(poly_id_map&&) noexcept = default;
+
+    poly_id_map& operator=(const poly_id_map& other) {
+        if (this != &other) {
+            *this = poly_id_map{ other };
+        }
+        return *this;
+    }
+
+    poly_id_map& operator=(poly_id_map&& other) noexcept {
+        if (this != &other) {
+            // the handles must go before the objects they refer to
+            components = std::move(other.components);
+            pools = std::move(other.pools);
+        }
+        return *this;
+    }
+
 	// polymorphic
 	template<std::derived_from<T> Type, class... Args>
 	ID<Type> create(Args&&... args) {
-		auto id = components.emplace_back(make_copyable_unique<T, Type>(std::forward<Args>(args)...));
+		auto id = components.emplace_back(construct<Type>(std::forward<Args>(args)...));
 		return { id };
 	}
 
-    ID<T> emplace(value_type&& val) {
-        auto id = components.emplace_back(std::move(val));
+    // reserves an id, the component is set later with emplace_at
+    ID<T> create_empty() {
+        auto id = components.emplace_back(value_type{});
         return { id };
     }
 
     template<std::derived_from<T> Type, class... Args>
     void emplace_at(ID<T> id, Args&&... args) {
-        components.at(id.value) = make_copyable_unique<T, Type>(std::forward<Args>(args)...);
-    }
-
-    void emplace_at(ID<T> id, value_type&& val) {
-        components.at(id.value) = std::move(val);
+        // the constructor may create other components, look up the slot after
+        auto created = construct<Type>(std::forward<Args>(args)...);
+        auto& val = components.at(id.value);
+        destroy(val);
+        val = created;
     }
 
 	template<std::derived_from<T> Type>
@@ -211,6 +270,7 @@ public:
 	bool erase(ID<Type> id) {
 		bool removed = exists(id);
 		if (removed) {
+            destroy(components.at(id.value));
 			components.erase(id.value);
 		}
 		return removed;
@@ -224,6 +284,9 @@ public:
 
     size_t size() const { return components.size(); }
 
+    // reserves handles only, objects are allocated by their pools a chunk at a time
+    void reserve(size_t count) { components.reserve(count); }
+
     inline auto begin() { return iterator{ components.data() }; }
     inline auto begin() const { return const_iterator{ components.data() }; }
     inline auto cbegin() const { return const_iterator{ components.data() }; }
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace ff {
+
+// vector with room for N elements inline, moves to the heap only once it grows past that
+// the heap buffer keeps its capacity through clear(), so a reused inline_vector stops allocating
+template<class T, size_t N>
+class inline_vector {
+    static_assert(N > 0);
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    using value_type     = T;
+    using iterator       = T*;
+    using const_iterator = const T*;
+
+    inline_vector() = default;
+
+    // accessors
+    T* data() { return on_heap ? heap.data() : local.data(); }
+    const T* data() const { return on_heap ? heap.data() : local.data(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    T& operator[](size_t ndx) { return data()[ndx]; }
+    const T& operator[](size_t ndx) const { return data()[ndx]; }
+
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+    T& back() { return data()[size() - 1]; }
+    const T& back() const { return data()[size() - 1]; }
+
+    // capacity
+    bool empty() const { return size() == 0; }
+    size_t size() const { return on_heap ? heap.size() : count; }
+    bool is_inline() const { return !on_heap; }
+
+    static constexpr size_t inline_capacity() { return N; }
+
+    // modifiers
+    void push_back(const T& value) {
+        if (!on_heap && count == N) {
+            heap.assign(local.begin(), local.end());
+            on_heap = true;
+        }
+        if (on_heap) {
+            heap.push_back(value);
+        }
+        else {
+            local[count++] = value;
+        }
+    }
+
+    template<class It>
+    iterator insert(const_iterator pos, It first, It last) {
+        size_t ndx = pos - begin();
+        size_t old_size = size();
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+        std::rotate(begin() + ndx, begin() + old_size, end());
+        return begin() + ndx;
+    }
+
+    iterator erase(const_iterator pos) {
+        size_t ndx = pos - begin();
+        if (on_heap) {
+            heap.erase(heap.begin() + ndx);
+        }
+        else {
+            std::copy(local.begin() + ndx + 1, local.begin() + count, local.begin() + ndx);
+            count--;
+        }
+        return begin() + ndx;
+    }
+
+    void pop_back() {
+        if (on_heap) {
+            heap.pop_back();
+        }
+        else {
+            count--;
+        }
+    }
+
+    void clear() {
+        count = 0;
+        heap.clear();
+        on_heap = false;
+    }
+
+private:
+    std::array<T, N> local;
+    size_t count = 0;
+
+    std::vector<T> heap;
+    bool on_heap = false;
+};
+
+}
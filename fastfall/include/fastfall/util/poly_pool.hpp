@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace ff {
+
+// handle to an object living in a poly_pool, behaves like a pointer to Base
+// the pool that made it owns the object
+template<class Base>
+struct pool_ptr {
+    Base*    ptr  = nullptr;
+    uint32_t type = 0;
+    uint32_t slot = 0;
+
+    Base* operator->() { return ptr; }
+    const Base* operator->() const { return ptr; }
+
+    Base& operator*() { return *ptr; }
+    const Base& operator*() const { return *ptr; }
+
+    Base* get() { return ptr; }
+    const Base* get() const { return ptr; }
+
+    explicit operator bool() const { return ptr != nullptr; }
+};
+
+namespace detail {
+
+    template<class Base>
+    uint32_t next_pool_type() {
+        static std::atomic<uint32_t> counter = 0;
+        return counter++;
+    }
+
+}
+
+// index of a concrete type among the types pooled for Base
+template<class Base, class Type>
+uint32_t pool_type_index() {
+    static const uint32_t index = detail::next_pool_type<Base>();
+    return index;
+}
+
+template<class Base>
+class poly_pool_base {
+public:
+    virtual ~poly_pool_base() = default;
+
+    virtual void destroy(uint32_t slot) = 0;
+    virtual Base* address(uint32_t slot) = 0;
+
+    // copy with every object at the same slot
+    virtual std::unique_ptr<poly_pool_base> clone() const = 0;
+
+    virtual size_t size() const = 0;
+};
+
+// objects of one concrete type, stored in fixed size chunks so they're close together in memory
+// and never move while alive
+template<class Base, class Type>
+class poly_pool : public poly_pool_base<Base> {
+public:
+    static constexpr size_t ChunkSize = std::max<size_t>(8, 16384 / sizeof(Type));
+
+    poly_pool() = default;
+    poly_pool(const poly_pool&) = delete;
+    poly_pool& operator=(const poly_pool&) = delete;
+
+    ~poly_pool() override {
+        for (uint32_t slot = 0; slot < chunks.size() * ChunkSize; slot++) {
+            if (is_live(slot)) {
+                object(slot)->~Type();
+            }
+        }
+    }
+
+    template<class... Args>
+    pool_ptr<Base> create(Args&&... args) {
+        uint32_t slot = acquire();
+        Type* obj = new (object(slot)) Type{ std::forward<Args>(args)... };
+        set_live(slot, true);
+        return { static_cast<Base*>(obj), pool_type_index<Base, Type>(), slot };
+    }
+
+    void destroy(uint32_t slot) override {
+        object(slot)->~Type();
+        set_live(slot, false);
+        free_slots.push_back(slot);
+    }
+
+    Base* address(uint32_t slot) override {
+        return static_cast<Base*>(object(slot));
+    }
+
+    std::unique_ptr<poly_pool_base<Base>> clone() const override {
+        auto copy = std::make_unique<poly_pool>();
+        copy->chunks.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); i++) {
+            copy->chunks.push_back(std::make_unique<Chunk>());
+        }
+        for (uint32_t slot = 0; slot < chunks.size() * ChunkSize; slot++) {
+            if (is_live(slot)) {
+                new (copy->object(slot)) Type(*object(slot));
+                copy->set_live(slot, true);
+            }
+        }
+        copy->free_slots = free_slots;
+        copy->used = used;
+        return copy;
+    }
+
+    size_t size() const override {
+        return used - free_slots.size();
+    }
+
+private:
+    struct Chunk {
+        alignas(Type) std::byte storage[sizeof(Type) * ChunkSize];
+        std::bitset<ChunkSize> live;
+    };
+
+    uint32_t acquire() {
+        if (!free_slots.empty()) {
+            uint32_t slot = free_slots.back();
+            free_slots.pop_back();
+            return slot;
+        }
+        if (used == chunks.size() * ChunkSize) {
+            chunks.push_back(std::make_unique<Chunk>());
+        }
+        return used++;
+    }
+
+    Type* object(uint32_t slot) const {
+        auto& chunk = *chunks[slot / ChunkSize];
+        return std::launder(reinterpret_cast<Type*>(const_cast<std::byte*>(chunk.storage) + sizeof(Type) * (slot % ChunkSize)));
+    }
+
+    bool is_live(uint32_t slot) const { return chunks[slot / ChunkSize]->live.test(slot % ChunkSize); }
+    void set_live(uint32_t slot, bool live) { chunks[slot / ChunkSize]->live.set(slot % ChunkSize, live); }
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<uint32_t> free_slots;
+    uint32_t used = 0;
+};
+
+}
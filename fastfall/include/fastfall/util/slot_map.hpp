@@ -111,6 +111,11 @@ namespace ff {
 			return dense_.size();
 		}
 
+		void reserve(size_t count) {
+			dense_.reserve(count);
+			sparse_.reserve((size_t)(count / sparse_density) + sparse_max);
+		}
+
         std::pair<slot_key, T>* data() {
             return dense_.data();
         }
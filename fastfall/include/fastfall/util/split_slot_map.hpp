@@ -0,0 +1,161 @@
+#pragma once
+
+#include "fastfall/util/slot_map.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace ff {
+
+// slot_map variant storing keys and values in separate parallel arrays
+// each of Ts is its own column, so a value can be declared as a hot part iterated every tick
+// and a cold part that's rarely touched, e.g. split_slot_map<BodyHot, BodyCold>
+// iterating one column only touches that column's memory
+template<class... Ts>
+class split_slot_map
+{
+    static_assert(sizeof...(Ts) > 0);
+
+public:
+    template<class C>
+    static constexpr size_t column_index() {
+        constexpr size_t matches = (std::is_same_v<C, Ts> + ...);
+        static_assert(matches == 1, "type must appear exactly once in the columns");
+
+        size_t index = 0;
+        ((std::is_same_v<C, Ts> ? false : (++index, true)) && ...);
+        return index;
+    }
+
+    split_slot_map() = default;
+
+    // accessors
+    template<class C>
+    C& get(slot_key key) {
+        return std::get<column_index<C>()>(columns)[dense_index(key)];
+    }
+
+    template<class C>
+    const C& get(slot_key key) const {
+        return std::get<column_index<C>()>(columns)[dense_index(key)];
+    }
+
+    template<size_t N>
+    auto& at(slot_key key) {
+        return std::get<N>(columns)[dense_index(key)];
+    }
+
+    template<size_t N>
+    const auto& at(slot_key key) const {
+        return std::get<N>(columns)[dense_index(key)];
+    }
+
+    bool exists(slot_key key) const {
+        return key.sparse_index < sparse.size()
+            && sparse[key.sparse_index].valid
+            && sparse[key.sparse_index].generation == key.generation;
+    }
+
+    // position of the key's values in each column, only valid until the next erase
+    uint32_t dense_index(slot_key key) const {
+        assert(exists(key));
+        return sparse[key.sparse_index].dense_index;
+    }
+
+    // bulk access, all spans have the same length and order
+    std::span<const slot_key> keys() const { return dense_keys; }
+
+    template<class C>
+    std::span<C> column() { return std::get<column_index<C>()>(columns); }
+
+    template<class C>
+    std::span<const C> column() const { return std::get<column_index<C>()>(columns); }
+
+    // calls fn(key, Ts&...) for every element in dense order
+    template<class Fn>
+    void for_each(Fn&& fn) {
+        for (size_t i = 0; i < dense_keys.size(); i++) {
+            std::apply([&](auto&... cols) { fn(dense_keys[i], cols[i]...); }, columns);
+        }
+    }
+
+    // capacity
+    bool empty() const { return dense_keys.empty(); }
+    size_t size() const { return dense_keys.size(); }
+
+    void reserve(size_t count) {
+        dense_keys.reserve(count);
+        std::apply([&](auto&... cols) { (cols.reserve(count), ...); }, columns);
+    }
+
+    // modifiers
+    slot_key emplace_back(Ts... values) {
+        uint32_t sparse_ndx;
+        if (!free_list.empty()) {
+            sparse_ndx = free_list.back();
+            free_list.pop_back();
+        }
+        else {
+            sparse_ndx = (uint32_t)sparse.size();
+            sparse.push_back({});
+        }
+
+        auto& sp = sparse[sparse_ndx];
+        sp.generation = sp.generation + 1 == 0 ? 1 : sp.generation + 1;
+        sp.dense_index = (uint32_t)dense_keys.size();
+        sp.valid = true;
+
+        slot_key key{ .generation = sp.generation, .sparse_index = sparse_ndx };
+        dense_keys.push_back(key);
+        std::apply([&](auto&... cols) { (cols.push_back(std::move(values)), ...); }, columns);
+        return key;
+    }
+
+    // moves the last element into the erased one's place
+    bool erase(slot_key key) {
+        if (!exists(key))
+            return false;
+
+        uint32_t d_ndx = sparse[key.sparse_index].dense_index;
+        uint32_t last = (uint32_t)dense_keys.size() - 1;
+        if (d_ndx != last) {
+            dense_keys[d_ndx] = dense_keys[last];
+            sparse[dense_keys[d_ndx].sparse_index].dense_index = d_ndx;
+            std::apply([&](auto&... cols) { ((cols[d_ndx] = std::move(cols[last])), ...); }, columns);
+        }
+        dense_keys.pop_back();
+        std::apply([&](auto&... cols) { (cols.pop_back(), ...); }, columns);
+
+        sparse[key.sparse_index].valid = false;
+        free_list.push_back(key.sparse_index);
+        return true;
+    }
+
+    void clear() {
+        for (auto key : dense_keys) {
+            sparse[key.sparse_index].valid = false;
+            free_list.push_back(key.sparse_index);
+        }
+        dense_keys.clear();
+        std::apply([&](auto&... cols) { (cols.clear(), ...); }, columns);
+    }
+
+private:
+    struct sparse_t {
+        uint32_t generation = 0;
+        uint32_t dense_index = 0;
+        bool valid = false;
+    };
+
+    std::vector<sparse_t> sparse;
+    std::vector<uint32_t> free_list;
+
+    std::vector<slot_key> dense_keys;
+    std::tuple<std::vector<Ts>...> columns;
+};
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace ff {
+
+// bounded single producer, single consumer fifo
+// push() and pop() never block or allocate, push() fails when full
+// a side may move between threads as long as the handoff itself is synchronized
+template<class T, size_t Capacity>
+class spsc_queue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    static constexpr size_t Mask = Capacity - 1;
+
+public:
+    spsc_queue() = default;
+
+    // no copy
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    // producer side
+    bool push(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cached_head == Capacity) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (t - cached_head == Capacity) {
+                return false;
+            }
+        }
+        buffer[t & Mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side
+    bool pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h == cached_tail) {
+                return false;
+            }
+        }
+        out = buffer[h & Mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // exact only when called from a side with the other idle
+    size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    // the indices only grow, wrapping is harmless as Capacity divides the range
+    alignas(64) std::atomic<size_t> head{ 0 };
+    size_t cached_tail = 0; // owned by consumer
+
+    alignas(64) std::atomic<size_t> tail{ 0 };
+    size_t cached_head = 0; // owned by producer
+
+    alignas(64) std::array<T, Capacity> buffer{};
+};
+
+}
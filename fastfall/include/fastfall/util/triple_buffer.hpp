@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ff {
+
+// single producer, single consumer handoff of the latest T
+// the producer writes into back(), then publish() swaps it with the middle slot
+// the consumer calls acquire() to swap the middle slot into front() if it was published since the last acquire
+// neither side ever blocks, the producer may publish faster than the consumer acquires (stale values are dropped)
+template<class T>
+class triple_buffer {
+private:
+    // middle slot index, with a flag set if it holds a value not yet acquired
+    static constexpr uint8_t FreshBit  = 0b100;
+    static constexpr uint8_t IndexMask = 0b011;
+
+public:
+    triple_buffer() = default;
+    explicit triple_buffer(const T& init) : buffers{ init, init, init } {}
+
+    // no copy
+    triple_buffer(const triple_buffer&) = delete;
+    triple_buffer& operator=(const triple_buffer&) = delete;
+
+    // producer side
+    T& back() { return buffers[back_ndx]; }
+    const T& back() const { return buffers[back_ndx]; }
+
+    void publish() {
+        uint8_t prev = middle.exchange(back_ndx | FreshBit, std::memory_order_acq_rel);
+        back_ndx = prev & IndexMask;
+    }
+
+    // consumer side
+    T& front() { return buffers[front_ndx]; }
+    const T& front() const { return buffers[front_ndx]; }
+
+    // returns true if front() now holds a newly published value
+    bool acquire() {
+        if ((middle.load(std::memory_order_relaxed) & FreshBit) == 0) {
+            return false;
+        }
+        uint8_t prev = middle.exchange(front_ndx, std::memory_order_acq_rel);
+        front_ndx = prev & IndexMask;
+        return true;
+    }
+
+    bool has_fresh() const {
+        return (middle.load(std::memory_order_acquire) & FreshBit) != 0;
+    }
+
+private:
+    std::array<T, 3> buffers{};
+
+    uint8_t front_ndx = 0; // owned by consumer
+    std::atomic<uint8_t> middle{ 1 };
+    uint8_t back_ndx  = 2; // owned by producer
+};
+
+}
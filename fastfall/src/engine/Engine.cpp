@@ -1,6 +1,7 @@
 
 #include <queue>
 #include <thread>
+#include <array>
 
 #include "fastfall/engine/imgui/ImGuiFrame.hpp"
 
@@ -15,6 +16,9 @@
 
 #include "fastfall/engine/input/InputConfig.hpp"
 #include "fastfall/engine/time/profiler.hpp"
+#include "fastfall/engine/telemetry.hpp"
+#include "fastfall/engine/audio.hpp"
+#include "fastfall/util/alloc.hpp"
 
 #include "fastfall/resource/ResourceWatcher.hpp"
 
@@ -113,13 +117,17 @@ void Engine::drawRunnable(EngineRunnable& run) {
 
     // draw margin
     if (!run.getRTexture()) {
-        View v = target->getView();
-        target->setView(marginView);
-        target->draw(*margins);
-        target->setView(v);
+        drawMargins(*target);
     }
 }
 
+void Engine::drawMargins(RenderTarget& target) {
+    View v = target.getView();
+    target.setView(marginView);
+    target.draw(*margins);
+    target.setView(v);
+}
+
 // -------------------------------------------
 
 void Engine::prerun_init()
@@ -209,6 +217,8 @@ bool Engine::run_singleThread()
 
         glDeleteStale();
 
+        audio::process_commands();
+
         display();
         profiler::curr_duration.display_time = profiler::frame_timer.elapsed();
 
@@ -218,6 +228,7 @@ bool Engine::run_singleThread()
         profiler::curr_duration.curr_uptime = upTime;
         profiler::curr_duration.curr_frame = clock.getTickCount();
         profiler::duration_buffer.add_time();
+        recordFrameTelemetry();
     }
 
     // clean up
@@ -240,44 +251,84 @@ bool Engine::run_doubleThread()
     prerun_init();
     SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_HIGH);
 
-    std::barrier<> bar{ 2 };
+    ThreadSync sync;
 
     running = true;
     bool first_frame = true;
 
     predrawRunnables();
-    drawRunnables();
+    recordRunnables(sync.snapshots.back());
+    sync.snapshots.publish();
 
     clock.reset();
-    std::thread stateWorker(&Engine::runUpdate, this, &bar);
+    std::thread stateWorker(&Engine::runUpdate, this, &sync);
+
+    using steady = std::chrono::steady_clock;
+    const auto secs_between = [](steady::time_point a, steady::time_point b) {
+        return std::chrono::duration<secs>{ b - a }.count();
+    };
 
+    // draw intervals of the current and previous frame, by frame parity
+    struct draw_interval_t {
+        size_t frame = 0;
+        steady::time_point frame_begin;
+        steady::time_point draw_begin;
+        steady::time_point draw_end;
+    };
+    std::array<draw_interval_t, 2> intervals;
+    size_t frame = 0;
 
-    while (is_running() && !runnables.empty()) {
+    // runnables are the update thread's until it's idle, checked below
+    while (is_running()) {
         profiler::curr_duration = {};
         profiler::frame_timer.reset();
 
-        updateTimer();
+        auto& interval = intervals[++frame % 2];
+        interval.frame = frame;
+        interval.frame_begin = profiler::frame_timer.start_time;
 
+        // the update thread is done with frame N-1 before events and imgui touch the world
+        // it usually is by now, it had all of the previous frame's draw, display and sleep to finish in
+        for (size_t updated = sync.frames_updated.load(std::memory_order_acquire);
+            updated + 1 < frame;
+            updated = sync.frames_updated.load(std::memory_order_acquire))
+        {
+            sync.frames_updated.wait(updated, std::memory_order_acquire);
+        }
 
-        bar.arrive_and_wait();
+        // the update thread ended the last runnable
+        if (runnables.empty())
+            break;
 
-        // do update/draw
+        updateTimer();
 
-        updateView();
-        drawRunnables();
-        profiler::curr_duration.draw_time = profiler::frame_timer.elapsed();
+        secs imgui_begin = profiler::frame_timer.elapsed();
+        bool imgui_built = buildImGui();
+        secs imgui_build_time = profiler::frame_timer.elapsed() - imgui_begin;
 
-        bar.arrive_and_wait();
+        // hand off the tick, the update thread now simulates and predraws frame N
+        sync.tick_bar.arrive_and_wait();
 
-		// predraw
+        // meanwhile draw the latest predrawn frame
+        interval.draw_begin = steady::now();
+        sync.snapshots.acquire();
+        drawSnapshot(sync.snapshots.front());
+        interval.draw_end = steady::now();
 
-        updateImGui();
+        // imgui is stamped after draw, as in the other loops
+        profiler::curr_duration.draw_time = profiler::frame_timer.elapsed() - imgui_build_time;
+
+        if (imgui_built) {
+            renderImGui();
+        }
         profiler::curr_duration.imgui_time = profiler::frame_timer.elapsed();
 
 		// clean
 
         glDeleteStale();
 
+        audio::process_commands();
+
         display();
         if (first_frame && window) {
             first_frame = false;
@@ -288,10 +339,24 @@ bool Engine::run_doubleThread()
 
         sleep();
         profiler::curr_duration.sleep_time = profiler::frame_timer.elapsed();
+
+        const auto& snap = sync.snapshots.front();
+        if (const auto& snap_interval = intervals[snap.frame % 2];
+            snap.frame > 0 && snap_interval.frame == snap.frame)
+        {
+            profiler::curr_duration.update_time  = secs_between(snap_interval.frame_begin, snap.update_end);
+            profiler::curr_duration.predraw_time = secs_between(snap_interval.frame_begin, snap.predraw_end);
+
+            auto overlap_begin = std::max(snap_interval.draw_begin, snap.update_begin);
+            auto overlap_end   = std::min(snap_interval.draw_end,   snap.predraw_end);
+            profiler::curr_duration.overlap_time = std::max(0.0, secs_between(overlap_begin, overlap_end));
+        }
+
         profiler::curr_duration.total_time = profiler::curr_duration.sleep_time;
         profiler::curr_duration.curr_uptime = upTime;
         profiler::curr_duration.curr_frame = clock.getTickCount();
         profiler::duration_buffer.add_time();
+        recordFrameTelemetry();
     }
 
     // clean up
@@ -312,31 +377,37 @@ bool Engine::run_doubleThread()
 
 
 
-void Engine::runUpdate(std::barrier<>* bar) {
+void Engine::runUpdate(ThreadSync* sync) {
     SDL_SetCurrentThreadPriority(SDL_ThreadPriority::SDL_THREAD_PRIORITY_HIGH);
 
+    size_t frame = 0;
     while (is_running() && !runnables.empty()) {
 
-        bar->arrive_and_wait();
+        sync->tick_bar.arrive_and_wait();
+        ++frame;
 
+        auto& snap = sync->snapshots.back();
+        snap.frame = frame;
 
-        // update/draw
+        // update and predraw, overlaps the render thread drawing the previous snapshot
 
+        snap.update_begin = std::chrono::steady_clock::now();
         updateRunnables();
-        profiler::curr_duration.update_time = profiler::frame_timer.elapsed();
-
-        bar->arrive_and_wait();
-
-		// predraw
+        snap.update_end = std::chrono::steady_clock::now();
 
         predrawRunnables();
-        profiler::curr_duration.predraw_time = profiler::frame_timer.elapsed();
+        recordRunnables(snap);
+        snap.predraw_end = std::chrono::steady_clock::now();
+        sync->snapshots.publish();
 
         updateStateHandler();
 
 		// cleanup
 
         cleanRunnables();
+
+        sync->frames_updated.fetch_add(1, std::memory_order_release);
+        sync->frames_updated.notify_one();
     }
 }
 
@@ -410,6 +481,8 @@ void Engine::emscripten_loop(void* engine_ptr) {
 
 	glDeleteStale();
 
+    audio::process_commands();
+
     engine->display();
     profiler::curr_duration.display_time = profiler::frame_timer.elapsed();
 
@@ -419,12 +492,22 @@ void Engine::emscripten_loop(void* engine_ptr) {
     profiler::curr_duration.curr_uptime = engine->upTime;
     profiler::curr_duration.curr_frame = engine->clock.getTickCount();
     profiler::duration_buffer.add_time();
+    engine->recordFrameTelemetry();
 #endif
 }
 
 // -------------------------------------------
 
 void Engine::close() {
+    if (!settings.telemetryOutput.empty()) {
+        if (settings.telemetryOutput.extension() == ".json") {
+            telemetry::write_json(settings.telemetryOutput);
+        }
+        else {
+            telemetry::write_csv(settings.telemetryOutput);
+        }
+    }
+
     if (window) {
         window->showWindow(false);
     }
@@ -471,19 +554,20 @@ void Engine::updateStateHandler() {
 }
 
 void Engine::updateView() {
+    if (!runnables.empty()) {
+        EngineState *st = runnables.front().getStateHandle().getActiveState();
+        updateView(st->getViewPos(), st->getViewZoom());
+    }
+}
+
+void Engine::updateView(Vec2f view_pos, float view_zoom) {
 
     ZoneScoped;
     if (window) {
-        if (!runnables.empty()) {
-            View v = window->getView();
-            EngineState *st = runnables.front().getStateHandle().getActiveState();
-            Vec2f vPos = st->getViewPos();
-            float vZoom = st->getViewZoom();
-
-            v.setCenter(vPos);
-            v.setSize(GAME_W_F * vZoom, GAME_H_F * vZoom);
-            window->setView(v);
-        }
+        View v = window->getView();
+        v.setCenter(view_pos);
+        v.setSize(GAME_W_F * view_zoom, GAME_H_F * view_zoom);
+        window->setView(v);
 
         if (avgFPS != clock.getAvgFPS() || avgUPS != clock.getAvgUPS()) {
             avgFPS = clock.getAvgFPS();
@@ -511,6 +595,8 @@ void Engine::updateView() {
 void Engine::updateRunnables() 
 {
     ZoneScoped;
+    static const auto channel = telemetry::timing("engine update");
+    telemetry::ScopedTimer timer{ channel };
     hasUpdated = tick.update_count > 0;
     while (tick.update_count > 0) {
 
@@ -530,6 +616,9 @@ void Engine::updateRunnables()
             Mouse::update(tickDuration);
         }
 
+        // sounds requested this iteration are stamped with the tick being simulated
+        audio::set_tick(clock.getTickCount() - tick.update_count + 1);
+
         for (auto& run : runnables) {
             run.getStateHandle().getActiveState()->update(tickDuration);
         }
@@ -539,6 +628,8 @@ void Engine::updateRunnables()
 void Engine::predrawRunnables() 
 {
     ZoneScoped;
+    static const auto channel = telemetry::timing("engine predraw");
+    telemetry::ScopedTimer timer{ channel };
     float interp = interpolate ? tick.interp_value : 1.f;
 
     WindowState state {
@@ -565,6 +656,8 @@ void Engine::predrawRunnables()
 
 void Engine::drawRunnables() {
     // ZoneScoped;
+    static const auto channel = telemetry::timing("engine draw");
+    telemetry::ScopedTimer timer{ channel };
     for (auto& run : runnables) {
         drawRunnable(run);
     }
@@ -573,15 +666,76 @@ void Engine::drawRunnables() {
     }
 }
 
+void Engine::recordRunnables(FrameSnapshot& snapshot) {
+    ZoneScoped;
+    snapshot.runnables.resize(runnables.size());
+
+    for (size_t i = 0; i < runnables.size(); ++i) {
+        auto& run = runnables[i];
+        auto& snap = snapshot.runnables[i];
+        auto activeState = run.getStateHandle().getActiveState();
+
+        snap.rtexture = run.getRTexture();
+        snap.clear_color = activeState->getClearColor();
+        snap.draws.reset();
+        snap.draws.draw(*activeState);
+    }
+
+    if (!runnables.empty()) {
+        auto activeState = runnables.front().getStateHandle().getActiveState();
+        snapshot.view_pos = activeState->getViewPos();
+        snapshot.view_zoom = activeState->getViewZoom();
+    }
+}
+
+void Engine::drawSnapshot(const FrameSnapshot& snapshot) {
+    // ZoneScoped;
+    static const auto channel = telemetry::timing("engine draw");
+    telemetry::ScopedTimer timer{ channel };
+
+    updateView(snapshot.view_pos, snapshot.view_zoom);
+
+    for (auto& run : snapshot.runnables) {
+        TracyGpuZone("Draw Runnable");
+        RenderTarget* target =
+            run.rtexture ?
+            static_cast<RenderTarget*>(run.rtexture) :
+            static_cast<RenderTarget*>(window);
+
+        target->clear(run.clear_color);
+        run.draws.replay(*target);
+
+        if (!run.rtexture) {
+            drawMargins(*target);
+        }
+    }
+    if (settings.showDebug) {
+        debug::draw(*window);
+    }
+}
+
 void Engine::updateImGui() {
+    if (buildImGui()) {
+        renderImGui();
+    }
+}
+
+bool Engine::buildImGui() {
 #ifdef DEBUG
     ZoneScoped;
     if (window && settings.showDebug) {
         ImGuiNewFrame(*window);
         ImGuiFrame::getInstance().display(tick.elapsed);
-        ImGuiRender();
+        ImGuiEndFrame();
+        return true;
     }
 #endif
+    return false;
+}
+
+void Engine::renderImGui() {
+    ZoneScoped;
+    ImGuiRender();
 }
 
 void Engine::cleanRunnables() {
@@ -604,11 +758,38 @@ void Engine::cleanRunnables() {
 void Engine::display()
 {
     // ZoneScoped;
+    static const auto channel = telemetry::timing("engine display");
+    telemetry::ScopedTimer timer{ channel };
     if (window) {
         window->display();
     }
 }
 
+void Engine::recordFrameTelemetry() {
+    static const auto frame_channel      = telemetry::timing("engine frame");
+    static const auto draw_calls_channel = telemetry::counter("draw calls");
+
+    // frame time without the sleep, to catch hitches regardless of the target framerate
+    secs frame_time = profiler::curr_duration.display_time;
+    telemetry::record(frame_channel, static_cast<uint64_t>(frame_time * 1e9));
+
+    // the counters restart when their target is cleared each frame, left as they are for the imgui panel
+    size_t draw_calls = target.getDrawCallCounter();
+    if (window) {
+        draw_calls += window->getDrawCallCounter();
+    }
+    telemetry::record(draw_calls_channel, draw_calls);
+
+    if (alloc::is_enabled()) {
+        static const auto allocs_channel = telemetry::counter("allocations");
+        static uint64_t prev_allocs = alloc::global_stats().count;
+
+        uint64_t allocs = alloc::global_stats().count;
+        telemetry::record(allocs_channel, allocs - prev_allocs);
+        prev_allocs = allocs;
+    }
+}
+
 void Engine::sleep() 
 {
     ZoneScoped;
@@ -1057,6 +1238,10 @@ void Engine::ImGui_getContent(secs deltaTime) {
                 plot("predraw", &buff[0].predraw_time);
                 ImPlot::SetNextFillStyle(ImVec4(1.f, 1.f, 1.f, 1.f));
                 plot("update",  &buff[0].update_time);
+
+                if (settings.runstyle == EngineRunStyle::DoubleThread) {
+                    ImPlot::PlotLine("overlap", &buff[0].curr_uptime, &buff[0].overlap_time, buff.size(), 0, 0, sizeof(profiler::Duration));
+                }
             }
 
             ImPlot::PopStyleVar();
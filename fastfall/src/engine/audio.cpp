@@ -2,23 +2,36 @@
 
 #include "fastfall/util/log.hpp"
 #include "fastfall/resource/Resources.hpp"
+#include "fastfall/util/spsc_queue.hpp"
 
 #include <SDL3/SDL.h>
 #include <SDL3_mixer/SDL_mixer.h>
 
 #include <magic_enum/magic_enum.hpp>
 
+#include "tracy/Tracy.hpp"
+
+#include <atomic>
+#include <memory>
+
 namespace ff::audio {
 
-class Track {
+constexpr uint32_t NoVoice = UINT32_MAX;
+
+class Voice {
 public:
-    explicit Track(uint32_t track_id, MIX_Mixer* mixer) : id{track_id} {
-        p_impl = MIX_CreateTrack(mixer);
-    }
-    ~Track() {
-        MIX_DestroyTrack(p_impl);
+    Voice() = default;
+    Voice(const Voice&) = delete;
+    Voice& operator=(const Voice&) = delete;
+
+    ~Voice() {
+        if (p_impl) {
+            MIX_DestroyTrack(p_impl);
+        }
     }
 
+    void create(uint32_t voice_id, MIX_Mixer* mixer);
+
     MIX_Track* ptr() const { return p_impl; }
 
     void set_tag(const char* ntag) {
@@ -32,21 +45,60 @@ public:
         tag = nullptr;
     }
 
-    uint32_t id;
+    // playing as far as the update thread knows, queued plays count
+    bool is_playing() const {
+        return stopped_serial.load(std::memory_order_acquire) != play_serial;
+    }
+
+    uint32_t id = 0;
+
+    // update thread
     uint32_t generation_counter = 0;
+    uint32_t play_serial = 0;
 
+    // owned by a SoundHandle
     bool in_use = false;
+    bool in_free_list = false;
+    uint32_t next_free = NoVoice;
+
+    // for voice stealing
+    int priority = 0;
+    float distance = 0.f;
+    uint64_t start_order = 0;
+
+    // main thread, the play being mixed
+    std::atomic<uint32_t> active_serial = 0;
 
+    // last play known to have stopped, set from the mixer thread or when a queued play is dropped
+    std::atomic<uint32_t> stopped_serial = 0;
+    std::atomic<bool> in_finished_list = false;
+    uint32_t next_finished = NoVoice;
+
+    // main thread
     const SoundAsset* source = nullptr;
 
 private:
     const char* tag = nullptr;
-    MIX_Track* p_impl;
+    MIX_Track* p_impl = nullptr;
 };
 
+struct Command {
+    enum class Type : uint8_t {
+        SetSound,
+        ApplyConfig,
+        Play,
+        Stop,
+    };
+
+    Type type;
+    uint32_t voice;
+    uint32_t serial = 0;
+    uint64_t tick = 0;
+    const SoundAsset* sound = nullptr;
+    SoundCfg cfg;
+};
 
-constexpr uint32_t tracks_min = 16;
-constexpr uint32_t tracks_max = 16;
+constexpr size_t command_capacity = 1024;
 
 struct {
     bool init_state = false;
@@ -55,10 +107,244 @@ struct {
     float gain = 1.0f;
 
     MIX_Mixer* mixer = nullptr;
-    std::vector<Track> tracks;
+    std::unique_ptr<Voice[]> voices;
+
+    // update thread only
+    uint32_t free_head = NoVoice;
+    uint32_t free_count = 0;
+    uint64_t start_counter = 0;
+    uint64_t stolen = 0;
+
+    // voices that stopped playing, lock-free stack pushed from the mixer thread
+    std::atomic<uint32_t> finished_head = NoVoice;
+
+    // requests from the update thread, carried out by process_commands()
+    spsc_queue<Command, command_capacity> commands;
+    std::atomic<uint64_t> tick = 0;
+    std::atomic<uint64_t> max_command_age = 6;
+    std::atomic<uint64_t> dropped = 0;
+
+    // main thread, newest tick whose plays were carried out
+    uint64_t processed_tick = 0;
 
 } state;
 
+namespace {
+
+    void push_free(Voice& voice) {
+        if (voice.in_free_list)
+            return;
+
+        voice.in_free_list = true;
+        voice.next_free = state.free_head;
+        state.free_head = voice.id;
+        state.free_count++;
+    }
+
+    Voice* pop_free() {
+        if (state.free_head == NoVoice)
+            return nullptr;
+
+        Voice& voice = state.voices[state.free_head];
+        state.free_head = voice.next_free;
+        state.free_count--;
+        voice.in_free_list = false;
+        voice.next_free = NoVoice;
+        return &voice;
+    }
+
+    // any thread
+    void mark_stopped(Voice& voice, uint32_t serial) {
+        uint32_t prev = voice.stopped_serial.load(std::memory_order_relaxed);
+        while (prev < serial
+            && !voice.stopped_serial.compare_exchange_weak(prev, serial, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        if (voice.in_finished_list.exchange(true))
+            return;
+
+        uint32_t head = state.finished_head.load(std::memory_order_relaxed);
+        do {
+            voice.next_finished = head;
+        } while (!state.finished_head.compare_exchange_weak(head, voice.id, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void SDLCALL on_track_stopped(void* userdata, MIX_Track* track) {
+        auto* voice = static_cast<Voice*>(userdata);
+        mark_stopped(*voice, voice->active_serial.load(std::memory_order_relaxed));
+    }
+
+    // moves stopped voices no handle holds onto the free list
+    void reclaim_finished() {
+        uint32_t ndx = state.finished_head.exchange(NoVoice, std::memory_order_acquire);
+        while (ndx != NoVoice) {
+            Voice& voice = state.voices[ndx];
+            ndx = voice.next_finished;
+            voice.next_finished = NoVoice;
+            voice.in_finished_list = false;
+
+            // may have been stolen and restarted since it stopped
+            if (!voice.in_use && !voice.is_playing()) {
+                push_free(voice);
+            }
+        }
+    }
+
+    bool less_important(int priority, float distance, const Voice& voice) {
+        return priority != voice.priority
+            ? priority < voice.priority
+            : distance > voice.distance;
+    }
+
+    // least important playing voice not held by a handle, if less important than the request
+    Voice* find_victim(int priority, float distance) {
+        Voice* victim = nullptr;
+        for (uint32_t i = 0; i < voice_count; i++) {
+            Voice& voice = state.voices[i];
+            if (voice.in_use)
+                continue;
+
+            if (!victim
+                || less_important(voice.priority, voice.distance, *victim)
+                || (voice.priority == victim->priority
+                    && voice.distance == victim->distance
+                    && voice.start_order < victim->start_order))
+            {
+                victim = &voice;
+            }
+        }
+
+        if (victim && less_important(priority, distance, *victim)) {
+            return nullptr;
+        }
+        return victim;
+    }
+
+    bool enqueue(Command cmd) {
+        cmd.tick = state.tick.load(std::memory_order_relaxed);
+        if (!state.commands.push(cmd)) {
+            state.dropped.fetch_add(1, std::memory_order_relaxed);
+            if (cmd.type == Command::Type::Play) {
+                mark_stopped(state.voices[cmd.voice], cmd.serial);
+            }
+            return false;
+        }
+        return true;
+    }
+
+    Voice* acquire(int priority, float distance) {
+        if (!state.voices)
+            return nullptr;
+
+        if (state.free_head == NoVoice) {
+            reclaim_finished();
+        }
+
+        Voice* voice = pop_free();
+        if (!voice) {
+            voice = find_victim(priority, distance);
+            if (voice) {
+                enqueue(Command{ .type = Command::Type::Stop, .voice = voice->id });
+                state.stolen++;
+            }
+        }
+
+        if (voice) {
+            voice->in_use = true;
+            voice->generation_counter++;
+            voice->priority = priority;
+            voice->distance = distance;
+        }
+        return voice;
+    }
+
+    void release(Voice& voice) {
+        voice.in_use = false;
+        if (!voice.is_playing()) {
+            push_free(voice);
+        }
+        // otherwise it's freed once it stops
+    }
+
+    Voice* get_voice(uint32_t id, uint32_t generation) {
+        if (generation > 0 && state.voices && id < voice_count) {
+            Voice& voice = state.voices[id];
+            if (voice.generation_counter == generation) {
+                return &voice;
+            }
+        }
+        return nullptr;
+    }
+
+    void execute(const Command& cmd, uint64_t latest_tick) {
+        Voice& voice = state.voices[cmd.voice];
+        switch (cmd.type) {
+        case Command::Type::SetSound:
+            voice.source = cmd.sound;
+            MIX_SetTrackAudio(voice.ptr(), cmd.sound ? cmd.sound->get_data() : nullptr);
+            break;
+        case Command::Type::ApplyConfig:
+            MIX_SetTrackGain(voice.ptr(), cmd.cfg.gain);
+            voice.set_tag(cmd.cfg.tag);
+            MIX_SetTrackGroup(voice.ptr(), cmd.cfg.group);
+            break;
+        case Command::Type::Play: {
+            // requested too long ago when the simulation ran several ticks in one frame,
+            // or already heard before the simulation went back in time
+            uint64_t age_limit = state.max_command_age.load(std::memory_order_relaxed);
+            bool stale = cmd.tick + age_limit < latest_tick
+                || cmd.tick < state.processed_tick;
+
+            if (stale) {
+                state.dropped.fetch_add(1, std::memory_order_relaxed);
+                mark_stopped(voice, cmd.serial);
+                break;
+            }
+            state.processed_tick = std::max(state.processed_tick, cmd.tick);
+
+            voice.active_serial.store(cmd.serial, std::memory_order_relaxed);
+
+            bool played;
+            if (cmd.cfg.loops == 0) {
+                played = MIX_PlayTrack(voice.ptr(), 0);
+            }
+            else {
+                SDL_PropertiesID props = SDL_CreateProperties();
+                SDL_SetNumberProperty(props, MIX_PROP_PLAY_LOOPS_NUMBER, cmd.cfg.loops);
+                played = MIX_PlayTrack(voice.ptr(), props);
+                SDL_DestroyProperties(props);
+            }
+
+            if (!played) {
+                mark_stopped(voice, cmd.serial);
+            }
+            break;
+        }
+        case Command::Type::Stop:
+            MIX_StopTrack(voice.ptr(), 0);
+            break;
+        }
+    }
+}
+
+void Voice::create(uint32_t voice_id, MIX_Mixer* mixer) {
+    id = voice_id;
+    p_impl = MIX_CreateTrack(mixer);
+    MIX_SetTrackStoppedCallback(p_impl, on_track_stopped, this);
+}
+
+void reset_voices() {
+    // drop anything still queued for the old voices
+    Command cmd;
+    while (state.commands.pop(cmd)) {}
+
+    state.voices.reset();
+    state.free_head = NoVoice;
+    state.free_count = 0;
+    state.finished_head = NoVoice;
+    state.processed_tick = 0;
+}
 
 bool init() {
 
@@ -79,14 +365,17 @@ bool init() {
     spec.freq     = 44100;
     spec.format   = SDL_AUDIO_F32LE;
 
+    reset_voices();
     if (state.mixer) MIX_DestroyMixer(state.mixer);
     state.mixer = MIX_CreateMixerDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
 
+    state.stolen = 0;
+    state.dropped = 0;
 
-    state.tracks.clear();
-    state.tracks.reserve(tracks_min);
-    for (uint32_t i = 0; i < tracks_min; i++) {
-        state.tracks.emplace_back(i, state.mixer);
+    state.voices = std::make_unique<Voice[]>(voice_count);
+    for (uint32_t i = voice_count; i-- > 0; ) {
+        state.voices[i].create(i, state.mixer);
+        push_free(state.voices[i]);
     }
 
     LOG_INFO("Initialized audio");
@@ -96,7 +385,7 @@ bool init() {
 }
 
 void quit() {
-    state.tracks.clear();
+    reset_voices();
 
     MIX_DestroyMixer(state.mixer);
     state.mixer = nullptr;
@@ -122,36 +411,73 @@ MIX_Mixer* get_mixer() {
     return state.mixer;
 }
 
+uint32_t free_voice_count() {
+    reclaim_finished();
+    return state.free_count;
 }
 
-namespace ff {
+uint64_t voices_stolen() {
+    return state.stolen;
+}
 
-SoundHandle::SoundHandle(const char* tag, MIX_Group* group) {
+void set_tick(uint64_t tick) {
+    state.tick.store(tick, std::memory_order_relaxed);
+}
 
-    audio::Track* use_track = nullptr;
-    for (auto& track : audio::state.tracks) {
-        if (!track.in_use && !MIX_TrackPlaying(track.ptr())) {
-            use_track = &track;
-            break;
-        }
-    }
+uint64_t get_tick() {
+    return state.tick.load(std::memory_order_relaxed);
+}
+
+void set_max_command_age(uint64_t ticks) {
+    state.max_command_age = ticks;
+}
+
+size_t process_commands() {
+    ZoneScoped;
+    if (!state.voices)
+        return 0;
 
-    if (!use_track) {
-        use_track = &audio::state.tracks.emplace_back(
-            audio::state.tracks.size(),
-            audio::state.mixer);
+    uint64_t latest_tick = get_tick();
+
+    size_t count = 0;
+    Command cmd;
+    while (state.commands.pop(cmd)) {
+        execute(cmd, latest_tick);
+        count++;
     }
+    return count;
+}
+
+size_t pending_commands() {
+    return state.commands.size();
+}
 
-    if (use_track) {
-        use_track->in_use = true;
-        use_track->generation_counter++;
+uint64_t commands_dropped() {
+    return state.dropped.load(std::memory_order_relaxed);
+}
+
+}
+
+namespace ff {
+
+SoundHandle::SoundHandle(const char* tag, MIX_Group* group)
+    : SoundHandle(SoundCfg{ .tag = tag, .group = group })
+{
+}
 
-        track_id   = use_track->id;
-        generation = use_track->generation_counter;
+SoundHandle::SoundHandle(const SoundCfg& cfg)
+    : config{ cfg }
+    , tag{ cfg.tag }
+    , group{ cfg.group }
+{
+    if (auto* voice = audio::acquire(cfg.priority, cfg.distance)) {
+        track_id   = voice->id;
+        generation = voice->generation_counter;
     }
 }
 
 SoundHandle::SoundHandle(SoundHandle&& other) noexcept {
+    config = other.config;
     track_id = other.track_id;
     generation = other.generation;
     tag = other.tag;
@@ -164,58 +490,68 @@ SoundHandle::SoundHandle(SoundHandle&& other) noexcept {
 }
 
 SoundHandle& SoundHandle::operator=(SoundHandle&& other) noexcept {
-    track_id = other.track_id;
-    generation = other.generation;
-    tag = other.tag;
-    group = other.group;
+    if (this != &other) {
+        if (auto* voice = audio::get_voice(track_id, generation)) {
+            audio::release(*voice);
+        }
 
-    other.track_id = 0;
-    other.generation = 0;
-    other.tag = nullptr;
-    other.group = nullptr;
+        config = other.config;
+        track_id = other.track_id;
+        generation = other.generation;
+        tag = other.tag;
+        group = other.group;
 
+        other.track_id = 0;
+        other.generation = 0;
+        other.tag = nullptr;
+        other.group = nullptr;
+    }
     return *this;
 }
 
 SoundHandle::~SoundHandle() {
-    if (generation > 0) {
-        audio::state.tracks[track_id].in_use = false;
+    if (auto* voice = audio::get_voice(track_id, generation)) {
+        audio::release(*voice);
     }
 }
 
+bool SoundHandle::valid() const {
+    return audio::get_voice(track_id, generation) != nullptr;
+}
+
 bool SoundHandle::set_sound(const SoundAsset& asset) {
-    if (generation > 0) {
-        auto& track = audio::state.tracks[track_id];
-        track.source = &asset;
-        return MIX_SetTrackAudio(track.ptr(), asset.get_data());
+    using audio::Command;
+    if (auto* voice = audio::get_voice(track_id, generation)) {
+        return audio::enqueue(Command{ .type = Command::Type::SetSound, .voice = voice->id, .sound = &asset });
     }
     return false;
 }
 
 bool SoundHandle::apply_config() {
-    if (generation > 0) {
-        auto& track = audio::state.tracks[track_id];
-
-        MIX_SetTrackGain(track.ptr(), config.gain);
-        track.set_tag(config.tag);
-        MIX_SetTrackGroup(track.ptr(), config.group);
+    using audio::Command;
+    if (auto* voice = audio::get_voice(track_id, generation)) {
+        voice->priority = config.priority;
+        voice->distance = config.distance;
+        return audio::enqueue(Command{ .type = Command::Type::ApplyConfig, .voice = voice->id, .cfg = config });
     }
     return false;
 }
 
 
 bool SoundHandle::play() {
-    if (generation > 0) {
-        auto& track = audio::state.tracks[track_id];
-        return MIX_PlayTrack(track.ptr(), {});
+    using audio::Command;
+    if (auto* voice = audio::get_voice(track_id, generation)) {
+        voice->start_order = audio::state.start_counter++;
+        voice->play_serial++;
+        return audio::enqueue(Command{ .type = Command::Type::Play, .voice = voice->id, .serial = voice->play_serial, .cfg = config });
     }
     return false;
 }
 
 bool SoundHandle::stop() {
-    if (generation > 0) {
-        auto& track = audio::state.tracks[track_id];
-        return MIX_StopTrack(track.ptr(), {});
+    using audio::Command;
+    if (auto* voice = audio::get_voice(track_id, generation)) {
+        return audio::enqueue(Command{ .type = Command::Type::Stop, .voice = voice->id });
     }
     return false;
 }
@@ -238,8 +574,11 @@ void AudioImGui::ImGui_getContent(secs deltaTime) {
         set_master_volume(master_gain);
     }
 
-    ImGui::Text("Tracks (%lu)", state.tracks.size());
-    for (auto& track : state.tracks) {
+    // the free list belongs to the update thread, this is only an estimate
+    ImGui::Text("Voices (%u free, %llu stolen)", state.free_count, (unsigned long long)voices_stolen());
+    ImGui::Text("Commands (%zu pending, %llu dropped)", pending_commands(), (unsigned long long)commands_dropped());
+    for (uint32_t i = 0; state.voices && i < voice_count; i++) {
+        auto& track = state.voices[i];
 
         MIX_Track* trackptr = track.ptr();
         ImGui::PushID(trackptr);
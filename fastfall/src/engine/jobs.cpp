@@ -0,0 +1,191 @@
+#include "fastfall/engine/jobs.hpp"
+
+#include "fastfall/util/log.hpp"
+
+#include "tracy/Tracy.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ff::jobs {
+
+namespace detail {
+
+    struct task_t {
+        Job job;
+        Group* group = nullptr;
+
+        void operator()() {
+            job();
+            group->pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    };
+
+}
+
+namespace {
+
+    struct queue_t {
+        std::mutex mutex;
+        std::deque<detail::task_t> tasks;
+    };
+
+    struct {
+        bool init_state = false;
+        std::atomic<bool> running = false;
+
+        std::vector<std::thread> threads;
+
+        // queue 0 is shared by threads outside the job system, the rest belong to each worker
+        std::unique_ptr<queue_t[]> queues;
+        size_t queue_count = 0;
+
+        // total tasks across all queues, for waking workers
+        std::atomic<size_t> queued = 0;
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+    } state;
+
+    // index of the queue owned by this thread
+    thread_local size_t this_queue = 0;
+
+    // pop from the back of our own queue, most recently pushed is likely still in cache
+    bool pop_own(detail::task_t& out) {
+        auto& queue = state.queues[this_queue];
+        std::lock_guard lock{ queue.mutex };
+        if (queue.tasks.empty())
+            return false;
+
+        out = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        state.queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // steal from the front of other queues
+    bool steal(detail::task_t& out) {
+        for (size_t i = 1; i < state.queue_count; i++) {
+            auto& queue = state.queues[(this_queue + i) % state.queue_count];
+            std::lock_guard lock{ queue.mutex };
+            if (queue.tasks.empty())
+                continue;
+
+            out = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            state.queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool try_run_one() {
+        detail::task_t task;
+        if (pop_own(task) || steal(task)) {
+            task();
+            return true;
+        }
+        return false;
+    }
+
+    void worker_loop(size_t queue_ndx) {
+        this_queue = queue_ndx;
+        while (state.running.load(std::memory_order_acquire)) {
+            if (try_run_one())
+                continue;
+
+            std::unique_lock lock{ state.sleep_mutex };
+            state.sleep_cv.wait(lock, [] {
+                return state.queued.load(std::memory_order_relaxed) > 0
+                    || !state.running.load(std::memory_order_relaxed);
+            });
+        }
+    }
+}
+
+bool init(unsigned thread_count) {
+    if (state.init_state)
+        return true;
+
+    if (thread_count == 0) {
+        // leave room for the render and update threads
+        unsigned hw = std::thread::hardware_concurrency();
+        thread_count = hw > 2 ? hw - 2 : 1;
+    }
+
+    state.queue_count = thread_count + 1;
+    state.queues = std::make_unique<queue_t[]>(state.queue_count);
+    state.running = true;
+
+    state.threads.reserve(thread_count);
+    for (size_t i = 1; i <= thread_count; i++) {
+        state.threads.emplace_back(worker_loop, i);
+    }
+
+    state.init_state = true;
+    LOG_INFO("Job system started with {} workers", thread_count);
+    return true;
+}
+
+void quit() {
+    if (!state.init_state)
+        return;
+
+    {
+        std::lock_guard lock{ state.sleep_mutex };
+        state.running = false;
+    }
+    state.sleep_cv.notify_all();
+
+    for (auto& thread : state.threads) {
+        thread.join();
+    }
+    state.threads.clear();
+    state.queues.reset();
+    state.queue_count = 0;
+    state.queued = 0;
+    state.init_state = false;
+}
+
+bool is_init() {
+    return state.init_state;
+}
+
+unsigned worker_count() {
+    return static_cast<unsigned>(state.threads.size());
+}
+
+void run(Group& group, Job job) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    detail::task_t task{ std::move(job), &group };
+    if (!state.init_state) {
+        task();
+        return;
+    }
+
+    {
+        auto& queue = state.queues[this_queue];
+        std::lock_guard lock{ queue.mutex };
+        queue.tasks.push_back(std::move(task));
+    }
+    state.queued.fetch_add(1, std::memory_order_relaxed);
+
+    // take the lock so a worker between checking for work and sleeping doesn't miss this
+    { std::lock_guard lock{ state.sleep_mutex }; }
+    state.sleep_cv.notify_one();
+}
+
+void wait(Group& group) {
+    ZoneScoped;
+    while (!group.done()) {
+        if (!state.init_state || !try_run_one()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+}
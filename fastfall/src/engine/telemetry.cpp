@@ -0,0 +1,320 @@
+#include "fastfall/engine/telemetry.hpp"
+
+#include "fastfall/util/log.hpp"
+#include "fastfall/util/alloc.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ff::telemetry {
+
+void Histogram::record(uint64_t value) {
+    buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t curr = min_value.load(std::memory_order_relaxed);
+    while (value < curr && !min_value.compare_exchange_weak(curr, value, std::memory_order_relaxed)) {}
+
+    curr = max_value.load(std::memory_order_relaxed);
+    while (value > curr && !max_value.compare_exchange_weak(curr, value, std::memory_order_relaxed)) {}
+}
+
+void Histogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total = 0;
+    sum = 0;
+    min_value = UINT64_MAX;
+    max_value = 0;
+}
+
+uint64_t Histogram::min() const {
+    return count() > 0 ? min_value.load(std::memory_order_relaxed) : 0;
+}
+
+double Histogram::mean() const {
+    uint64_t n = count();
+    return n > 0 ? static_cast<double>(sum.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+}
+
+uint64_t Histogram::percentile(double p) const {
+    uint64_t n = count();
+    if (n == 0)
+        return 0;
+
+    p = std::clamp(p, 0.0, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * static_cast<double>(n))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucket_max(i), max());
+        }
+    }
+    return max();
+}
+
+namespace {
+
+    struct channel_t {
+        std::string name;
+        Kind kind = Kind::Timing;
+
+        Histogram histogram;
+
+        std::array<std::atomic<uint64_t>, RingSize> ring{};
+        std::atomic<uint64_t> ring_write = 0;
+    };
+
+    struct {
+        std::atomic<bool> enabled = true;
+
+        // fixed storage so recording never races with registration
+        std::unique_ptr<channel_t[]> channels = std::make_unique<channel_t[]>(MaxChannels);
+        std::atomic<size_t> count = 0;
+        std::mutex register_mutex;
+    } state;
+
+    Channel find_or_register(std::string_view name, Kind kind) {
+        std::lock_guard lock{ state.register_mutex };
+
+        size_t count = state.count.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; i++) {
+            if (state.channels[i].name == name) {
+                return { static_cast<uint16_t>(i) };
+            }
+        }
+
+        if (count >= MaxChannels) {
+            LOG_WARN("Telemetry channel limit reached, not recording \"{}\"", name);
+            return {};
+        }
+
+        auto& channel = state.channels[count];
+        channel.name = name;
+        channel.kind = kind;
+        state.count.store(count + 1, std::memory_order_release);
+        return { static_cast<uint16_t>(count) };
+    }
+
+    const char* kind_str(Kind kind) {
+        return kind == Kind::Timing ? "timing" : "counter";
+    }
+}
+
+Channel timing(std::string_view name) {
+    return find_or_register(name, Kind::Timing);
+}
+
+Channel counter(std::string_view name) {
+    return find_or_register(name, Kind::Counter);
+}
+
+void record(Channel channel, uint64_t value) {
+    if (!channel.valid() || !state.enabled.load(std::memory_order_relaxed))
+        return;
+
+    auto& ch = state.channels[channel.index];
+    ch.histogram.record(value);
+
+    uint64_t ndx = ch.ring_write.fetch_add(1, std::memory_order_relaxed);
+    ch.ring[ndx % RingSize].store(value, std::memory_order_relaxed);
+}
+
+void set_enabled(bool enabled) {
+    state.enabled = enabled;
+}
+
+bool is_enabled() {
+    return state.enabled;
+}
+
+void reset() {
+    size_t count = state.count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        auto& ch = state.channels[i];
+        ch.histogram.reset();
+        ch.ring_write = 0;
+    }
+}
+
+size_t channel_count() {
+    return state.count.load(std::memory_order_acquire);
+}
+
+Summary summarize(Channel channel) {
+    if (!channel.valid() || channel.index >= channel_count())
+        return {};
+
+    auto& ch = state.channels[channel.index];
+    auto& hist = ch.histogram;
+    return {
+        .name  = ch.name,
+        .kind  = ch.kind,
+        .count = hist.count(),
+        .min   = hist.min(),
+        .mean  = hist.mean(),
+        .p50   = hist.percentile(0.5),
+        .p99   = hist.percentile(0.99),
+        .p999  = hist.percentile(0.999),
+        .max   = hist.max(),
+    };
+}
+
+size_t recent(Channel channel, std::span<uint64_t> out) {
+    if (!channel.valid() || channel.index >= channel_count())
+        return 0;
+
+    auto& ch = state.channels[channel.index];
+    uint64_t end = ch.ring_write.load(std::memory_order_relaxed);
+    uint64_t n = std::min<uint64_t>({ end, RingSize, out.size() });
+
+    for (uint64_t i = 0; i < n; i++) {
+        out[i] = ch.ring[(end - n + i) % RingSize].load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+bool write_csv(const std::filesystem::path& path) {
+    std::ofstream file{ path };
+    if (!file.is_open()) {
+        LOG_ERR_("Could not open {} for writing", path.string());
+        return false;
+    }
+
+    file << "name,kind,count,min,mean,p50,p99,p999,max\n";
+    for (size_t i = 0; i < channel_count(); i++) {
+        auto s = summarize({ static_cast<uint16_t>(i) });
+        file << fmt::format("\"{}\",{},{},{},{:.1f},{},{},{},{}\n",
+            s.name, kind_str(s.kind), s.count, s.min, s.mean, s.p50, s.p99, s.p999, s.max);
+    }
+
+    LOG_INFO("Wrote telemetry to {}", path.string());
+    return true;
+}
+
+bool write_json(const std::filesystem::path& path) {
+    std::ofstream file{ path };
+    if (!file.is_open()) {
+        LOG_ERR_("Could not open {} for writing", path.string());
+        return false;
+    }
+
+    nlohmann::ordered_json json = nlohmann::ordered_json::array();
+    for (size_t i = 0; i < channel_count(); i++) {
+        auto s = summarize({ static_cast<uint16_t>(i) });
+        json.push_back({
+            { "name",  s.name },
+            { "kind",  kind_str(s.kind) },
+            { "count", s.count },
+            { "min",   s.min },
+            { "mean",  s.mean },
+            { "p50",   s.p50 },
+            { "p99",   s.p99 },
+            { "p999",  s.p999 },
+            { "max",   s.max },
+        });
+    }
+    file << json.dump(2);
+
+    LOG_INFO("Wrote telemetry to {}", path.string());
+    return true;
+}
+
+}
+
+namespace ff {
+
+TelemetryImGui::TelemetryImGui() :
+    ImGuiContent(ImGuiContentType::SIDEBAR_LEFT, "Telemetry", "System")
+{
+}
+
+void TelemetryImGui::ImGui_getContent(secs deltaTime) {
+
+    using namespace telemetry;
+
+    bool enabled = is_enabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) {
+        set_enabled(enabled);
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!alloc::hook_installed());
+    bool track_allocs = alloc::is_enabled();
+    if (ImGui::Checkbox("Track allocations", &track_allocs)) {
+        alloc::set_enabled(track_allocs);
+    }
+    ImGui::EndDisabled();
+
+    if (ImGui::Button("Reset")) {
+        reset();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Write CSV")) {
+        write_csv("telemetry.csv");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Write JSON")) {
+        write_json("telemetry.json");
+    }
+
+    // timings are shown in microseconds
+    auto fmt_value = [](Kind kind, double value) {
+        return kind == Kind::Timing ? value / 1000.0 : value;
+    };
+
+    ImGui::TextDisabled("timings in microseconds");
+
+    constexpr ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+    if (ImGui::BeginTable("telemetry", 6, flags)) {
+        ImGui::TableSetupColumn("name");
+        ImGui::TableSetupColumn("count");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("p999");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+
+        for (size_t i = 0; i < channel_count(); i++) {
+            auto s = summarize({ static_cast<uint16_t>(i) });
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (ImGui::Selectable(s.name.data(), selected == (int)i, ImGuiSelectableFlags_SpanAllColumns)) {
+                selected = (selected == (int)i ? -1 : (int)i);
+            }
+            ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)s.count);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", fmt_value(s.kind, (double)s.p50));
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", fmt_value(s.kind, (double)s.p99));
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", fmt_value(s.kind, (double)s.p999));
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", fmt_value(s.kind, (double)s.max));
+        }
+        ImGui::EndTable();
+    }
+
+    if (selected >= 0 && selected < (int)channel_count()) {
+        Channel channel{ static_cast<uint16_t>(selected) };
+        auto s = summarize(channel);
+
+        static std::array<uint64_t, RingSize> samples;
+        static std::array<float, RingSize> values;
+        size_t n = recent(channel, samples);
+        for (size_t i = 0; i < n; i++) {
+            values[i] = static_cast<float>(fmt_value(s.kind, (double)samples[i]));
+        }
+
+        ImGui::PlotLines("##recent", values.data(), (int)n, 0, s.name.data(), 0.f, FLT_MAX, ImVec2(-1, 80));
+    }
+}
+
+}
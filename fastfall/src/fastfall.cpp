@@ -2,6 +2,7 @@
 
 #include "fastfall/render/render.hpp"
 #include "fastfall/engine/audio.hpp"
+#include "fastfall/engine/jobs.hpp"
 #include "fastfall/util/log.hpp"
 #include "fastfall/resource/Resources.hpp"
 #include "fastfall/resource/ResourceWatcher.hpp"
@@ -21,6 +22,10 @@ bool Init() {
         return false;
     }
 
+#if not defined(__EMSCRIPTEN__)
+    jobs::init();
+#endif
+
     if (InputConfig::configExists()) {
         InputConfig::readConfigFile();
     } else {
@@ -63,6 +68,7 @@ void Quit() {
     Resources::unloadAll();
     ImGuiFrame::getInstance().clear();
 
+    jobs::quit();
     audio::quit();
     render::quit();
 
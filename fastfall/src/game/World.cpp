@@ -5,6 +5,9 @@
 #include "fastfall/render/DebugDraw.hpp"
 #include "fastfall/user_types.hpp"
 #include "fastfall/engine/audio.hpp"
+#include "fastfall/engine/jobs.hpp"
+#include "fastfall/engine/telemetry.hpp"
+#include "fastfall/util/alloc.hpp"
 
 #include "tracy/Tracy.hpp"
 
@@ -33,11 +36,13 @@ World::World(World&& other) noexcept
 {
     WorldImGui::add(this);
     state = std::move(other.state);
+    other.view_caches.clear();
 }
 
 World& World::operator=(const World& other) {
     WorldImGui::add(this);
     state = other.state;
+    view_caches.clear();
     system<SceneSystem>().reset_proxy_ptrs(components<Drawable>());
     return *this;
 }
@@ -45,6 +50,8 @@ World& World::operator=(const World& other) {
 World& World::operator=(World&& other) noexcept {
     WorldImGui::add(this);
     state = std::move(other.state);
+    view_caches.clear();
+    other.view_caches.clear();
     return *this;
 }
 
@@ -54,32 +61,104 @@ World::~World() {
 
 void World::update(secs deltaTime) {
     if (deltaTime > 0.0 && system<LevelSystem>().get_active(*this)) {
-        { ZoneScopedN("Update Scene System");       system<SceneSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Attach System");      system<AttachSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Input");              state._input.update(deltaTime); }
-        { ZoneScopedN("Update Level System");       system<LevelSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Actor System");       system<ActorSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Trigger System");     system<TriggerSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Path System");        system<PathSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Attachpoints Pre");   system<AttachSystem>().update_attachpoints(*this, deltaTime, AttachPoint::Schedule::PostUpdate); }
-        { ZoneScopedN("Update Collision");          system<CollisionSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Attachpoints Post");  system<AttachSystem>().update_attachpoints(*this, deltaTime, AttachPoint::Schedule::PostCollision); }
-        { ZoneScopedN("Update Camera System");      system<CameraSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Emitter System");     system<EmitterSystem>().update(*this, deltaTime); }
-        { ZoneScopedN("Update Audio System");       system<AudioSystem>().update(deltaTime); }
 
-        {
-            ZoneScopedN("Update Drawables");
-            for (auto [did, drawable]: all<Drawable>()) {
-                drawable->update(deltaTime);
+        constexpr AccessMask exclusive = access_mask<AccessAll, AccessAll>();
+
+        static constexpr update_step_t steps[] = {
+            { "Update Scene System",        system_access<SceneSystem>(),   [](World& w, secs dt) { w.system<SceneSystem>().update(w, dt); } },
+            { "Update Attach System",       system_access<AttachSystem>(),  [](World& w, secs dt) { w.system<AttachSystem>().update(w, dt); } },
+            { "Update Input",               access_mask<Access<>, Access<InputAccess>>(),
+                                                                            [](World& w, secs dt) { w.state._input.update(dt); } },
+            { "Update Level System",        system_access<LevelSystem>(),   [](World& w, secs dt) { w.system<LevelSystem>().update(w, dt); } },
+            { "Update Actor System",        system_access<ActorSystem>(),   [](World& w, secs dt) { w.system<ActorSystem>().update(w, dt); } },
+            { "Update Trigger System",      system_access<TriggerSystem>(), [](World& w, secs dt) { w.system<TriggerSystem>().update(w, dt); } },
+            { "Update Path System",         system_access<PathSystem>(),    [](World& w, secs dt) { w.system<PathSystem>().update(w, dt); } },
+            { "Update Attachpoints Pre",    exclusive,                      [](World& w, secs dt) { w.system<AttachSystem>().update_attachpoints(w, dt, AttachPoint::Schedule::PostUpdate); } },
+            { "Update Collision",           system_access<CollisionSystem>(), [](World& w, secs dt) { w.system<CollisionSystem>().update(w, dt); } },
+            { "Update Attachpoints Post",   exclusive,                      [](World& w, secs dt) { w.system<AttachSystem>().update_attachpoints(w, dt, AttachPoint::Schedule::PostCollision); } },
+            { "Update Camera System",       system_access<CameraSystem>(),  [](World& w, secs dt) { w.system<CameraSystem>().update(w, dt); } },
+            { "Update Emitter System",      system_access<EmitterSystem>(), [](World& w, secs dt) { w.system<EmitterSystem>().update(w, dt); } },
+            { "Dispatch Emitter Events",    exclusive,                      [](World& w, secs dt) { w.system<EmitterSystem>().dispatch_events(w, dt); } },
+            { "Update Audio System",        system_access<AudioSystem>(),   [](World& w, secs dt) { w.system<AudioSystem>().update(dt); } },
+            { "Update Drawables",           access_mask<Access<>, Access<Drawable>>(),
+                                                                            [](World& w, secs dt) {
+                                                                                for (auto [did, drawable]: w.all<Drawable>()) {
+                                                                                    drawable->update(dt);
+                                                                                }
+                                                                            } },
+        };
+
+        static const auto step_channels = [] {
+            std::array<update_step_channels_t, std::size(steps)> channels;
+            for (size_t i = 0; i < channels.size(); i++) {
+                channels[i].time   = telemetry::timing(steps[i].name);
+                channels[i].allocs = telemetry::counter(fmt::format("{} allocs", steps[i].name));
             }
-        }
+            return channels;
+        }();
+
+        run_update_steps(steps, step_channels, deltaTime);
+        process_destroyed();
 
         state.update_counter++;
         state.update_time += deltaTime;
     }
 }
 
+void World::run_update_steps(std::span<const update_step_t> steps, std::span<const update_step_channels_t> channels, secs deltaTime) {
+
+    // debug drawing is only shared state while it's shown
+    const uint32_t ignored = debug::show ? 0u : access_bit<DebugDrawAccess>();
+
+    auto run_step = [this, steps, channels, deltaTime](size_t ndx) {
+        ZoneScoped;
+        ZoneName(steps[ndx].name.data(), steps[ndx].name.size());
+        alloc::Scope allocs;
+        {
+            telemetry::ScopedTimer timer{ channels[ndx].time };
+            steps[ndx].update(*this, deltaTime);
+        }
+        if (alloc::is_enabled()) {
+            telemetry::record(channels[ndx].allocs, allocs.stats().count);
+        }
+    };
+
+    size_t begin = 0;
+    while (begin < steps.size()) {
+
+        // gather the following steps that don't conflict with any step already in this stage
+        AccessMask stage = steps[begin].access;
+        stage.reads  &= ~ignored;
+        stage.writes &= ~ignored;
+
+        size_t end = begin + 1;
+        for (; end < steps.size(); ++end) {
+            AccessMask next = steps[end].access;
+            next.reads  &= ~ignored;
+            next.writes &= ~ignored;
+            if (stage.conflicts(next))
+                break;
+            stage |= next;
+        }
+
+        if (end - begin == 1 || !jobs::is_init()) {
+            for (size_t i = begin; i < end; ++i) {
+                run_step(i);
+            }
+        }
+        else {
+            // the steps touch disjoint state, so the result is the same as running them in order
+            jobs::Group group;
+            for (size_t i = begin + 1; i < end; ++i) {
+                jobs::run(group, [&run_step, i]() { run_step(i); });
+            }
+            run_step(begin);
+            jobs::wait(group);
+        }
+        begin = end;
+    }
+}
+
 void World::predraw(predraw_state_t predraw_state)
 {
     if (auto* active = system<LevelSystem>().get_active(*this))
@@ -89,7 +168,7 @@ void World::predraw(predraw_state_t predraw_state)
         system<ActorSystem>().predraw(*this, predraw_state);
         system<LevelSystem>().predraw(*this, predraw_state);
         system<EmitterSystem>().predraw(*this, predraw_state);
-        system<SceneSystem>().set_cam_pos(system<CameraSystem>().getPosition(predraw_state.interp));
+        process_destroyed();
         system<SceneSystem>().predraw(*this, predraw_state);
     }
     else
@@ -116,7 +195,7 @@ std::optional<ID_ptr<Actor>> World::create_actor_from_data(LevelObjectData& data
     }
 
     auto id = create_entity();
-    auto actor_id = components<Actor>().emplace(copyable_unique_ptr<Actor>());
+    auto actor_id = components<Actor>().create_empty();
     state._entities.at(id).actor = actor_id;
 
     const ActorType* type = ff::user_types::get_actor_type(data.typehash);
@@ -133,7 +212,7 @@ std::optional<ID_ptr<Actor>> World::create_actor_from_data(LevelObjectData& data
         .level_object = &data
     };
 
-    components<Actor>().emplace_at(actor_id, init.create());
+    init.create(components<Actor>());
     if (auto *ptr = get(actor_id); ptr && ptr->is_initialized()) {
         system_notify_created<Actor>(actor_id);
         return ID_ptr<Actor>{actor_id, get(actor_id)};
@@ -147,13 +226,8 @@ std::optional<ID_ptr<Actor>> World::create_actor_from_data(LevelObjectData& data
 void World::reset_entity(ID<Entity> id) {
     if (state._entities.exists(id)) {
         auto& ent = state._entities.at(id);
-        auto actor = ent.actor;
         auto cmp_set = ent.components;
-        if (actor) {
-            system_notify_erased<Actor>(*actor);
-            components<Actor>().erase(*actor);
-            ent.actor.reset();
-        }
+        erase_actor(id);
         for (auto& c : cmp_set) {
             erase(c);
         }
@@ -170,6 +244,15 @@ bool World::erase(ID<Entity> entity) {
 }
 
 bool World::erase(ComponentID component) {
+    // may already be gone, e.g. an attachpoint erased along with its collidable
+    if (!is_live(component)) {
+        return false;
+    }
+
+    if (auto* actor_id = std::get_if<ID<Actor>>(&component)) {
+        return erase_actor(get(*actor_id)->entity_id);
+    }
+
     auto ent = entity_of(component);
     if (system<AttachSystem>().is_attached(component)) {
         system<AttachSystem>().erase(component);
@@ -177,7 +260,33 @@ bool World::erase(ComponentID component) {
     std::visit([&, this]<typename T>(ID<T> id) {
             system_notify_erased(id);
             untie_component_entity(id, ent);
+        }, component);
+    remove_component(component);
+    return true;
+}
+
+bool World::erase_actor(ID<Entity> entity_id) {
+    auto& ent = state._entities.at(entity_id);
+    if (!ent.actor) {
+        return false;
+    }
+    auto actor_id = *ent.actor;
+    system_notify_erased<Actor>(actor_id);
+    ent.actor.reset();
+    remove_component(actor_id);
+    return true;
+}
+
+void World::remove_component(ComponentID component) {
+    // systems taking spans are told at the end of the batch, keep it around until then
+    if (in_batch()) {
+        batch_state.removed.push_back(component);
+        return;
+    }
+
+    std::visit([this]<typename T>(ID<T> id) {
             if constexpr (std::same_as<T, Drawable>) {
+                // the scene may still refer to it, see clean_drawables
                 state.erase_drawables_deferred.insert(
                     std::lower_bound(
                             state.erase_drawables_deferred.begin(),
@@ -188,8 +297,137 @@ bool World::erase(ComponentID component) {
             else {
                 components<T>().erase(id);
             }
+            // again, in case a view was rebuilt while systems were notified
+            bump_version<T>();
+        }, component);
+}
+
+bool World::is_live(ComponentID component) const {
+    return std::visit([this]<typename T>(ID<T> id) {
+            if (!components<T>().exists(id)) {
+                return false;
+            }
+
+            // erased ones are untied from their entity right away, though removal may wait
+            if constexpr (std::same_as<T, Actor>) {
+                auto* actor = get(id);
+                return actor
+                    && state._entities.exists(actor->entity_id)
+                    && state._entities.at(actor->entity_id).actor == id;
+            }
+            else {
+                auto ent = find_entity_of(id);
+                return ent && state._entities.exists(*ent) && state._entities.at(*ent).components.contains(id);
+            }
         }, component);
-    return true;
+}
+
+void World::destroy(ID<Entity> entity_id) {
+    state.destroy_entities.push_back(entity_id);
+}
+
+void World::destroy(ComponentID component_id) {
+    state.destroy_components.push_back(component_id);
+}
+
+void World::process_destroyed() {
+    if (state.destroy_entities.empty() && state.destroy_components.empty())
+        return;
+
+    auto entities = std::move(state.destroy_entities);
+    auto components = std::move(state.destroy_components);
+    state.destroy_entities.clear();
+    state.destroy_components.clear();
+
+    // queued more than once, or gone already, are skipped by erase
+    auto scope = batch();
+    for (auto c : components) {
+        erase(c);
+    }
+    for (auto e : entities) {
+        erase(e);
+    }
+}
+
+size_t World::erase(std::span<const ID<Entity>> entity_ids) {
+    auto scope = batch();
+    size_t count = 0;
+    for (auto id : entity_ids) {
+        count += erase(id);
+    }
+    return count;
+}
+
+void World::begin_batch() {
+    batch_state.depth++;
+}
+
+void World::end_batch() {
+    assert(batch_state.depth > 0);
+    if (batch_state.depth > 1) {
+        batch_state.depth--;
+        return;
+    }
+
+    // still open while flushing, whatever the systems create or erase in response
+    // is picked up by the next pass
+    auto pending = [this] {
+        return !batch_state.tied.empty()
+            || !batch_state.untied.empty()
+            || !batch_state.removed.empty()
+            || std::apply([](auto&... ids) { return (!ids.empty() || ...); }, batch_state.created)
+            || std::apply([](auto&... ids) { return (!ids.empty() || ...); }, batch_state.erased);
+    };
+
+    while (pending()) {
+        // entity lookups first, systems may need them
+        auto& comp_to_ent = state._comp_to_ent;
+        if (!batch_state.untied.empty()) {
+            std::sort(batch_state.untied.begin(), batch_state.untied.end());
+            std::erase_if(comp_to_ent, [this](const state_t::comp_to_ent_t& c) {
+                return std::binary_search(batch_state.untied.begin(), batch_state.untied.end(), c.c_id);
+            });
+            batch_state.untied.clear();
+        }
+        if (!batch_state.tied.empty()) {
+            auto mid = (std::ptrdiff_t)comp_to_ent.size();
+            comp_to_ent.insert(comp_to_ent.end(), batch_state.tied.begin(), batch_state.tied.end());
+            std::inplace_merge(comp_to_ent.begin(), comp_to_ent.begin() + mid, comp_to_ent.end());
+            batch_state.tied.clear();
+        }
+
+        // erased components are still in place while the systems are told
+        std::apply([this]<typename... Ts>(std::vector<ID<Ts>>&...) {
+            (flush_erased<Ts>(), ...);
+        }, batch_state.erased);
+
+        if (!batch_state.removed.empty()) {
+            auto removed = std::move(batch_state.removed);
+            batch_state.removed.clear();
+
+            bool drawables = false;
+            for (auto& component : removed) {
+                std::visit([&, this]<typename T>(ID<T> id) {
+                        if constexpr (std::same_as<T, Drawable>) {
+                            state.erase_drawables_deferred.push_back(id);
+                            drawables = true;
+                        }
+                        else {
+                            components<T>().erase(id);
+                        }
+                        bump_version<T>();
+                    }, component);
+            }
+            if (drawables) {
+                std::sort(state.erase_drawables_deferred.begin(), state.erase_drawables_deferred.end());
+            }
+        }
+
+        std::apply([this]<typename... Ts>(std::vector<ID<Ts>>&...) {
+            (flush_created<Ts>(), ...);
+        }, batch_state.created);
+    }
+    batch_state.depth = 0;
 }
 
 bool World::erase_all_components(ID<Entity> entity_id) {
@@ -205,6 +443,9 @@ void World::clean_drawables() {
    for(auto id : state.erase_drawables_deferred) {
        components<Drawable>().erase(id);
    }
+   if (!state.erase_drawables_deferred.empty()) {
+       bump_version<Drawable>();
+   }
    state.erase_drawables_deferred.clear();
 }
 bool World::due_to_erase(ID<Drawable> id) const {
@@ -216,15 +457,24 @@ const std::set<ComponentID>& World::components_of(ID<Entity> id) const {
 }
 
 ID<Entity> World::entity_of(ComponentID id) const {
+    auto ent = find_entity_of(id);
+    assert(ent);
+    return ent.value_or(ID<Entity>{});
+}
+
+std::optional<ID<Entity>> World::find_entity_of(ComponentID id) const {
 
     auto it = std::lower_bound(state._comp_to_ent.begin(), state._comp_to_ent.end(), state_t::comp_to_ent_t{ id, ID<Entity>{} });
     if (it != state._comp_to_ent.end() && it->c_id == id) {
         return it->e_id;
     }
-    else {
-        assert(false);
-        return {};
+
+    // tied during the open batch
+    auto tied = std::lower_bound(batch_state.tied.begin(), batch_state.tied.end(), state_t::comp_to_ent_t{ id, ID<Entity>{} });
+    if (tied != batch_state.tied.end() && tied->c_id == id) {
+        return tied->e_id;
     }
+    return std::nullopt;
 }
 
 bool World::entity_has_actor(ID<Entity> id) const {
@@ -239,6 +489,15 @@ void World::tie_component_entity(ComponentID cmp, ID<Entity> ent) {
     if (it != state._comp_to_ent.end() && it->c_id == data.c_id) {
         it->e_id = ent;
     }
+    else if (in_batch()) {
+        auto tied = std::lower_bound(batch_state.tied.begin(), batch_state.tied.end(), data);
+        if (tied != batch_state.tied.end() && tied->c_id == data.c_id) {
+            tied->e_id = ent;
+        }
+        else {
+            batch_state.tied.insert(tied, data);
+        }
+    }
     else {
         state._comp_to_ent.insert(it, data);
     }
@@ -247,6 +506,17 @@ void World::tie_component_entity(ComponentID cmp, ID<Entity> ent) {
 void World::untie_component_entity(ComponentID cmp, ID<Entity> ent) {
     state._entities.at(ent).components.erase(cmp);
 
+    if (in_batch()) {
+        auto tied = std::lower_bound(batch_state.tied.begin(), batch_state.tied.end(), state_t::comp_to_ent_t{ cmp, ent });
+        if (tied != batch_state.tied.end() && tied->c_id == cmp) {
+            batch_state.tied.erase(tied);
+        }
+        else {
+            batch_state.untied.push_back(cmp);
+        }
+        return;
+    }
+
     auto data = state_t::comp_to_ent_t{ cmp, ent };
     auto it = std::lower_bound(state._comp_to_ent.begin(), state._comp_to_ent.end(), data);
     if (it != state._comp_to_ent.end() && it->c_id == data.c_id) {
@@ -20,6 +20,42 @@ std::vector<WorldImGui::WorldData> WorldImGui::worlds;
 
 // ------------------------------------------------------------
 
+void imgui_collision_trace(WorldImGui::WorldData& wd) {
+    auto& colSys = wd.world->system<CollisionSystem>();
+
+    bool recording = colSys.getTrace() != nullptr;
+    if (ImGui::Checkbox("Record Collision Trace", &recording)) {
+        if (recording) {
+            if (!wd.collision_trace) {
+                wd.collision_trace = std::make_unique<CollisionTrace>();
+            }
+            colSys.setTrace(wd.collision_trace.get());
+        }
+        else {
+            colSys.setTrace(nullptr);
+        }
+    }
+
+    if (!wd.collision_trace) {
+        return;
+    }
+
+    ImGui::Text("Records: %zu / %zu", wd.collision_trace->size(), wd.collision_trace->capacity());
+    ImGui::InputText("Trace File", wd.trace_path, sizeof(wd.trace_path));
+    if (ImGui::Button("Save Trace")) {
+        if (wd.collision_trace->save(wd.trace_path)) {
+            LOG_INFO("Saved collision trace to {}", wd.trace_path);
+        }
+        else {
+            LOG_WARN("Failed to save collision trace to {}", wd.trace_path);
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear Trace")) {
+        wd.collision_trace->clear();
+    }
+}
+
 void imgui_collidables(World* w) {
     for (auto [cid, col] : w->all<Collidable>()) {
         if (ImGui::TreeNode((void*)(&col), "Collidable %d", cid.value.sparse_index)) {
@@ -680,6 +716,8 @@ void WorldImGui::ImGui_getContent(secs deltaTime)
         if (ImGui::BeginTabItem("Components")) {
             if (ImGui::BeginTabBar("Components")) {
                 if (ImGui::BeginTabItem("Collidables")) {
+                    imgui_collision_trace(*w);
+                    ImGui::Separator();
                     imgui_collidables(w->world);
                     ImGui::EndTabItem();
                 }
@@ -729,6 +767,11 @@ void WorldImGui::add(World* w) {
 
 void WorldImGui::remove(World* w) {
     std::erase_if(worlds, [&](auto& data) {
+        if (data.world == w && data.collision_trace
+            && w->system<CollisionSystem>().getTrace() == data.collision_trace.get())
+        {
+            w->system<CollisionSystem>().setTrace(nullptr);
+        }
         return data.world == w;
     });
 }
@@ -15,20 +15,20 @@ ActorInit& ActorInit::type_or(const ActorType* n_type) {
     return *this;
 }
 
-copyable_unique_ptr<Actor> ActorInit::create() const {
+bool ActorInit::create(poly_id_map<Actor>& actors) const {
     if (!level_object) {
         LOG_ERR_("actor init has no associated level object");
-        return {};
+        return false;
     }
 
     if (!type) {
         LOG_ERR_("actor init has no actor type");
-        return {};
+        return false;
     }
 
     if (!type->has_builder()) {
         LOG_ERR_("actor type has not constructible from data");
-        return {};
+        return false;
     }
 
     auto data = *level_object;
@@ -40,13 +40,13 @@ copyable_unique_ptr<Actor> ActorInit::create() const {
         LOG_ERR_("object width ({}) not valid for object:{:x}",
                  data.area.width, data.typehash
         );
-        return {};
+        return false;
     }
     if (tile_size.y > 0 && (data.area.height / TILESIZE != tile_size.y)) {
         LOG_ERR_("object height ({}) not valid for object:{:x}",
                  data.area.height, data.typehash
         );
-        return {};
+        return false;
     }
 
     // test custom properties
@@ -61,7 +61,7 @@ copyable_unique_ptr<Actor> ActorInit::create() const {
                 LOG_ERR_("actor property ({}) not defined for level object:{:x}",
                          prop.name, data.typehash
                 );
-                return {};
+                return false;
             }
         }
 
@@ -69,10 +69,10 @@ copyable_unique_ptr<Actor> ActorInit::create() const {
             LOG_ERR_("actor property ({}={}) not valid for object:{:x}",
                      it->first, it->second.str_value, data.typehash
             );
-            return {};
+            return false;
         }
     }
-    return type->build_with_data(*this, data);
+    return type->build_with_data(actors, *this, data);
 }
 
 }
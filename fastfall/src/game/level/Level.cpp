@@ -51,6 +51,7 @@ void Level::initFromAsset(World& world, const LevelAsset& levelData)
 	bgColor = levelData.getBGColor();
 	levelSize = levelData.getTileDimensions();
 
+	auto batch = world.batch();
 	for (auto& layerRef : levelData.getLayerRefs().get_tile_layers())
 	{
 		if (layerRef.position < 0) {
@@ -416,14 +416,17 @@ bool LevelEditor::applyLevelAsset(const LevelAsset* asset)
 
 		unsigned paint_count = 0;
 		unsigned erase_count = 0;
+		Vec2u level_size = tlayer.getLevelSize();
+		std::vector<TileLayer::TileEdit> edits;
 		for (auto tile_it = tile_ref_data.cbegin(); tile_it != tile_ref_data.cend(); tile_it++) 
 		{
-			auto& tilelayer = layer.tilelayer;
 			Vec2u pos = { (unsigned)tile_it.column(), (unsigned)tile_it.row() };
+			if (pos.x >= level_size.x || pos.y >= level_size.y)
+				continue;
 
-			if (tile_it->has_tile)
+			if (tile_it->has_tile())
 			{
-				auto tile_id = tile_it->base_id;
+				auto tile_id = tile_ref.getBaseID(*tile_it);
 				auto tileset = tile_ref.getTilesetFromNdx(tile_it->tileset_ndx);
 
 				if (   (!tlayer.hasTileAt(pos))
@@ -431,17 +434,18 @@ bool LevelEditor::applyLevelAsset(const LevelAsset* asset)
 					|| (tlayer.getTileTileset(pos) != tileset))
 				{
 					paint_count++;
-					select_tileset(tileset);
-					select_tile(tile_id);
-					paint_tile(pos);
+					edits.push_back({ pos, tile_id, tileset });
 				}
 			}
 			else if (tlayer.hasTileAt(pos)) {
 				erase_count++;
-				erase_tile(pos);
+				edits.push_back({ pos });
 			}
 		}
 
+		// autotiles are solved once for the whole layer
+		tlayer.setTiles(world, edits);
+
 		// predraw to apply changes
         tlayer.predraw(world, predraw_state_t{ .interp = 1.f, .updated = true, .update_dt = 0.0 });
 
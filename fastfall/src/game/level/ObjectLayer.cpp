@@ -94,6 +94,9 @@ bool ObjectLayer::removeObjectDataByID(ObjLevelID id) {
 }
 
 void ObjectLayer::createActorsFromObjects(World& world) {
+	world.reserve<Entity>(object_refs.size());
+	world.reserve<Actor>(object_refs.size());
+	auto batch = world.batch();
 	for (auto& objRef : object_refs) {
 		if (objRef.typehash != 0) {
             objRef.all_objects = &object_refs;
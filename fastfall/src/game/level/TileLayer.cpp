@@ -24,7 +24,6 @@ const ActorType TileLayer::actor_type = ActorType::create<TileLayer>({
 TileLayer::TileLayer(ActorInit init, unsigned id, Vec2u levelsize)
 	: Actor{init.type_or(&actor_type) }
     , layer_data(id, levelsize)
-	, tiles_dyn(levelsize)
     , attach_id(init.world.create<AttachPoint>(init.entity_id, id_placeholder))
 {
 }
@@ -64,21 +63,23 @@ void TileLayer::initFromAsset(World& world, const TileLayerData& layerData) {
         world.system<SceneSystem>().set_config(chunk, {layer, scene_type::Level});
         dyn.chunks.push_back(chunk);
 
-        chunk->setTexture(tileset->getTexture());
+        chunk->setTexture(tileset->getTexture(), tileset->getTextureArea());
         chunk->use_visible_rect = true;
         world.system<AttachSystem>().create(world, attach_id, chunk);
 	}
 
 	// init tiles
 	const auto& tiles = layer_data.getTileData();
-	tiles_dyn = grid_vector<TileDynamic>(layer_data.getSize());
+	tiles_dyn.clear();
 
-	for (const auto& tile : tiles)
+	for (auto tile_it = tiles.cbegin(); tile_it != tiles.cend(); ++tile_it)
 	{
-        auto& dyn_tile = tiles_dyn[tile.pos];
-		if (!tile.has_tile)
+        const auto& tile = *tile_it;
+		if (!tile.has_tile())
 			continue;
 
+        Vec2u pos{ (unsigned)tile_it.column(), (unsigned)tile_it.row() };
+
 		const auto* tileset = layer_data.getTilesetFromNdx(tile.tileset_ndx);
 		auto opt_tile = tileset->getTile(tile.tile_id);
 
@@ -100,12 +101,12 @@ void TileLayer::initFromAsset(World& world, const TileLayerData& layerData) {
                     .tiles       = {}
                 });
             }
-            it->tiles.insert(tile.pos);
-            dyn_tile.timer_id = std::distance(dyn.timers.begin(), it);
+            it->tiles.insert(pos);
+            tiles_dyn[pos].timer_id = std::distance(dyn.timers.begin(), it);
         }
 
         world.at(dyn.chunks.at(tile.tileset_ndx))
-            .setTile(tile.pos, getDisplayTileID(tile.pos, opt_tile->id));
+            .setTile(pos, getDisplayTileID(pos, opt_tile->id));
 
 		if (auto [logic, args] = tileset->getTileLogic(tile.tile_id);
             !logic.empty())
@@ -120,13 +121,13 @@ void TileLayer::initFromAsset(World& world, const TileLayerData& layerData) {
 
 			if (logic_it != dyn.tile_logic.end())
 			{
-				dyn_tile.logic_id = logic_ndx - 1;
-				logic_it->get()->addTile(tile.pos, *opt_tile, args);
+				tiles_dyn[pos].logic_id = logic_ndx - 1;
+				logic_it->get()->addTile(pos, *opt_tile, args);
 			}
 			else if (auto* logic_factory = ff::user_types::get_tile_logic_factory(logic)) {
-                dyn_tile.logic_id = dyn.tile_logic.size();
+                tiles_dyn[pos].logic_id = dyn.tile_logic.size();
                 dyn.tile_logic.emplace_back(logic_factory(world));
-                dyn.tile_logic.back()->addTile(tile.pos, *opt_tile, args);
+                dyn.tile_logic.back()->addTile(pos, *opt_tile, args);
             }
 		}
 	}
@@ -204,14 +205,16 @@ bool TileLayer::set_collision(World& world, bool enabled, unsigned border)
             dyn.collision.collider = world.create<ColliderTileMap>(entity_id, Vec2i{getLevelSize() }, true);
             auto* collider = get_collider(world);
 			layer_data.setCollision(true, border);
-			for (const auto& tile_data : layer_data.getTileData()) {
-				if (tile_data.has_tile && tile_data.tileset_ndx != TILEDATA_NONE) {
+			const auto& tiles = layer_data.getTileData();
+			for (auto tile_it = tiles.cbegin(); tile_it != tiles.cend(); ++tile_it) {
+				const auto& tile_data = *tile_it;
+				if (tile_data.has_tile()) {
 					const auto* tileset = layer_data.getTilesetFromNdx(tile_data.tileset_ndx);
 					auto tile = tileset->getTile(tile_data.tile_id);
 
 					if (tile) {
 						collider->setTile(
-							Vec2i{ tile_data.pos },
+							Vec2i{ (int)tile_it.column(), (int)tile_it.row() },
 							tile->shape,
 							&tileset->getMaterial(tile_data.tile_id),
 							tile->matFacing
@@ -234,11 +237,11 @@ bool TileLayer::set_collision(World& world, bool enabled, unsigned border)
                         || pos.y < 0 || pos.y >= size.y)
                         return true;
 
-                    auto& tiles_dyn = tile_layer.tiles_dyn;
+                    auto tile_dyn = tile_layer.getTileDynamic(Vec2u{ pos });
 
                     bool r = true;
-                    if (tiles_dyn[pos].logic_id != TILEDATA_NONE) {
-                        r = tile_layer.dyn.tile_logic.at(tiles_dyn[pos].logic_id)->on_precontact(w, contact, duration);
+                    if (tile_dyn.logic_id != TILEDATA_NONE) {
+                        r = tile_layer.dyn.tile_logic.at(tile_dyn.logic_id)->on_precontact(w, contact, duration);
                     }
                     return r;
                 }
@@ -256,11 +259,10 @@ bool TileLayer::set_collision(World& world, bool enabled, unsigned border)
                         || pos.y < 0 || pos.y >= size.y)
                         return;
 
-                    auto& tiles_dyn = tile_layer.tiles_dyn;
+                    auto tile_dyn = tile_layer.getTileDynamic(Vec2u{ pos });
 
-                    //unsigned ndx = pos.y * getLevelSize().x + pos.x;
-                    if (tiles_dyn[pos].logic_id != TILEDATA_NONE) {
-                        tile_layer.dyn.tile_logic.at(tiles_dyn[pos].logic_id)->on_postcontact(w, contact, deltaTime);
+                    if (tile_dyn.logic_id != TILEDATA_NONE) {
+                        tile_layer.dyn.tile_logic.at(tile_dyn.logic_id)->on_postcontact(w, contact, deltaTime);
                     }
                 }
 			);
@@ -342,7 +344,7 @@ void TileLayer::predraw(World& world, predraw_state_t predraw_state) {
 				if (cmd.type == TileLogicCommand::Type::Set) {
 					setTile(world, cmd.position, cmd.texposition, cmd.tileset);
 				}
-				else if (tile_data[cmd.position].has_tile && cmd.type == TileLogicCommand::Type::Remove) {
+				else if (tile_data[cmd.position].has_tile() && cmd.type == TileLogicCommand::Type::Remove) {
 					removeTile(world, cmd.position);
 				}
 				ptr->popCommand();
@@ -357,7 +359,6 @@ void TileLayer::predraw(World& world, predraw_state_t predraw_state) {
     for (auto& timer : dyn.timers) {
         if (timer.apply_tiles) {
             for (auto &pos: timer.tiles) {
-                auto &data_dyn = tiles_dyn.at(pos);
                 auto &data_st = layer_data.getTileData().at(pos);
                 auto &chunk = world.at(dyn.chunks.at(data_st.tileset_ndx));
                 chunk.setTile(pos, getDisplayTileID(pos, data_st.tile_id));
@@ -385,8 +386,15 @@ void TileLayer::predraw(World& world, predraw_state_t predraw_state) {
 	}
 
     // apply offsets to tile chunks
-    for (auto& chunk_id : dyn.chunks) {
-        auto& chunk = world.at(chunk_id);
+    const auto& tilesets = layer_data.getTilesets();
+    for (size_t i = 0; i < dyn.chunks.size(); ++i) {
+        auto& chunk = world.at(dyn.chunks[i]);
+
+        // a reloaded tileset may have moved in the atlas, or out of it
+        if (i < tilesets.size() && tilesets[i].tileset) {
+            chunk.setTexture(tilesets[i].tileset->getTexture(), tilesets[i].tileset->getTextureArea());
+        }
+
         chunk.visibility = visible;
         if (hasParallax())  { chunk.offset = dyn.parallax.offset; }
         if (hasScrolling()) { chunk.scroll = math::lerp(dyn.scroll.prev_offset, dyn.scroll.offset, predraw_state.interp); }
@@ -419,15 +427,60 @@ void TileLayer::predraw(World& world, predraw_state_t predraw_state) {
 
 void TileLayer::setTile(World& world, const Vec2u& position, TileID tile_id, const TilesetAsset& tileset)
 {
-	auto result = layer_data.setTile(position, tile_id, tileset);
+	applyTileChanges(world, layer_data.setTile(position, tile_id, tileset), &tileset);
+}
+
+void TileLayer::removeTile(World& world, const Vec2u& position) {
+	applyTileChanges(world, layer_data.removeTile(position), nullptr);
+}
+
+void TileLayer::setTiles(World& world, std::span<const TileEdit> edits)
+{
+	if (edits.empty())
+		return;
+
+	Vec2i area_min{ edits.front().position };
+	Vec2i area_max = area_min;
+	bool shape_changed = false;
+
+	for (auto& edit : edits) {
+		auto result = edit.tileset
+			? layer_data.placeTile(edit.position, edit.tile_id, *edit.tileset)
+			: layer_data.clearTile(edit.position);
+		applyTileChanges(world, result, edit.tileset);
+
+		shape_changed |= result.shape_changed;
+		area_min = Vec2i{ std::min(area_min.x, (int)edit.position.x), std::min(area_min.y, (int)edit.position.y) };
+		area_max = Vec2i{ std::max(area_max.x, (int)edit.position.x), std::max(area_max.y, (int)edit.position.y) };
+	}
+
+	// changed shapes reach the autotiles next to them
+	if (shape_changed) {
+		area_min -= Vec2i{ 1, 1 };
+		area_max += Vec2i{ 1, 1 };
+	}
+
+	std::vector<TileLayerData::TileChange> changes;
+	layer_data.solveAutotiles(Recti{ area_min, area_max - area_min + Vec2i{ 1, 1 } }, changes);
+	for (auto& change : changes) {
+		updateTile(
+            world,
+			change.position,
+            change.prev_tileset_ndx,
+			change.tileset);
+	}
+}
+
+void TileLayer::applyTileChanges(World& world, const TileLayerData::TileChangeResult& result, const TilesetAsset* tileset)
+{
     if (result.erased_tileset != TILEDATA_NONE) {
         auto it = dyn.chunks.begin() + result.erased_tileset;
         world.erase(*it);
         dyn.chunks.erase(it);
     }
-    if (result.created_tileset) {
+    if (result.created_tileset && tileset) {
         auto chunk = world.create<ChunkVertexArray>(entity_id, getSize(), kChunkSize);
-        chunk->setTexture(tileset.getTexture());
+        chunk->setTexture(tileset->getTexture(), tileset->getTextureArea());
         chunk->use_visible_rect = true;
         dyn.chunks.push_back(chunk);
         world.system<AttachSystem>().create(world, attach_id, chunk);
@@ -443,25 +496,10 @@ void TileLayer::setTile(World& world, const Vec2u& position, TileID tile_id, con
 	}
 }
 
-void TileLayer::removeTile(World& world, const Vec2u& position) {
-	auto result = layer_data.removeTile(position);
-	if (result.erased_tileset != TILEDATA_NONE) {
-        auto it = dyn.chunks.begin() + result.erased_tileset;
-        world.erase(*it);
-		dyn.chunks.erase(it);
-	}
-	for (int i = 0; i < result.changes.count; i++) {
-		auto& change = result.changes.arr[i];
-		updateTile(
-            world,
-			change.position,
-            change.prev_tileset_ndx,
-			change.tileset);
-	}
-}
-
 void TileLayer::steal_tiles(World& w, TileLayer& from, Recti area) {
     Vec2i topleft{ area.left, area.top };
+    std::vector<TileEdit> placed;
+    std::vector<TileEdit> taken;
     for (auto x{area.left}; x < area.left + area.width; x++)
     {
         for (auto y{area.top}; y < area.top + area.height; y++)
@@ -470,18 +508,19 @@ void TileLayer::steal_tiles(World& w, TileLayer& from, Recti area) {
                 Vec2u p{ (unsigned)x, (unsigned)y };
                 if (auto tid = from.getTileBaseID(p))
                 {
-                    setTile(w, p - topleft, *tid, *from.getTileTileset(p));
-                    from.removeTile(w, p);
+                    placed.push_back({ p - topleft, *tid, from.getTileTileset(p) });
+                    taken.push_back({ p });
                 }
             }
         }
     }
+    setTiles(w, placed);
+    from.setTiles(w, taken);
 }
 
 void TileLayer::updateTile(World& world, const Vec2u& at, uint8_t prev_tileset_ndx, const TilesetAsset* next_tileset)
 {
-    uint8_t logic_ndx   = tiles_dyn[at].logic_id;
-    uint8_t timer_ndx   = tiles_dyn[at].timer_id;
+    auto [logic_ndx, timer_ndx] = getTileDynamic(at);
     auto& tile          = layer_data.getTileData()[at];
 
     // reset dynamic properties
@@ -490,12 +529,11 @@ void TileLayer::updateTile(World& world, const Vec2u& at, uint8_t prev_tileset_n
 	}
 	if (logic_ndx != TILEDATA_NONE) {
 		dyn.tile_logic.at(logic_ndx)->removeTile(at);
-		tiles_dyn[at].logic_id = TILEDATA_NONE;
 	}
     if (timer_ndx != TILEDATA_NONE) {
         dyn.timers.at(timer_ndx).tiles.erase(at);
-        tiles_dyn[at].timer_id = TILEDATA_NONE;
     }
+    tiles_dyn.erase(at);
 
     // setting to a tile that doesn't exist
 	if (!next_tileset || !next_tileset->getTile(tile.tile_id)) {
@@ -582,9 +620,12 @@ void TileLayer::shallow_copy(World& world, const TileLayer& src, Rectu src_area,
 
 	const auto& src_tiles = src.layer_data.getTileData();
 
-	for (const auto& tile : src_tiles.take_view(src_area.getPosition(), src_area.getSize()))
+	auto src_view = src_tiles.take_view(src_area.getPosition(), src_area.getSize());
+	std::vector<TileEdit> edits;
+	for (auto tile_it = src_view.cbegin(); tile_it != src_view.cend(); ++tile_it)
 	{
-		if (!tile.has_tile)
+		const auto& tile = *tile_it;
+		if (!tile.has_tile())
 			continue;
 
 		const TilesetAsset* tileset = nullptr;
@@ -596,15 +637,17 @@ void TileLayer::shallow_copy(World& world, const TileLayer& src, Rectu src_area,
 		}
 
 		TileID tex_pos = tile.tile_id;
-		setTile(world, tile.pos - dst, tex_pos, *tileset);
+		Vec2u tile_pos = src_area.getPosition() + Vec2u{ (unsigned)tile_it.column(), (unsigned)tile_it.row() };
+		edits.push_back({ tile_pos - dst, tex_pos, tileset });
 	}
+	setTiles(world, edits);
 }
 
 
 bool TileLayer::hasTileAt(Vec2u tile_pos) const
 {
 	if (tile_pos.x < getLevelSize().x && tile_pos.y < getLevelSize().y) {
-		return layer_data.getTileData()[tile_pos].has_tile;
+		return layer_data.getTileData()[tile_pos].has_tile();
 	}
 	return false;
 }
@@ -620,7 +663,7 @@ std::optional<TileID> TileLayer::getTileID(Vec2u tile_pos) const
 std::optional<TileID> TileLayer::getTileBaseID(Vec2u tile_pos) const
 {
 	if (hasTileAt(tile_pos)) {
-		return layer_data.getTileData()[tile_pos].base_id;
+		return layer_data.getBaseID(layer_data.getTileData()[tile_pos]);
 	}
 	return std::nullopt;
 }
@@ -636,7 +679,7 @@ const TilesetAsset* TileLayer::getTileTileset(Vec2u tile_pos) const
 bool TileLayer::isTileAuto(Vec2u tile_pos) const
 {
 	if (hasTileAt(tile_pos)) {
-		return layer_data.getTileData()[tile_pos].is_autotile;
+		return layer_data.getTileData()[tile_pos].is_autotile();
 	}
 	return false;
 }
@@ -678,7 +721,7 @@ TileID TileLayer::getDisplayTileID(Vec2u tile_pos, TileID id)
     if (!hasTileAt(tile_pos))
         return id;
 
-    auto& data = tiles_dyn.at(tile_pos);
+    auto data = getTileDynamic(tile_pos);
     if (data.timer_id == TILEDATA_NONE) {
         return id;
     }
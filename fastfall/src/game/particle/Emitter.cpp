@@ -78,41 +78,6 @@ void Emitter::update(secs deltaTime, event_out_iter* events_out) {
         update_particles(deltaTime);
         spawn_particles(deltaTime);
         update_bounds();
-
-        if (debug::enabled(debug::Emitter)) {
-
-            if (particle_bounds) {
-                auto p_bounds = debug::draw(
-                        (const void *) this, Primitive::LINE_LOOP, 4);
-
-                for (int i = 0; i < p_bounds.size(); i++) {
-                    p_bounds[i].color = Color::Red;
-                }
-                p_bounds[0].pos = math::rect_topleft(*particle_bounds);
-                p_bounds[1].pos = math::rect_topright(*particle_bounds);
-                p_bounds[2].pos = math::rect_botright(*particle_bounds);
-                p_bounds[3].pos = math::rect_botleft(*particle_bounds);
-            }
-
-
-            auto part_points = debug::draw(
-                    (const void*)this, Primitive::LINES, particles.size() * 4);
-
-            size_t ndx = 0;
-            for (auto& p : particles) {
-                part_points[ndx + 0].color = Color::Red;
-                part_points[ndx + 1].color = Color::Red;
-                part_points[ndx + 2].color = Color::Red;
-                part_points[ndx + 3].color = Color::Red;
-
-                part_points[ndx + 0].pos = p.position + Vec2f{ -1.f,  0.f };
-                part_points[ndx + 1].pos = p.position + Vec2f{  1.f,  0.f };
-                part_points[ndx + 2].pos = p.position + Vec2f{  0.f, -1.f };
-                part_points[ndx + 3].pos = p.position + Vec2f{  0.f,  1.f };
-
-                ndx += 4;
-            }
-        }
     }
 }
 
@@ -129,6 +94,7 @@ void Emitter::predraw(VertexArray& varr, SceneConfig& cfg, predraw_state_t predr
         auto invSize = cfg.rstate.texture.get()->inverseSize();
 
         Vec2f spr_size = Vec2f{ anim->area.getSize() } * 0.5f;
+        Recti tex_area = anim->get_texture_area();
 
         Vec2f inter_pos = prev_position + (position - prev_position) * predraw_state.interp;
 
@@ -176,7 +142,7 @@ void Emitter::predraw(VertexArray& varr, SceneConfig& cfg, predraw_state_t predr
 
             size_t frame = floor((float)(anim->framerateMS.size()) * (float)(exact_lifetime / strategy.max_lifetime));
 
-            auto area = anim->area;
+            auto area = tex_area;
             area.left += frame * area.width;
 
             auto points = Rectf{ area }.toPoints();
@@ -402,25 +368,11 @@ void Emitter::apply_collision(const poly_id_map<ColliderRegion>& colliders, even
     }
 
 
-    for (const auto [rid, region] : colliders) {
-        auto quad_area = region->in_rect(*get_particle_bounds());
-
-        if (debug::enabled(debug::Emitter)) {
-            auto it = quad_area.begin();
-            Rectf r_bounds = math::shift(Rectf{ it.get_tile_area() } * TILESIZE, region->getPosition());
-
-            auto p_bounds = debug::draw(Primitive::LINE_LOOP, 4);
+    // apply_collision may run on a worker thread
+    static thread_local std::vector<ColliderRegion::quad_iter> quad_buffer;
 
-            for (auto & p_bound : p_bounds) {
-                p_bound.color = Color::White;
-            }
-            p_bounds[0].pos = math::rect_topleft(r_bounds);
-            p_bounds[1].pos = math::rect_topright(r_bounds);
-            p_bounds[2].pos = math::rect_botright(r_bounds);
-            p_bounds[3].pos = math::rect_botleft(r_bounds);
-        }
-
-        for (auto quad : quad_area) {
+    for (const auto [rid, region] : colliders) {
+        for (auto quad : region->quads_in_rect(*get_particle_bounds(), quad_buffer)) {
             if (!quad->hasAnySurface() /* || quad.hasOneWay */ )
                 continue;
 
@@ -431,18 +383,6 @@ void Emitter::apply_collision(const poly_id_map<ColliderRegion>& colliders, even
 
             *bounds = math::shift(*bounds, region->getPosition());
 
-            if (debug::enabled(debug::Emitter)) {
-                auto q_bounds = debug::draw(Primitive::LINE_LOOP, 4);
-
-                for (auto & q_bound : q_bounds) {
-                    q_bound.color = Color::Green;
-                }
-                q_bounds[0].pos = math::rect_topleft(*bounds);
-                q_bounds[1].pos = math::rect_topright(*bounds);
-                q_bounds[2].pos = math::rect_botright(*bounds);
-                q_bounds[3].pos = math::rect_botleft(*bounds);
-            }
-
             std::for_each(
                 particles.begin(),
                 particles.end(),
@@ -466,6 +406,84 @@ void Emitter::apply_collision(const poly_id_map<ColliderRegion>& colliders, even
     }
 }
 
+void Emitter::debug_draw(const poly_id_map<ColliderRegion>& colliders) const {
+    if (!debug::enabled(debug::Emitter))
+        return;
+
+    if (particle_bounds) {
+        auto p_bounds = debug::draw(
+                (const void *) this, Primitive::LINE_LOOP, 4);
+
+        for (int i = 0; i < p_bounds.size(); i++) {
+            p_bounds[i].color = Color::Red;
+        }
+        p_bounds[0].pos = math::rect_topleft(*particle_bounds);
+        p_bounds[1].pos = math::rect_topright(*particle_bounds);
+        p_bounds[2].pos = math::rect_botright(*particle_bounds);
+        p_bounds[3].pos = math::rect_botleft(*particle_bounds);
+    }
+
+    auto part_points = debug::draw(
+            (const void*)this, Primitive::LINES, particles.size() * 4);
+
+    size_t ndx = 0;
+    for (auto& p : particles) {
+        part_points[ndx + 0].color = Color::Red;
+        part_points[ndx + 1].color = Color::Red;
+        part_points[ndx + 2].color = Color::Red;
+        part_points[ndx + 3].color = Color::Red;
+
+        part_points[ndx + 0].pos = p.position + Vec2f{ -1.f,  0.f };
+        part_points[ndx + 1].pos = p.position + Vec2f{  1.f,  0.f };
+        part_points[ndx + 2].pos = p.position + Vec2f{  0.f, -1.f };
+        part_points[ndx + 3].pos = p.position + Vec2f{  0.f,  1.f };
+
+        ndx += 4;
+    }
+
+    if (!strategy.collision_enabled || !particle_bounds)
+        return;
+
+    for (const auto [rid, region] : colliders) {
+        auto quad_area = region->in_rect(*particle_bounds);
+
+        auto it = quad_area.begin();
+        Rectf r_bounds = math::shift(Rectf{ it.get_tile_area() } * TILESIZE, region->getPosition());
+
+        auto r_points = debug::draw(Primitive::LINE_LOOP, 4);
+
+        for (auto & r_point : r_points) {
+            r_point.color = Color::White;
+        }
+        r_points[0].pos = math::rect_topleft(r_bounds);
+        r_points[1].pos = math::rect_topright(r_bounds);
+        r_points[2].pos = math::rect_botright(r_bounds);
+        r_points[3].pos = math::rect_botleft(r_bounds);
+
+        for (auto quad : quad_area) {
+            if (!quad->hasAnySurface())
+                continue;
+
+            auto bounds = quad->get_bounds();
+
+            if (!bounds)
+                continue;
+
+            *bounds = math::shift(*bounds, region->getPosition());
+
+            auto q_bounds = debug::draw(Primitive::LINE_LOOP, 4);
+
+            for (auto & q_bound : q_bounds) {
+                q_bound.color = Color::Green;
+            }
+            q_bounds[0].pos = math::rect_topleft(*bounds);
+            q_bounds[1].pos = math::rect_topright(*bounds);
+            q_bounds[2].pos = math::rect_botright(*bounds);
+            q_bounds[3].pos = math::rect_botleft(*bounds);
+        }
+    }
+}
+
 void imgui_component(World& w, ID<Emitter> id) {
     // TODO
     auto& cmp = w.at(id);
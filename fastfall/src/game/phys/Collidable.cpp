@@ -428,9 +428,9 @@ bool Collidable::has_contact(Cardinal dir) const noexcept {
 
 void Collidable::set_frame(
         poly_id_map<ColliderRegion>* colliders,
-        std::vector<AppliedContact>&& curr_frame)
+        std::vector<AppliedContact>& curr_frame)
 {
-	currContacts = std::move(curr_frame);
+	std::swap(currContacts, curr_frame);
 
     // process contacts
     col_state.reset();
@@ -542,6 +542,7 @@ void Collidable::add_decel(float deceleration) { decel += deceleration; };
 
 Vec2f Collidable::get_friction()   const noexcept { return friction; };
 Vec2f Collidable::get_accel() const noexcept { return accel; };
+float Collidable::get_decel() const noexcept { return decel; };
 
 void imgui_component(World& w, ID<Collidable> id) {
     auto& col = w.at(id);
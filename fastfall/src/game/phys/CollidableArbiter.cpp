@@ -4,7 +4,7 @@
 #include "fastfall/util/id_map.hpp"
 #include "fastfall/game/World.hpp"
 
-#include "nlohmann/json.hpp"
+#include "fastfall/game/phys/collision/CollisionTrace.hpp"
 
 #include "tracy/Tracy.hpp"
 
@@ -29,34 +29,28 @@ namespace ff {
 	void CollidableArbiter::gather_collisions(
             World& world,
 			secs deltaTime,
-			nlohmann::ordered_json* dump_ptr)
+			CollisionTrace* tracer)
 	{
         ZoneScoped;
 
         auto& collidable = world.at(collidable_id);
 
-		if (dump_ptr) {
-			(*dump_ptr)["collidable"] = {
-				{ "id",			collidable_id.raw() },
-				{ "pos",		fmt::format("{}", collidable.getPosition()) },
-				{ "delta_pos",	fmt::format("{}", collidable.getPosition() - collidable.getPrevPosition()) },
-				{ "localvel",		fmt::format("{}", collidable.get_local_vel()) },
-                { "parentvel",		fmt::format("{}", collidable.get_parent_vel()) },
-                { "globalvel",		fmt::format("{}", collidable.get_global_vel()) },
-				{ "size",		fmt::format("{}", Vec2f{collidable.getBox().getSize()}) },
-			};
-
-            if (auto& track = collidable.tracker()) {
-                bool has_id = track->has_contact() && track->get_contact()->id;
-                (*dump_ptr)["collidable"]["tracker"] = {
-                    { "has_contact", track->has_contact() },
-                    { "collider_id", (has_id ? track->get_contact()->id->collider.raw() : 0) },
-                    { "quad_id",     (has_id ? track->get_contact()->id->quad.value : 0) }
-                };
-            }
-            else {
-                (*dump_ptr)["collidable"]["tracker"];
-            }
+		if (tracer) {
+            auto& track = collidable.tracker();
+            bool has_id = track && track->has_contact() && track->get_contact()->id;
+			tracer->record(trace::collidable_t{
+				.id                  = collidable_id.raw(),
+				.pos                 = trace::to_trace(collidable.getPosition()),
+				.delta_pos           = trace::to_trace(collidable.getPosition() - collidable.getPrevPosition()),
+				.local_vel           = trace::to_trace(collidable.get_local_vel()),
+				.parent_vel          = trace::to_trace(collidable.get_parent_vel()),
+				.global_vel          = trace::to_trace(collidable.get_global_vel()),
+				.size                = trace::to_trace(Vec2f{ collidable.getBox().getSize() }),
+				.has_tracker         = track.has_value(),
+				.tracker_has_contact = track && track->has_contact(),
+				.tracker_collider    = has_id ? track->get_contact()->id->collider.raw() : 0u,
+				.tracker_quad        = has_id ? track->get_contact()->id->quad.value : 0,
+			});
 		}
 
 		std::set<const Arbiter*> updatedBuffer;
@@ -101,29 +95,22 @@ namespace ff {
 
 		} while (body_bound != push_bound);
 
-		if (dump_ptr) 
+		if (tracer)
 		{
-			(*dump_ptr)["broad_phase"]["init_bounds"] = {
-				{"pos",  fmt::format("{}", Vec2f{collidable.getBoundingBox().getPosition()}) },
-				{"size", fmt::format("{}", Vec2f{collidable.getBoundingBox().getSize()}) },
-			};
-
-			(*dump_ptr)["broad_phase"]["final_bounds"] = {
-				{"pos",  fmt::format("{}", Vec2f{body_bound.getPosition()}) },
-				{"size", fmt::format("{}", Vec2f{body_bound.getSize()}) },
-			};
+			tracer->record(trace::broad_phase_t{
+				.init_bounds  = trace::to_trace(collidable.getBoundingBox()),
+				.final_bounds = trace::to_trace(body_bound),
+			});
 
-			size_t region_count = 0;
 			for (auto& [rid, rarb] : region_arbiters) {
                 ColliderRegion* region = world.get(rid);
-				(*dump_ptr)["broad_phase"]["colliders"][region_count] = {
-					{ "id",				rid.raw() },
-					{ "vel",			fmt::format("{}", region->velocity) },
-                    { "position",       fmt::format("{}", region->getPosition()) },
-					{ "delta_pos",		fmt::format("{}", region->getPosition() - region->getPrevPosition()) },
-					{ "arbiter_count",	rarb.getQuadArbiters().size()},
-				};
-				region_count++;
+				tracer->record(trace::broad_collider_t{
+					.id            = rid.raw(),
+					.vel           = trace::to_trace(region->velocity),
+					.pos           = trace::to_trace(region->getPosition()),
+					.delta_pos     = trace::to_trace(region->getPosition() - region->getPrevPosition()),
+					.arbiter_count = (uint32_t)rarb.getQuadArbiters().size(),
+				});
 			}
 		}
 	}
@@ -189,13 +176,15 @@ namespace ff {
 
 	void CollidableArbiter::solve_collisions(
             World& world,
+            CollisionSolver& solver,
+            std::vector<AppliedContact>& contact_buffer,
             secs deltaTime,
-            nlohmann::ordered_json* dump_ptr)
+            CollisionTrace* tracer)
 	{
         ZoneScoped;
         auto& colliders = world.all<ColliderRegion>();
         auto& collidable = world.at(collidable_id);
-		CollisionSolver solver{ &colliders, &collidable };
+		solver.reset(&colliders, &collidable);
 
 		for (auto& [rid, rarb] : region_arbiters) {
 
@@ -210,12 +199,11 @@ namespace ff {
 			}
 		}
 
-		nlohmann::ordered_json* json_dump = nullptr;
-		if (dump_ptr) {
-			json_dump = &(*dump_ptr)["solver"];
+		if (tracer) {
+			tracer->record_section(trace::section::Solver);
 		}
 
-        auto frame = solver.solve(json_dump);
+        auto frame = solver.solve(contact_buffer, tracer);
 
         for (auto& contact : frame) {
             if (contact.id) {
@@ -225,10 +213,79 @@ namespace ff {
             }
         }
 
-        collidable.set_frame(&colliders, std::move(frame));
+        collidable.set_frame(&colliders, contact_buffer);
 
         if (collidable.callbacks.onPostCollision)
             collidable.callbacks.onPostCollision(world);
 	}
 
+	bool CollidableRest::prepare(const Collidable& collidable, std::span<const Rectf> disturbed_areas)
+	{
+		idle_input = collidable.get_accel() == Vec2f{} && collidable.get_decel() == 0.f;
+
+		// pad by a pixel, resting contacts only touch the collidable's edge
+		Rectf bounds = collidable.getBoundingBox();
+		bounds = Rectf(bounds.left - 1.f, bounds.top - 1.f, bounds.width + 2.f, bounds.height + 2.f);
+
+		disturbed = std::any_of(disturbed_areas.begin(), disturbed_areas.end(),
+			[&](const Rectf& area) { return area.intersects(bounds); });
+
+		// anything changed since the last tick, velocity set, teleported, pushed by an actor
+		if (asleep && (!idle_input || disturbed || take_snapshot(collidable) != last)) {
+			wake();
+		}
+		return asleep;
+	}
+
+	void CollidableRest::update(const Collidable& collidable)
+	{
+		snapshot_t snapshot = take_snapshot(collidable);
+
+		// the same state twice with the same input means the next tick would just repeat it
+		bool at_rest = idle_input && !disturbed && snapshot == last;
+
+		rest_ticks = at_rest ? rest_ticks + 1 : 0;
+		asleep = rest_ticks >= sleep_ticks;
+		last = snapshot;
+	}
+
+	void CollidableRest::sleep(World& world, Collidable& collidable, secs deltaTime) const
+	{
+		if (auto& track = collidable.tracker()) {
+			track->update_timers(deltaTime);
+		}
+
+		for (auto& contact : collidable.get_contacts()) {
+			if (contact.id) {
+				if (auto* collider = world.get(contact.id->collider)) {
+					collider->on_postcontact(world, contact, deltaTime);
+				}
+			}
+		}
+
+		if (collidable.callbacks.onPostCollision)
+			collidable.callbacks.onPostCollision(world);
+	}
+
+	void CollidableRest::wake()
+	{
+		rest_ticks = 0;
+		asleep = false;
+	}
+
+	CollidableRest::snapshot_t CollidableRest::take_snapshot(const Collidable& collidable)
+	{
+		return {
+			.pos            = collidable.getPosition(),
+			.size           = Vec2f{ collidable.getBox().getSize() },
+			.local_vel      = collidable.get_local_vel(),
+			.parent_vel     = collidable.get_parent_vel(),
+			.surface_vel    = collidable.get_surface_vel(),
+			.friction       = collidable.get_friction(),
+			.gravity        = collidable.get_gravity(),
+			.contact_count  = collidable.get_contacts().size(),
+			.has_tracker    = collidable.tracker().has_value(),
+		};
+	}
+
 }
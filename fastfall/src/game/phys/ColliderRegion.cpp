@@ -4,6 +4,8 @@
 
 #include "imgui.h"
 
+#include <utility>
+
 namespace ff {
 
 ColliderRegion::ColliderRegion(Vec2i initialPosition)
@@ -54,6 +56,10 @@ Vec2f ColliderRegion::getDeltaPosition() const noexcept {
 }
 
 void ColliderRegion::teleport(Vec2f pos) {
+    if (pos != position) {
+        markChanged(getSweptBoundingBox());
+        markChanged(Rectf(Vec2f(boundingBox.getPosition()) + pos, Vec2f(boundingBox.getSize())));
+    }
     prevPosition = pos;
     position = pos;
 }
@@ -76,6 +82,14 @@ Rectf ColliderRegion::getSweptBoundingBox() const noexcept {
     return math::rect_bound(prevB, currB);
 }
 
+std::optional<Rectf> ColliderRegion::takeChangedArea() noexcept {
+    return std::exchange(changedArea, std::nullopt);
+}
+
+void ColliderRegion::markChanged(Rectf area) noexcept {
+    changedArea = changedArea ? math::rect_bound(*changedArea, area) : area;
+}
+
 void imgui_component(World& w, ID<ColliderRegion> id) {
     auto& col = w.at(id);
     ImGui::Text("Curr Position:  %3.2f, %3.2f",     col.getPosition().x, col.getPosition().y);
@@ -95,6 +109,26 @@ void imgui_component(World& w, ID<ColliderRegion> id) {
     }
 }
 
+std::span<const ColliderRegion::quad_iter> ColliderRegion::quads_in_rect(Rectf area, std::vector<quad_iter>& buffer) const {
+    buffer.resize(buffer.capacity());
+    size_t count = collect_quads(area, buffer);
+    if (count > buffer.size()) {
+        buffer.resize(count);
+        count = collect_quads(area, buffer);
+    }
+    return { buffer.data(), count };
+}
+
+std::span<const ColliderRegion::quad_iter> ColliderRegion::quads_in_line(Linef line, std::vector<quad_iter>& buffer, bool skip_empty) const {
+    buffer.resize(buffer.capacity());
+    size_t count = collect_quads(line, buffer, skip_empty);
+    if (count > buffer.size()) {
+        buffer.resize(count);
+        count = collect_quads(line, buffer, skip_empty);
+    }
+    return { buffer.data(), count };
+}
+
 ColliderRegion::QuadAreaIterator& ColliderRegion::QuadAreaIterator::operator++() {
     curr_quad = region->next_quad_in_rect(area, *curr_quad, tile_area, skip_empty);
 
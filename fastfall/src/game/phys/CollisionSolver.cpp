@@ -5,72 +5,36 @@
 #include "fastfall/util/math.hpp"
 #include "fastfall/util/log.hpp"
 
-#include "nlohmann/json.hpp"
+#include "fastfall/game/phys/collision/CollisionTrace.hpp"
 
 #include "tracy/Tracy.hpp"
 
 namespace ff 
 {
 
-// json helper utils
-
-NLOHMANN_JSON_SERIALIZE_ENUM(ContactType, {
-	{ContactType::NO_SOLUTION,		"no solution"},
-	{ContactType::SINGLE,			"single"},
-	{ContactType::WEDGE,			"wedge"},
-	{ContactType::CRUSH_HORIZONTAL,	"horizontal crush"},
-	{ContactType::CRUSH_VERTICAL,	"vertical crush"},
-	})
+// solver utils
 
-nlohmann::ordered_json to_json(const ContinuousContact* contact)
+Arbiter* CollisionSolver::findArbiter(const std::optional<CollisionID>& id)
 {
-	//const auto* arb = contact->arbiter;
-    auto id = contact->id;
-	return {
-		{"contact",			fmt::format("{}", fmt::ptr(contact)) },
-		{"hasContact",		contact->hasContact},
-		{"separation",		contact->separation},
-        {"surface",	        fmt::format("{} -> {}", contact->collider.surface.p1, contact->collider.surface.p2)},
-		{"ortho_n",			fmt::format("{}", contact->ortho_n)},
-		{"collider_n",		fmt::format("{}", contact->collider_n)},
-		{"hasImpactTime",	contact->hasImpactTime},
-		{"impactTime",		contact->impactTime},
-		{"velocity",		fmt::format("{}", contact->velocity)},
-		{"is_transposed",	contact->is_transposed},
-        {"collidable",		id ? id->collidable.raw() : 0u },
-		{"region",			id ? id->collider.raw() : 0u },
-		{"quad",			id ? id->quad.value : 0u },
-        {"stick_offset",    contact->stickOffset},
-        {"stick_line",      fmt::format("{} -> {}", contact->stickLine.p1, contact->stickLine.p2)},
-    };
-}
+	if (!id)
+		return nullptr;
 
-template<typename Container>
-requires std::same_as<typename Container::value_type, ContinuousContact*>
-nlohmann::ordered_json to_json(Container container)
-{
-	nlohmann::ordered_json json;
-	for (const ContinuousContact* c : container)
-	{
-		json += fmt::format("{}", fmt::ptr(c));
-	}
-	return json;
+	auto it = std::lower_bound(arbiters.begin(), arbiters.end(), *id,
+		[](const auto& entry, const CollisionID& cid) { return entry.first < cid; });
+	return (it != arbiters.end() && !(*id < it->first)) ? it->second : nullptr;
 }
 
-// solver utils
-
 void CollisionSolver::updateContact(ContinuousContact* contact)
 {
-    auto arb = contact->id ? arbiters.find(*contact->id) : arbiters.end();
-	if (arb != arbiters.end()) {
-        arb->second->update({
+	if (auto* arb = findArbiter(contact->id)) {
+        arb->update({
                 .collider = colliders->get(contact->id->collider),
                 .collidable = collidable
         }, 0.0);
 	}
 }
 
-void CollisionSolver::updateStack(std::deque<ContinuousContact*>& stack) {
+void CollisionSolver::updateStack(ContactStack& stack) {
 	std::for_each(stack.begin(), stack.end(), std::bind(&CollisionSolver::updateContact, this, std::placeholders::_1));
 }
 
@@ -234,7 +198,26 @@ CollisionSolver::CollisionSolver(poly_id_map<ColliderRegion>* _colliders, Collid
 {
 }
 
-bool CollisionSolver::applyThenUpdateStacks(std::deque<ContinuousContact*>& stack, std::deque<ContinuousContact*>& otherStack, bool which)
+void CollisionSolver::reset(poly_id_map<ColliderRegion>* _colliders, Collidable* _collidable)
+{
+	collidable = _collidable;
+	colliders = _colliders;
+
+	north.clear();
+	south.clear();
+	east.clear();
+	west.clear();
+	north_alt.clear();
+	south_alt.clear();
+
+	arbiters.clear();
+	contacts.clear();
+	created_contacts.clear();
+	tracer = nullptr;
+	frame = nullptr;
+}
+
+bool CollisionSolver::applyThenUpdateStacks(ContactStack& stack, ContactStack& otherStack, bool which)
 {
 	bool applied = applyFirst(which ? stack : otherStack);
 	if (applied) {
@@ -244,16 +227,14 @@ bool CollisionSolver::applyThenUpdateStacks(std::deque<ContinuousContact*>& stac
 	return applied;
 };
 
-bool CollisionSolver::canApplyElseDiscard(bool discard, std::deque<ContinuousContact*>& stack)
+bool CollisionSolver::canApplyElseDiscard(bool discard, ContactStack& stack)
 {
 	if (discard)
 	{
-		if (json_dump) {
-			(*json_dump)["apply"] += {
-				{ "discard_nocontact", fmt::format("{}", fmt::ptr(stack.front())) }
-			};
+		if (tracer) {
+			tracer->record_event(trace::event::DiscardNoContact, stack.front());
 		}
-		stack.pop_front();
+		stack.erase(stack.begin());
 	}
 	return !discard;
 };
@@ -262,10 +243,8 @@ void CollisionSolver::pushToAStack(ContinuousContact* contact)
 {
 	auto dir = direction::from_vector(contact->ortho_n);
 	if (!dir.has_value()) {
-		if (json_dump) {
-			(*json_dump)["apply"] += {
-				{ "discard_nodir", fmt::format("{}", fmt::ptr(contact)) }
-			};
+		if (tracer) {
+			tracer->record_event(trace::event::DiscardNoDir, contact);
 		}
 	}
 	else {
@@ -396,23 +375,19 @@ void CollisionSolver::compareAll()
 {
     ZoneScoped;
 
-	size_t cmp_count = 0;
 	for (size_t i = 0; i < contacts.size() - 1; i++) {
 		for (size_t j = i + 1; j < contacts.size(); ) {
 
 			CompResult result = compare(contacts.at(i), contacts.at(j));
 
-			if (json_dump)
+			if (tracer)
 			{
-				(*json_dump)["compare"][cmp_count] = {
-					{"first",  fmt::format("{}", fmt::ptr(&contacts.at(i))) },
-					{"second", fmt::format("{}", fmt::ptr(&contacts.at(j))) },
-					{"result", {
-							{"first",  (result.discardFirst ? "discard" : "keep")},
-							{"second", (result.discardSecond ? "discard" : "keep")}
-						}
-					}
-				};
+				tracer->record(trace::compare_t{
+					.first          = trace::to_handle(contacts.at(i)),
+					.second         = trace::to_handle(contacts.at(j)),
+					.discard_first  = result.discardFirst,
+					.discard_second = result.discardSecond
+				});
 			}
 
 			if (result.discardFirst) {
@@ -426,7 +401,6 @@ void CollisionSolver::compareAll()
 			else {
 				j++;
 			}
-			cmp_count++;
 		}
 	}
 
@@ -471,13 +445,10 @@ std::optional<ContinuousContact> CollisionSolver::detectWedge(const ContinuousCo
                     math::shift(ceilLine, -south->velocity))
             };
 
-			if (json_dump)
+			if (tracer)
 			{
-				(*json_dump)["wedges"] += {
-					{"north", fmt::format("{}", fmt::ptr(north)) },
-					{"south", fmt::format("{}", fmt::ptr(south)) },
-					{"created_contact", to_json(&*contact)}
-				};
+				tracer->record_event(trace::event::WedgeFrom, north, south);
+				tracer->record_contact(trace::contact_stage::Wedge, *contact);
 			}
 		}
 	}
@@ -486,6 +457,8 @@ std::optional<ContinuousContact> CollisionSolver::detectWedge(const ContinuousCo
 
 void CollisionSolver::detectWedges() {
     ZoneScoped;
+	created_contacts.clear();
+	created_contacts.reserve(north.size() * south.size());
 	for (const auto* north_arb : north)
 	{
 		for (const auto* south_arb : south)
@@ -502,35 +475,39 @@ void CollisionSolver::detectWedges() {
 	}
 }
 
-std::vector<AppliedContact>&& CollisionSolver::solve(nlohmann::ordered_json* dump_ptr)
+std::span<const AppliedContact> CollisionSolver::solve(std::vector<AppliedContact>& out, CollisionTrace* trace_ptr)
 {
     ZoneScoped;
-	frame.clear();
+	out.clear();
+	frame = &out;
 
-	json_dump = dump_ptr;
+	tracer = trace_ptr;
 
     //std::transform(contacts);
 
 	if (contacts.empty())
-		return std::move(frame);
+		return out;
+
+	std::sort(arbiters.begin(), arbiters.end(),
+		[](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
 
-	if (json_dump)
+	if (tracer)
 	{
 		for (auto* contact : contacts) {
-			(*json_dump)["precompare"] += to_json(contact);
+			tracer->record_contact(trace::contact_stage::Precompare, *contact);
 		}
-		(*json_dump)["compare"];
+		tracer->record_section(trace::section::Compare);
 	}
 
 	// do contact-to-contact comparisons 
 	// try to discard some redundant ones early
 	compareAll();
 
-	if (json_dump)
+	if (tracer)
 	{
 		for (auto* contact : contacts)
 		{
-			(*json_dump)["postcompare"] += to_json(contact);
+			tracer->record_contact(trace::contact_stage::Postcompare, *contact);
 		}
 	}
 
@@ -545,8 +522,8 @@ std::vector<AppliedContact>&& CollisionSolver::solve(nlohmann::ordered_json* dum
 	// a wedge is any pair of north/south contacts that would force the collision box east/west instead
 	detectWedges();
 
-	if (json_dump)
-		(*json_dump)["apply"];
+	if (tracer)
+		tracer->record_section(trace::section::Apply);
 
 	// opportunistically determine if we can solve steeper slopes on the X axis instead of Y (looks nicer)
 	if (canApplyAlt()) 
@@ -573,14 +550,10 @@ std::vector<AppliedContact>&& CollisionSolver::solve(nlohmann::ordered_json* dum
 	std::sort(east.begin(), east.end(), cmp_contact_ptrs);
 	std::sort(west.begin(), west.end(), cmp_contact_ptrs);
 
-	if (json_dump) {
-		(*json_dump)["apply"] += {
-			{"x_stack", {
-					{"east", to_json(east) },
-					{"west", to_json(west) },
-				}
-			}
-		};
+	if (tracer) {
+		tracer->record_section(trace::section::XStack);
+		tracer->record_stack(trace::stack_side::East, east);
+		tracer->record_stack(trace::stack_side::West, west);
 	}
 
 	// solve X axis
@@ -595,23 +568,19 @@ std::vector<AppliedContact>&& CollisionSolver::solve(nlohmann::ordered_json* dum
 	std::sort(north.begin(), north.end(), cmp_contact_ptrs);
 	std::sort(south.begin(), south.end(), cmp_contact_ptrs);
 
-	if (json_dump) {
-		(*json_dump)["apply"] += {
-			{"y_stack", {
-					{"north", to_json(north) },
-					{"south", to_json(south) },
-				}
-			}
-		};
+	if (tracer) {
+		tracer->record_section(trace::section::YStack);
+		tracer->record_stack(trace::stack_side::North, north);
+		tracer->record_stack(trace::stack_side::South, south);
 	}
 
 	// solve Y axis
 	solveAxis(north, south, pickV);
 
-	return std::move(frame);
+	return out;
 }
 
-bool CollisionSolver::solveAxis(std::deque<ContinuousContact*>& stackA, std::deque<ContinuousContact*>& stackB, PickerFn picker)
+bool CollisionSolver::solveAxis(ContactStack& stackA, ContactStack& stackB, PickerFn picker)
 {
     ZoneScoped;
 	bool any_applied = false;
@@ -620,14 +589,8 @@ bool CollisionSolver::solveAxis(std::deque<ContinuousContact*>& stackA, std::deq
 		auto aC = stackA.front();
 		auto bC = stackB.front();
 
-		if (json_dump) {
-			(*json_dump)["apply"] +=
-			{
-				{ "picking_from", {
-					fmt::format("{}", fmt::ptr(aC)),
-					fmt::format("{}", fmt::ptr(bC))
-				}}
-			};
+		if (tracer) {
+			tracer->record_event(trace::event::PickingFrom, aC, bC);
 		}
 
 		auto r = picker(aC, bC, collidable);
@@ -674,7 +637,7 @@ bool CollisionSolver::solveAxis(std::deque<ContinuousContact*>& stackA, std::deq
 
 // ----------------------------------------------------------------------------
 
-bool CollisionSolver::applyStack(std::deque<ContinuousContact*>& stack) {
+bool CollisionSolver::applyStack(ContactStack& stack) {
 	bool any_applied = false;
 	while (!stack.empty()) {
 		if (applyFirst(stack))
@@ -686,12 +649,12 @@ bool CollisionSolver::applyStack(std::deque<ContinuousContact*>& stack) {
 	return any_applied;
 }
 
-bool CollisionSolver::applyFirst(std::deque<ContinuousContact*>& stack) {
+bool CollisionSolver::applyFirst(ContactStack& stack) {
 	if (stack.empty())
 		return false;
 
 	// if there are multiple arbiters with the same sep, prefer the one closest to the collidable's center
-	std::deque<ContinuousContact*>::iterator pick = stack.begin();
+	ContactStack::iterator pick = stack.begin();
 	if (stack.size() > 1) 
 	{
 		float sep = (*pick)->separation;
@@ -753,9 +716,8 @@ bool CollisionSolver::apply(const ContinuousContact& contact, ContactType type)
 	bool has_contact = contact.hasContact;
 	if (contact.hasContact) 
 	{
-		if (json_dump) {
-			(*json_dump)["apply"] += to_json(&contact);
-			(*json_dump)["apply"].back()["type"] = type;
+		if (tracer) {
+			tracer->record_contact(trace::contact_stage::Applied, contact, type);
 		}
 
         Vec2f prevel = collidable->get_global_vel();
@@ -766,22 +728,19 @@ bool CollisionSolver::apply(const ContinuousContact& contact, ContactType type)
         //LOG_INFO("{}", applied.collidable_precontact_velocity);
 		applied.type = type;
 
-        auto arb = contact.id ? arbiters.find(*contact.id) : arbiters.end();
-		if (arb != arbiters.end()) {
-			arb->second->setApplied();
-			arb->second->update({
+		if (auto* arb = findArbiter(contact.id)) {
+			arb->setApplied();
+			arb->update({
                 .collider = colliders->get(contact.id->collider),
                 .collidable = collidable
             }, 0.0);
 		}
 
-		frame.push_back(applied);
+		frame->push_back(applied);
 	}
 	else {
-		if (json_dump) {
-			(*json_dump)["apply"] += {
-				{ "discard_apply", fmt::format("{}", fmt::ptr(&contact)) }
-			};
+		if (tracer) {
+			tracer->record_event(trace::event::DiscardApply, &contact);
 		}
 	}
 	return has_contact;
@@ -226,14 +226,60 @@ std::optional<RaycastHit> raycast_quad_ortho(const ColliderRegion& region, const
 	return result;
 }
 
+// distance along the ray to where it enters area, 0 if it starts inside, none if it misses
+std::optional<float> raycast_entry_distance(const Rectf& area, const Linef& raycastLine) {
+	Vec2f dir = math::vector(raycastLine);
+	float enter = 0.f;
+	float leave = 1.f;
+
+	auto clip = [&](float pos, float d, float min, float max) {
+		if (d == 0.f)
+			return pos >= min && pos <= max;
+
+		float a = (min - pos) / d;
+		float b = (max - pos) / d;
+		if (a > b)
+			std::swap(a, b);
+
+		enter = std::max(enter, a);
+		leave = std::min(leave, b);
+		return enter <= leave;
+	};
+
+	if (clip(raycastLine.p1.x, dir.x, area.left, area.left + area.width)
+		&& clip(raycastLine.p1.y, dir.y, area.top, area.top + area.height))
+	{
+		return enter * math::dist(raycastLine);
+	}
+	return std::nullopt;
+}
+
 std::optional<RaycastHit> raycastRegion(const ColliderRegion& region, const Linef& raycastLine, float backoff, std::vector<Rectf>* visited) {
 
+	// stepped lazily, most rays hit one of the first few quads
 	std::optional<RaycastHit> result{};
 	for (auto quad : region.in_line( raycastLine, (visited == nullptr) )) {
 
+		Rectf area = region.tile_area(quad.id);
+		bool has_area = area.width > 0.f || area.height > 0.f;
+		area = math::shift(area, region.getPosition());
+
+		// quads come in order of where the ray enters their area, but areas may overlap (e.g. in a mesh)
+		// so a later quad can still be hit nearer, until one starts past the current hit
+		if (result) {
+			if (!has_area)
+				break;
+
+			auto entry = raycast_entry_distance(area, raycastLine);
+			if (!entry)
+				continue;
+			if (*entry >= result->distance)
+				break;
+		}
+
         if (visited) {
-            if (auto area = region.tile_area(quad.id); area.getArea() > 0) {
-                visited->push_back(math::shift(area, region.getPosition()));
+            if (area.getArea() > 0) {
+                visited->push_back(area);
             }
 
             if (!quad.ptr)
@@ -241,9 +287,6 @@ std::optional<RaycastHit> raycastRegion(const ColliderRegion& region, const Line
         }
 
 		result = compareHits(result, raycast_quad_diag(region, quad.ptr, raycastLine, backoff));
-
-        if (result)
-            break;
 	}
 	return result;
 }
@@ -7,15 +7,12 @@ namespace ff {
 void RegionArbiter::updateRegion(CollisionContext ctx, Rectf bounds)
 {
     ZoneScoped;
-	currQuads.clear();
 
     Vec2f deltap = ctx.collider->getDeltaPosition();
     bounds = math::rect_extend(bounds, deltap.x < 0.f ? Cardinal::W : Cardinal::E, abs(deltap.x));
     bounds = math::rect_extend(bounds, deltap.y < 0.f ? Cardinal::N : Cardinal::S, abs(deltap.y));
 
-    for (auto quad : ctx.collider->in_rect(bounds)) {
-        currQuads.push_back(quad.id);
-    }
+    auto quads = ctx.collider->quads_in_rect(bounds, currQuads);
 
 	// check for stale (out of bounds) quads to remove
 	for (auto& [_, arb] : quadArbiters) {
@@ -23,9 +20,7 @@ void RegionArbiter::updateRegion(CollisionContext ctx, Rectf bounds)
 	}
 
 	// create arbiters and/or update arbiters 
-	for (auto& qid : currQuads) {
-        auto quad = ctx.collider->get_quad(qid);
-
+	for (auto [qid, quad] : quads) {
 		if (!quad->hasAnySurface())
 			continue;
 
@@ -180,6 +180,11 @@ CollidablePreMove SurfaceTracker::premove_update(poly_id_map<ColliderRegion>* co
 		out = do_max_speed(out, deltaTime);
 	}
 
+    update_timers(deltaTime);
+	return out;
+}
+
+void SurfaceTracker::update_timers(secs deltaTime) {
     if (has_contact()) {
         contact_time += deltaTime;
         air_time = 0.0;
@@ -187,8 +192,6 @@ CollidablePreMove SurfaceTracker::premove_update(poly_id_map<ColliderRegion>* co
     else {
         air_time += deltaTime;
     }
-
-	return out;
 }
 
 // ----------------------------
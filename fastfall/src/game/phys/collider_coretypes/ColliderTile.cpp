@@ -53,23 +53,36 @@ constexpr std::array surfacePrototypes = {
 
 
 
-ColliderQuad ColliderTile::toQuad(QuadID id) const {
+// surfaces of a tile shape with its flips applied, at the origin
+struct QuadPrototype
+{
+	cardinal_array<ColliderQuad::QuadSurface> surfaces;
+	bool hasOneWay = false;
+	bool hasBoundary = false;
+	Cardinal oneWayDir = Cardinal::N;
+};
 
-	//ColliderQuad q{ surfacePrototypes.at(shape.type) };
+constexpr size_t prototype_index(TileShape shape)
+{
+	return static_cast<size_t>(shape.type) * 4 + (shape.flip_h ? 1 : 0) + (shape.flip_v ? 2 : 0);
+}
 
-	ColliderQuad q{
-		std::find_if(surfacePrototypes.begin(), surfacePrototypes.end(),
-		[this](const TypeSurfaceArray& element) {
-				return element.type == shape.type;
-		})->surfaces
-	};
+constexpr QuadPrototype make_quad_prototype(TileShape shape)
+{
+	QuadPrototype proto;
 
+	for (auto& type_surfaces : surfacePrototypes) {
+		if (type_surfaces.type == shape.type) {
+			proto.surfaces = type_surfaces.surfaces;
+			break;
+		}
+	}
 
 	//do transform
-	for (auto& colSurf : q.surfaces) {
+	for (auto& colSurf : proto.surfaces) {
 		Linef& surfLine = colSurf.collider.surface;
 
-		const static auto flip = [](float& i) {
+		constexpr auto flip = [](float& i) {
 			i = -i + TILESIZE_F;
 		};
 
@@ -85,14 +98,11 @@ ColliderQuad ColliderTile::toQuad(QuadID id) const {
 		//keep surface lines going clockwise
 		if ((shape.flip_v || shape.flip_h) && !(shape.flip_v && shape.flip_h))
 			std::swap(surfLine.p1, surfLine.p2);
-
-		surfLine.p1 += position * TILESIZE_F;
-		surfLine.p2 += position * TILESIZE_F;
 	}
 
-	auto swapFacing = [&q](Cardinal dir) {
-		auto& lhs = q.surfaces[dir];
-		auto& rhs = q.surfaces[direction::opposite(dir)];
+	auto swapFacing = [&proto](Cardinal dir, Cardinal opposite) {
+		auto& lhs = proto.surfaces[dir];
+		auto& rhs = proto.surfaces[opposite];
 
 		if ((lhs.hasSurface) && (rhs.hasSurface)) {
 			std::swap(lhs.collider, rhs.collider);
@@ -106,31 +116,63 @@ ColliderQuad ColliderTile::toQuad(QuadID id) const {
 			rhs.hasSurface = false;
 		}
         lhs.collider.id.dir = dir;
-        rhs.collider.id.dir = direction::opposite(dir);
+        rhs.collider.id.dir = opposite;
 	};
 
 	if (shape.flip_h) {
-		swapFacing(Cardinal::E);
+		swapFacing(Cardinal::E, Cardinal::W);
 	}
 	if (shape.flip_v) {
-		swapFacing(Cardinal::N);
+		swapFacing(Cardinal::N, Cardinal::S);
 	}
 
 	if (shape.type == TileShape::Type::Oneway) {
-		q.hasOneWay = true;
-		q.oneWayDir = !shape.flip_v ? Cardinal::N : Cardinal::S;
+		proto.hasOneWay = true;
+		proto.oneWayDir = !shape.flip_v ? Cardinal::N : Cardinal::S;
 	}
 	else if (shape.type == TileShape::Type::OnewayVert) {
-		q.hasOneWay = true;
-		q.oneWayDir = !shape.flip_h ? Cardinal::E : Cardinal::W;
+		proto.hasOneWay = true;
+		proto.oneWayDir = !shape.flip_h ? Cardinal::E : Cardinal::W;
 	}
 	else if (shape.type == TileShape::Type::LevelBoundary) {
-		q.hasBoundary = true;
-		q.oneWayDir = !shape.flip_v ? Cardinal::N : Cardinal::S;
+		proto.hasBoundary = true;
+		proto.oneWayDir = !shape.flip_v ? Cardinal::N : Cardinal::S;
 	}
 	else if (shape.type == TileShape::Type::LevelBoundary_Wall) {
-		q.hasBoundary = true;
-		q.oneWayDir = !shape.flip_h ? Cardinal::E : Cardinal::W;
+		proto.hasBoundary = true;
+		proto.oneWayDir = !shape.flip_h ? Cardinal::E : Cardinal::W;
+	}
+	return proto;
+}
+
+// every shape and flip, built at compile time so a tile edit is a lookup and a translate
+constexpr auto quadPrototypes = []() {
+	std::array<QuadPrototype, TileShape::TypeCount * 4> protos;
+	for (unsigned type = 0; type < TileShape::TypeCount; type++) {
+		for (unsigned flips = 0; flips < 4; flips++) {
+			TileShape shape{
+				.type = static_cast<TileShape::Type>(type),
+				.flip_h = (flips & 1) > 0,
+				.flip_v = (flips & 2) > 0
+			};
+			protos[prototype_index(shape)] = make_quad_prototype(shape);
+		}
+	}
+	return protos;
+}();
+
+ColliderQuad ColliderTile::toQuad(QuadID id) const {
+	const auto& proto = quadPrototypes[prototype_index(shape)];
+
+	ColliderQuad q{ proto.surfaces };
+	q.hasOneWay = proto.hasOneWay;
+	q.hasBoundary = proto.hasBoundary;
+	q.oneWayDir = proto.oneWayDir;
+
+	Vec2f offset = Vec2f(position) * TILESIZE_F;
+	for (auto& colSurf : q.surfaces) {
+		colSurf.collider.surface.p1 += offset;
+		colSurf.collider.surface.p2 += offset;
 	}
 
 	q.setID(id);
@@ -0,0 +1,377 @@
+#include "fastfall/game/phys/collider_regiontypes/ColliderMesh.hpp"
+
+#include "fastfall/render/DebugDraw.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ff {
+
+namespace {
+
+	// where the line enters and leaves bounds, as fractions of its length
+	std::optional<std::pair<float, float>> line_span(const Rectf& bounds, const Linef& line) {
+		Vec2f dir = line.p2 - line.p1;
+		float enter = 0.f;
+		float leave = 1.f;
+
+		auto clip = [&](float pos, float d, float min, float max) {
+			if (d == 0.f)
+				return pos >= min && pos <= max;
+
+			float a = (min - pos) / d;
+			float b = (max - pos) / d;
+			if (a > b)
+				std::swap(a, b);
+
+			enter = std::max(enter, a);
+			leave = std::min(leave, b);
+			return enter <= leave;
+		};
+
+		if (clip(line.p1.x, dir.x, bounds.left, bounds.left + bounds.width)
+			&& clip(line.p1.y, dir.y, bounds.top, bounds.top + bounds.height))
+		{
+			return std::make_pair(enter, leave);
+		}
+		return {};
+	}
+
+	// bounds of the surfaces the quad has, ColliderQuad::get_bounds() also counts missing ones
+	std::optional<Rectf> surface_bounds(const ColliderQuad& quad) {
+		std::optional<Rectf> bounds;
+		for (auto& surf : quad.surfaces) {
+			if (!surf.hasSurface)
+				continue;
+
+			Rectf surf_bounds = math::line_bounds(surf.collider.surface);
+			bounds = bounds ? math::rect_bound(*bounds, surf_bounds) : surf_bounds;
+		}
+		return bounds;
+	}
+
+	Vec2f center(const Rectf& r) {
+		return { r.left + r.width * 0.5f, r.top + r.height * 0.5f };
+	}
+
+	// deep enough for any hierarchy built by halving
+	using node_stack = std::array<uint32_t, 64>;
+
+}
+
+	ColliderMesh::ColliderMesh(std::vector<ColliderQuad> t_quads) :
+		ColliderRegion{},
+		quads(std::move(t_quads))
+	{
+		// quads without a surface can't be collided with, they're kept out of the hierarchy
+		std::vector<uint32_t> order;
+		std::vector<uint32_t> no_surface;
+		order.reserve(quads.size());
+		quadBounds.reserve(quads.size());
+		for (uint32_t i = 0; i < quads.size(); i++) {
+			auto bounds = surface_bounds(quads[i]);
+			quadBounds.push_back(bounds.value_or(Rectf{}));
+			(bounds ? order : no_surface).push_back(i);
+		}
+
+		if (!order.empty()) {
+			nodes.reserve(2 * order.size() / max_leaf_size + 1);
+			build_node(order, 0, order.size());
+		}
+		validCollisionSize = order.size();
+
+		// put quads in leaf order, so each node covers a contiguous range
+		// quads without a surface go last, past the root's range
+		order.insert(order.end(), no_surface.begin(), no_surface.end());
+		std::vector<ColliderQuad> ordered_quads;
+		std::vector<Rectf> ordered_bounds;
+		ordered_quads.reserve(quads.size());
+		ordered_bounds.reserve(quads.size());
+		for (auto ndx : order) {
+			ordered_quads.push_back(quads[ndx]);
+			ordered_bounds.push_back(quadBounds[ndx]);
+		}
+		quads = std::move(ordered_quads);
+		quadBounds = std::move(ordered_bounds);
+
+		for (size_t i = 0; i < quads.size(); i++) {
+			quads[i].setID({ static_cast<int>(i) });
+		}
+
+		connect_ghosts();
+
+		boundingBox = nodes.empty() ? Rectf{} : nodes[0].bounds;
+		prevBoundingBox = boundingBox;
+	}
+
+	uint32_t ColliderMesh::build_node(std::vector<uint32_t>& order, uint32_t first, uint32_t count) {
+		auto ndx = static_cast<uint32_t>(nodes.size());
+		nodes.push_back(Node{ .first = first, .count = count });
+
+		Rectf bounds = quadBounds[order[first]];
+		Vec2f center_min = center(bounds);
+		Vec2f center_max = center_min;
+		for (uint32_t i = first + 1; i < first + count; i++) {
+			const Rectf& quad_bounds = quadBounds[order[i]];
+			bounds = math::rect_bound(bounds, quad_bounds);
+
+			Vec2f c = center(quad_bounds);
+			center_min = Vec2f{ std::min(center_min.x, c.x), std::min(center_min.y, c.y) };
+			center_max = Vec2f{ std::max(center_max.x, c.x), std::max(center_max.y, c.y) };
+		}
+		nodes[ndx].bounds = bounds;
+
+		if (count <= max_leaf_size)
+			return ndx;
+
+		// split at the median along the longer axis
+		bool split_x = (center_max.x - center_min.x) >= (center_max.y - center_min.y);
+		uint32_t half = count / 2;
+		std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+			[&](uint32_t lhs, uint32_t rhs) {
+				Vec2f l = center(quadBounds[lhs]);
+				Vec2f r = center(quadBounds[rhs]);
+				return split_x ? l.x < r.x : l.y < r.y;
+			});
+
+		build_node(order, first, half);
+		uint32_t right = build_node(order, first + half, count - half);
+		nodes[ndx].right = right;
+		return ndx;
+	}
+
+	void ColliderMesh::connect_ghosts() {
+		std::vector<const ColliderQuad*> nearbyQuads;
+		std::vector<quad_iter> buffer;
+
+		for (size_t i = 0; i < quads.size(); i++) {
+			auto& quad = quads[i];
+			if (!quad.hasAnySurface())
+				continue;
+
+			// shared corners touch, same as the tilemap's adjacent tiles
+			nearbyQuads.clear();
+			for (auto nearby : quads_in_rect(math::shift(quadBounds[i], getPosition()), buffer)) {
+				nearbyQuads.push_back(nearby.ptr);
+			}
+
+			for (auto dir : direction::cardinals) {
+				if (ColliderSurface* surf_ptr = quad.getSurface(dir)) {
+					quad.setSurface(dir, findColliderGhosts(nearbyQuads, *surf_ptr));
+				}
+			}
+		}
+	}
+
+	void ColliderMesh::update(secs deltaTime) {
+		if (debug::enabled(debug::Collision_Collider) && validCollisionSize > 0) {
+			bool is_redrawn = debugDrawQuad(validCollisionSize, quads.data(), getPosition(), this, update_debugDraw);
+			if (update_debugDraw)
+				update_debugDraw = !is_redrawn;
+		}
+	}
+
+	const ColliderQuad* ColliderMesh::get_quad(QuadID quad_id) const noexcept {
+		return quad_id.value >= 0 && quad_id.value < quads.size() ? &quads[quad_id.value] : nullptr;
+	}
+
+	Rectf ColliderMesh::tile_area(QuadID quad_id) const noexcept {
+		return quad_id.value >= 0 && quad_id.value < quads.size() ? quadBounds[quad_id.value] : Rectf{};
+	}
+
+	size_t ColliderMesh::collect_quads(Rectf area, std::span<quad_iter> out) const {
+		if (nodes.empty())
+			return 0;
+
+		Rectf local = math::shift(area, -getPosition());
+
+		size_t count = 0;
+		node_stack stack;
+		size_t top = 0;
+		stack[top++] = 0;
+
+		while (top > 0) {
+			uint32_t ndx = stack[--top];
+			const Node& node = nodes[ndx];
+
+			if (!node.bounds.touches(local))
+				continue;
+
+			if (node.right == 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					if (quadBounds[i].touches(local)) {
+						if (count < out.size()) {
+							out[count] = { QuadID{ static_cast<int>(i) }, &quads[i] };
+						}
+						++count;
+					}
+				}
+			}
+			else {
+				// left first, keeping quads in index order
+				stack[top++] = node.right;
+				stack[top++] = ndx + 1;
+			}
+		}
+		return count;
+	}
+
+	size_t ColliderMesh::collect_quads(Linef line, std::span<quad_iter> out, bool skip_empty) const {
+		if (nodes.empty())
+			return 0;
+
+		Linef local = math::shift(line, -getPosition());
+
+		size_t count = 0;
+		node_stack stack;
+		size_t top = 0;
+		stack[top++] = 0;
+
+		while (top > 0) {
+			uint32_t ndx = stack[--top];
+			const Node& node = nodes[ndx];
+
+			if (!line_span(node.bounds, local))
+				continue;
+
+			if (node.right == 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					if (line_span(quadBounds[i], local)) {
+						if (count < out.size()) {
+							out[count] = { QuadID{ static_cast<int>(i) }, &quads[i] };
+						}
+						++count;
+					}
+				}
+			}
+			else {
+				stack[top++] = node.right;
+				stack[top++] = ndx + 1;
+			}
+		}
+
+		// nearest first, like stepping through a tilemap
+		if (count <= out.size()) {
+			auto enter = [&](const quad_iter& quad) {
+				return line_span(quadBounds[quad.id.value], local)->first;
+			};
+			std::sort(out.begin(), out.begin() + count, [&](const quad_iter& lhs, const quad_iter& rhs) {
+				float lhs_t = enter(lhs);
+				float rhs_t = enter(rhs);
+				return lhs_t != rhs_t ? lhs_t < rhs_t : lhs.id < rhs.id;
+			});
+		}
+		return count;
+	}
+
+	std::optional<QuadID> ColliderMesh::find_quad_in_rect(Rectf local_area, int after) const {
+		if (nodes.empty())
+			return {};
+
+		node_stack stack;
+		size_t top = 0;
+		stack[top++] = 0;
+
+		while (top > 0) {
+			uint32_t ndx = stack[--top];
+			const Node& node = nodes[ndx];
+
+			if (static_cast<int>(node.first + node.count) <= after + 1
+				|| !node.bounds.touches(local_area))
+			{
+				continue;
+			}
+
+			if (node.right == 0) {
+				for (uint32_t i = std::max<int>(node.first, after + 1); i < node.first + node.count; i++) {
+					if (quadBounds[i].touches(local_area))
+						return QuadID{ static_cast<int>(i) };
+				}
+			}
+			else {
+				stack[top++] = node.right;
+				stack[top++] = ndx + 1;
+			}
+		}
+		return {};
+	}
+
+	std::optional<QuadID> ColliderMesh::find_quad_in_line(Linef local_line, float after_t, int after) const {
+		if (nodes.empty())
+			return {};
+
+		std::optional<QuadID> best;
+		float best_t = INFINITY;
+
+		node_stack stack;
+		size_t top = 0;
+		stack[top++] = 0;
+
+		while (top > 0) {
+			uint32_t ndx = stack[--top];
+			const Node& node = nodes[ndx];
+
+			auto span = line_span(node.bounds, local_line);
+			if (!span || span->second < after_t || span->first > best_t)
+				continue;
+
+			if (node.right == 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					auto quad_span = line_span(quadBounds[i], local_line);
+					if (!quad_span)
+						continue;
+
+					float t = quad_span->first;
+					int id = static_cast<int>(i);
+
+					bool past_after = t != after_t ? t > after_t : id > after;
+					bool before_best = !best || (t != best_t ? t < best_t : id < best->value);
+					if (past_after && before_best) {
+						best = QuadID{ id };
+						best_t = t;
+					}
+				}
+			}
+			else {
+				stack[top++] = node.right;
+				stack[top++] = ndx + 1;
+			}
+		}
+		return best;
+	}
+
+    std::optional<QuadID> ColliderMesh::first_quad_in_rect(Rectf area, Recti& tile_area, bool skip_empty) const {
+        return find_quad_in_rect(math::shift(area, -getPosition()), -1);
+    }
+    std::optional<QuadID> ColliderMesh::next_quad_in_rect(Rectf area, QuadID quadid, const Recti& tile_area, bool skip_empty) const {
+        return find_quad_in_rect(math::shift(area, -getPosition()), quadid.value);
+    }
+    std::optional<QuadID> ColliderMesh::first_quad_in_line(Linef line, Recti& tile_area, bool skip_empty) const {
+        return find_quad_in_line(math::shift(line, -getPosition()), -INFINITY, -1);
+    }
+    std::optional<QuadID> ColliderMesh::next_quad_in_line(Linef line, QuadID quadid, const Recti& tile_area, bool skip_empty) const {
+        Linef local = math::shift(line, -getPosition());
+        auto span = line_span(quadBounds[quadid.value], local);
+        return span ? find_quad_in_line(local, span->first, quadid.value) : std::nullopt;
+    }
+
+	void ColliderMesh::set_on_precontact(std::function<bool(World&, const ContinuousContact&, secs)> func) {
+		callback_on_precontact = std::move(func);
+	}
+	void ColliderMesh::set_on_postcontact(std::function<void(World&, const AppliedContact&, secs)> func) {
+		callback_on_postcontact = std::move(func);
+	}
+
+	bool ColliderMesh::on_precontact(World& w, const ContinuousContact& contact, secs duration) const {
+		if (callback_on_precontact)
+			return callback_on_precontact(w, contact, duration);
+
+		return true;
+	}
+	void ColliderMesh::on_postcontact(World& w, const AppliedContact& contact, secs deltaTime) const {
+		if (callback_on_postcontact)
+			callback_on_postcontact(w, contact, deltaTime);
+	}
+
+}
@@ -37,6 +37,23 @@ namespace ff {
         return {};
     }
 
+    size_t ColliderSimple::collect_quads(Rectf area, std::span<quad_iter> out) const {
+        if (!boundingBox.touches(math::shift(area, -getPosition())))
+            return 0;
+
+        if (!out.empty())
+            out[0] = { quad.getID(), &quad };
+        return 1;
+    }
+    size_t ColliderSimple::collect_quads(Linef line, std::span<quad_iter> out, bool skip_empty) const {
+        if (!boundingBox.contains(math::shift(line, -getPosition())))
+            return 0;
+
+        if (!out.empty())
+            out[0] = { quad.getID(), &quad };
+        return 1;
+    }
+
 	void ColliderSimple::set_on_precontact(std::function<bool(World&, const ContinuousContact&, secs)> func) {
 		callback_on_precontact = func;
 	}
@@ -5,6 +5,7 @@
 #include "fastfall/util/line_thru_grid.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <stdlib.h>
 #include <cmath>
 
@@ -132,6 +133,83 @@ namespace ff {
 			col.setID({ i++ });
 		}
 		validCollisionSize = 0;
+
+		occupancyStride = (collisionMapSize.x + 63) / 64;
+		occupancy.assign(occupancyStride * collisionMapSize.y, 0);
+
+		for (auto& level : occupancyLevels) {
+			size_t block = size_t{ 1 } << level.shift;
+			level.width = (collisionMapSize.x + block - 1) >> level.shift;
+			level.counts.assign(level.width * ((collisionMapSize.y + block - 1) >> level.shift), 0);
+		}
+	}
+
+	void ColliderTileMap::set_has_tile(QuadID ndx, bool has_tile) {
+		tileShapeMap[ndx.value].hasTile = has_tile;
+
+		size_t x = ndx.value % collisionMapSize.x;
+		size_t y = ndx.value / collisionMapSize.x;
+		uint64_t bit = uint64_t{ 1 } << (x % 64);
+		uint64_t& word = occupancy[y * occupancyStride + x / 64];
+
+		if (((word & bit) != 0) == has_tile)
+			return;
+
+		word = has_tile ? (word | bit) : (word & ~bit);
+
+		for (auto& level : occupancyLevels) {
+			auto& count = level.counts[(y >> level.shift) * level.width + (x >> level.shift)];
+			count = has_tile ? count + 1 : count - 1;
+		}
+	}
+
+	int ColliderTileMap::empty_block_size(Vec2i at) const noexcept {
+		if (!validPosition(at))
+			return 0;
+
+		size_t x = at.x - size_min.x;
+		size_t y = at.y - size_min.y;
+		for (auto& level : occupancyLevels) {
+			if (level.counts[(y >> level.shift) * level.width + (x >> level.shift)] == 0)
+				return 1 << level.shift;
+		}
+		return 0;
+	}
+
+	Vec2i ColliderTileMap::line_exit_block(const Linef& line, Vec2i at, int block) const noexcept {
+		// aligned to size_min, same as the pyramid
+		Vec2i block_min{
+			((at.x - size_min.x) / block) * block + size_min.x,
+			((at.y - size_min.y) / block) * block + size_min.y
+		};
+
+		// same as line_thru_grid
+		Vec2f dir = line.p2 - line.p1;
+		Vec2i sign{ line.p1.x < line.p2.x ? 1 : -1, line.p1.y < line.p2.y ? 1 : -1 };
+
+		float edge_x = (sign.x > 0 ? block_min.x + block : block_min.x) * TILESIZE_F;
+		float edge_y = (sign.y > 0 ? block_min.y + block : block_min.y) * TILESIZE_F;
+
+		float tx = dir.x != 0.f ? (edge_x - line.p1.x) / dir.x : INFINITY;
+		float ty = dir.y != 0.f ? (edge_y - line.p1.y) / dir.y : INFINITY;
+
+		Vec2i next;
+		if (tx <= ty) {
+			next.x = sign.x > 0 ? block_min.x + block : block_min.x - 1;
+		}
+		else {
+			next.x = static_cast<int>(std::floor((line.p1.x + dir.x * ty) / TILESIZE_F));
+			next.x = std::clamp(next.x, block_min.x, block_min.x + block - 1);
+		}
+
+		if (ty <= tx) {
+			next.y = sign.y > 0 ? block_min.y + block : block_min.y - 1;
+		}
+		else {
+			next.y = static_cast<int>(std::floor((line.p1.y + dir.y * tx) / TILESIZE_F));
+			next.y = std::clamp(next.y, block_min.y, block_min.y + block - 1);
+		}
+		return next;
 	}
 
 	void ColliderTileMap::applyChanges() {
@@ -191,6 +269,11 @@ namespace ff {
 					}
 				}
 			}
+
+			markChanged(Rectf(
+				Vec2f(change_min) * TILESIZE_F + getPosition(),
+				Vec2f(change_max - change_min + Vec2i(1, 1)) * TILESIZE_F
+			));
 		}
 	}
 
@@ -222,7 +305,7 @@ namespace ff {
 			decr_valid_collision();
 		}
 
-		tileShapeMap[getTileID(change.position).value].hasTile = false;
+		set_has_tile(getTileID(change.position), false);
 		tileShapeMap[getTileID(change.position).value].tile.shape = TileShape{};
 		return true;
 	}
@@ -303,7 +386,7 @@ namespace ff {
 		}
 
 		if (nTile.shape.type == TileShape::Type::Empty) {
-			tileShapeMap[ndx.value].hasTile = false;
+			set_has_tile(ndx, false);
 			tileShapeMap[ndx.value].tile = nTile;
 			tileCollisionMap[ndx.value] = nQuad;
 			return true;
@@ -339,7 +422,7 @@ namespace ff {
 			incr_valid_collision();
 		}
 
-		tileShapeMap[ndx.value].hasTile = true;
+		set_has_tile(ndx, true);
 		tileShapeMap[ndx.value].tile = nTile;
 		tileCollisionMap[ndx.value] = nQuad;
 		return true;
@@ -498,9 +581,14 @@ namespace ff {
 
         if (skip_empty) {
             while (beg != end) {
-                if (get_quad(beg->pos)) {
-                    return getTileID(beg->pos);
-                } else {
+                Vec2i pos = beg->pos;
+                if (int block = empty_block_size(pos); block > 0) {
+                    beg = line_thru_grid<float>::iterator{ line, Recti{ size_min, size_max - size_min }, Vec2f{TILESIZE_F, TILESIZE_F}, line_exit_block(line, pos, block) };
+                }
+                else if (get_quad(pos)) {
+                    return getTileID(pos);
+                }
+                else {
                     ++beg;
                 }
             }
@@ -519,9 +607,14 @@ namespace ff {
         ++beg;
         if (skip_empty) {
             while (beg != end) {
-                if (get_quad(beg->pos)) {
-                    return getTileID(beg->pos);
-                } else {
+                Vec2i pos = beg->pos;
+                if (int block = empty_block_size(pos); block > 0) {
+                    beg = line_thru_grid<float>::iterator{ line, Recti{ size_min, size_max - size_min }, Vec2f{TILESIZE_F, TILESIZE_F}, line_exit_block(line, pos, block) };
+                }
+                else if (get_quad(pos)) {
+                    return getTileID(pos);
+                }
+                else {
                     ++beg;
                 }
             }
@@ -532,6 +625,78 @@ namespace ff {
         }
     }
 
+    size_t ColliderTileMap::collect_quads(Rectf area, std::span<quad_iter> out) const {
+        Recti tile_area = get_tile_area_for_rect(area);
+
+        if (tile_area.width <= 0 || tile_area.height <= 0)
+            return 0;
+
+        // relative to size_min, same as the quad ids
+        int left   = tile_area.left - size_min.x;
+        int right  = left + tile_area.width - 1;
+        int top    = tile_area.top - size_min.y;
+        int bottom = top + tile_area.height - 1;
+
+        size_t first_word = left / 64;
+        size_t last_word  = right / 64;
+        uint64_t first_mask = ~uint64_t{ 0 } << (left % 64);
+        uint64_t last_mask  = ~uint64_t{ 0 } >> (63 - (right % 64));
+
+        size_t count = 0;
+        for (int y = top; y <= bottom; ++y) {
+            const uint64_t* row = &occupancy[y * occupancyStride];
+
+            for (size_t w = first_word; w <= last_word; ++w) {
+                uint64_t bits = row[w];
+                if (w == first_word) bits &= first_mask;
+                if (w == last_word)  bits &= last_mask;
+
+                while (bits) {
+                    size_t ndx = (size_t)y * collisionMapSize.x + w * 64 + std::countr_zero(bits);
+                    bits &= bits - 1;
+
+                    if (count < out.size()) {
+                        out[count] = { QuadID{ (int)ndx }, &tileCollisionMap[ndx] };
+                    }
+                    ++count;
+                }
+            }
+        }
+        return count;
+    }
+
+    size_t ColliderTileMap::collect_quads(Linef line, std::span<quad_iter> out, bool skip_empty) const {
+        line = math::shift(line, -getPosition());
+
+        if (!boundingBox.contains(line))
+            return 0;
+
+        auto beg = line_thru_grid<float>::iterator{ line, Recti{ size_min, size_max - size_min }, Vec2f{TILESIZE_F, TILESIZE_F}};
+        auto end = Vec2i( floorf(line.p2.x / TILESIZE_F), floorf(line.p2.y / TILESIZE_F) );
+
+        size_t count = 0;
+        while (beg != end) {
+            Vec2i pos = beg->pos;
+
+            if (skip_empty) {
+                if (int block = empty_block_size(pos); block > 0) {
+                    beg = line_thru_grid<float>::iterator{ line, Recti{ size_min, size_max - size_min }, Vec2f{TILESIZE_F, TILESIZE_F}, line_exit_block(line, pos, block) };
+                    continue;
+                }
+            }
+
+            const ColliderQuad* quad = get_quad(pos);
+            if (!skip_empty || quad) {
+                if (count < out.size()) {
+                    out[count] = { getTileID(pos), quad };
+                }
+                ++count;
+            }
+            ++beg;
+        }
+        return count;
+    }
+
 	void ColliderTileMap::updateGhosts(const Vec2i& position) {
 		auto [quad, tile] = get_tile(position);
 		if (!quad)
@@ -0,0 +1,457 @@
+#include "fastfall/game/phys/collision/CollisionTrace.hpp"
+
+#include "fastfall/util/log.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+namespace ff {
+
+NLOHMANN_JSON_SERIALIZE_ENUM(ContactType, {
+	{ContactType::NO_SOLUTION,		"no solution"},
+	{ContactType::SINGLE,			"single"},
+	{ContactType::WEDGE,			"wedge"},
+	{ContactType::CRUSH_HORIZONTAL,	"horizontal crush"},
+	{ContactType::CRUSH_VERTICAL,	"vertical crush"},
+	})
+
+namespace {
+
+struct file_header {
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t count;
+};
+
+constexpr std::array<char, 4> trace_magic = { 'F', 'F', 'C', 'T' };
+constexpr uint32_t trace_version = 1;
+
+}
+
+CollisionTrace::CollisionTrace(size_t capacity)
+    : buffer(std::max(capacity, size_t{ 1 }))
+{
+}
+
+void CollisionTrace::begin_frame(uint32_t t_frame, secs delta) {
+    frame = t_frame;
+
+    trace::record rec{};
+    rec.type = trace::kind::Frame;
+    rec.frame = frame;
+    rec.frame_data = { .delta = delta };
+    record(rec);
+}
+
+void CollisionTrace::record(const trace::record& rec) {
+    buffer[head] = rec;
+    head = (head + 1) % buffer.size();
+    count = std::min(count + 1, buffer.size());
+    total++;
+}
+
+void CollisionTrace::record(const trace::collidable_t& data) {
+    trace::record rec{};
+    rec.type = trace::kind::Collidable;
+    rec.frame = frame;
+    rec.collidable = data;
+    record(rec);
+}
+
+void CollisionTrace::record(const trace::broad_phase_t& data) {
+    trace::record rec{};
+    rec.type = trace::kind::BroadPhase;
+    rec.frame = frame;
+    rec.broad_phase = data;
+    record(rec);
+}
+
+void CollisionTrace::record(const trace::broad_collider_t& data) {
+    trace::record rec{};
+    rec.type = trace::kind::BroadCollider;
+    rec.frame = frame;
+    rec.broad_collider = data;
+    record(rec);
+}
+
+void CollisionTrace::record(const trace::compare_t& data) {
+    trace::record rec{};
+    rec.type = trace::kind::Compare;
+    rec.frame = frame;
+    rec.compare = data;
+    record(rec);
+}
+
+void CollisionTrace::record_contact(trace::contact_stage stage, const ContinuousContact& contact, ContactType type) {
+    trace::record rec{};
+    rec.type = trace::kind::Contact;
+    rec.frame = frame;
+    rec.contact = {
+        .handle          = trace::to_handle(&contact),
+        .stage           = stage,
+        .type            = type,
+        .has_contact     = contact.hasContact,
+        .has_impact_time = contact.hasImpactTime,
+        .is_transposed   = contact.is_transposed,
+        .separation      = contact.separation,
+        .impact_time     = contact.impactTime,
+        .stick_offset    = contact.stickOffset,
+        .surface_p1      = trace::to_trace(contact.collider.surface.p1),
+        .surface_p2      = trace::to_trace(contact.collider.surface.p2),
+        .ortho_n         = trace::to_trace(contact.ortho_n),
+        .collider_n      = trace::to_trace(contact.collider_n),
+        .velocity        = trace::to_trace(contact.velocity),
+        .stick_p1        = trace::to_trace(contact.stickLine.p1),
+        .stick_p2        = trace::to_trace(contact.stickLine.p2),
+        .collidable      = contact.id ? contact.id->collidable.raw() : 0u,
+        .region          = contact.id ? contact.id->collider.raw() : 0u,
+        .quad            = contact.id ? contact.id->quad.value : 0,
+    };
+    record(rec);
+}
+
+void CollisionTrace::record_section(trace::section which) {
+    trace::record rec{};
+    rec.type = trace::kind::Section;
+    rec.frame = frame;
+    rec.section_data = { .which = which };
+    record(rec);
+}
+
+void CollisionTrace::record_stack(trace::stack_side side, std::span<ContinuousContact* const> contacts) {
+    for (auto* contact : contacts) {
+        trace::record rec{};
+        rec.type = trace::kind::Stack;
+        rec.frame = frame;
+        rec.stack = { .handle = trace::to_handle(contact), .side = side };
+        record(rec);
+    }
+}
+
+void CollisionTrace::record_event(trace::event which, const void* first, const void* second) {
+    trace::record rec{};
+    rec.type = trace::kind::Event;
+    rec.frame = frame;
+    rec.event_data = {
+        .first  = trace::to_handle(first),
+        .second = trace::to_handle(second),
+        .which  = which
+    };
+    record(rec);
+}
+
+std::vector<trace::record> CollisionTrace::records() const {
+    std::vector<trace::record> out;
+    out.reserve(count);
+
+    size_t start = (head + buffer.size() - count) % buffer.size();
+    for (size_t i = 0; i < count; i++) {
+        out.push_back(buffer[(start + i) % buffer.size()]);
+    }
+    return out;
+}
+
+void CollisionTrace::clear() {
+    head = 0;
+    count = 0;
+    total = 0;
+}
+
+bool CollisionTrace::save(const std::filesystem::path& path) const {
+    std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+    if (!file.is_open()) {
+        LOG_ERR_("unable to open collision trace file {}", path.string());
+        return false;
+    }
+
+    auto recs = records();
+    file_header header{
+        .magic       = trace_magic,
+        .version     = trace_version,
+        .record_size = sizeof(trace::record),
+        .count       = recs.size()
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(recs.data()), (std::streamsize)(recs.size() * sizeof(trace::record)));
+    return file.good();
+}
+
+std::optional<std::vector<trace::record>> CollisionTrace::load(const std::filesystem::path& path) {
+    std::ifstream file{ path, std::ios::binary };
+    if (!file.is_open()) {
+        LOG_ERR_("unable to open collision trace file {}", path.string());
+        return std::nullopt;
+    }
+
+    file_header header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file
+        || header.magic != trace_magic
+        || header.version != trace_version
+        || header.record_size != sizeof(trace::record))
+    {
+        LOG_ERR_("{} is not a collision trace, or from an incompatible build", path.string());
+        return std::nullopt;
+    }
+
+    std::vector<trace::record> recs(header.count);
+    file.read(reinterpret_cast<char*>(recs.data()), (std::streamsize)(recs.size() * sizeof(trace::record)));
+    if (!file) {
+        LOG_ERR_("collision trace {} is truncated", path.string());
+        return std::nullopt;
+    }
+    return recs;
+}
+
+// json conversion
+
+namespace {
+
+Vec2f to_vec(trace::vec2 v) { return { v.x, v.y }; }
+
+std::string to_ptr(uint64_t handle) {
+    return fmt::format("{}", fmt::ptr(reinterpret_cast<const void*>(static_cast<uintptr_t>(handle))));
+}
+
+nlohmann::ordered_json to_json(trace::rect r) {
+    return {
+        {"pos",  fmt::format("{}", Vec2f{ r.left, r.top }) },
+        {"size", fmt::format("{}", Vec2f{ r.width, r.height }) },
+    };
+}
+
+nlohmann::ordered_json to_json(const trace::contact_t& contact) {
+    return {
+        {"contact",         to_ptr(contact.handle) },
+        {"hasContact",      contact.has_contact },
+        {"separation",      contact.separation },
+        {"surface",         fmt::format("{} -> {}", to_vec(contact.surface_p1), to_vec(contact.surface_p2)) },
+        {"ortho_n",         fmt::format("{}", to_vec(contact.ortho_n)) },
+        {"collider_n",      fmt::format("{}", to_vec(contact.collider_n)) },
+        {"hasImpactTime",   contact.has_impact_time },
+        {"impactTime",      contact.impact_time },
+        {"velocity",        fmt::format("{}", to_vec(contact.velocity)) },
+        {"is_transposed",   contact.is_transposed },
+        {"collidable",      contact.collidable },
+        {"region",          contact.region },
+        {"quad",            contact.quad },
+        {"stick_offset",    contact.stick_offset },
+        {"stick_line",      fmt::format("{} -> {}", to_vec(contact.stick_p1), to_vec(contact.stick_p2)) },
+    };
+}
+
+nlohmann::ordered_json to_json(const trace::collidable_t& col) {
+    nlohmann::ordered_json json = {
+        { "id",         col.id },
+        { "pos",        fmt::format("{}", to_vec(col.pos)) },
+        { "delta_pos",  fmt::format("{}", to_vec(col.delta_pos)) },
+        { "localvel",   fmt::format("{}", to_vec(col.local_vel)) },
+        { "parentvel",  fmt::format("{}", to_vec(col.parent_vel)) },
+        { "globalvel",  fmt::format("{}", to_vec(col.global_vel)) },
+        { "size",       fmt::format("{}", to_vec(col.size)) },
+    };
+
+    if (col.has_tracker) {
+        json["tracker"] = {
+            { "has_contact", col.tracker_has_contact },
+            { "collider_id", col.tracker_collider },
+            { "quad_id",     col.tracker_quad }
+        };
+    }
+    else {
+        json["tracker"];
+    }
+    return json;
+}
+
+std::string_view to_string(trace::event which) {
+    switch (which) {
+        case trace::event::DiscardNoContact: return "discard_nocontact";
+        case trace::event::DiscardNoDir:     return "discard_nodir";
+        case trace::event::DiscardApply:     return "discard_apply";
+        case trace::event::PickingFrom:      return "picking_from";
+        case trace::event::WedgeFrom:        return "wedge_from";
+    }
+    return "";
+}
+
+std::string_view to_string(trace::stack_side side) {
+    switch (side) {
+        case trace::stack_side::East:  return "east";
+        case trace::stack_side::West:  return "west";
+        case trace::stack_side::North: return "north";
+        case trace::stack_side::South: return "south";
+    }
+    return "";
+}
+
+}
+
+nlohmann::ordered_json trace_to_json(
+        std::span<const trace::record> records,
+        uint32_t first_frame,
+        uint32_t last_frame)
+{
+    nlohmann::ordered_json out = nlohmann::ordered_json::array();
+
+    nlohmann::ordered_json* frame     = nullptr;
+    nlohmann::ordered_json* collision = nullptr;
+    nlohmann::ordered_json* solver    = nullptr;
+    nlohmann::ordered_json* stack     = nullptr;
+
+    for (const auto& rec : records) {
+
+        if (rec.type == trace::kind::Frame) {
+            collision = nullptr;
+            solver = nullptr;
+            stack = nullptr;
+
+            if (rec.frame >= first_frame && rec.frame <= last_frame) {
+                out.push_back({
+                    { "frame", rec.frame },
+                    { "delta", rec.frame_data.delta }
+                });
+                frame = &out.back();
+            }
+            else {
+                frame = nullptr;
+            }
+            continue;
+        }
+
+        // skipped frame, or the start of the ring buffer cut off this frame's beginning
+        if (!frame)
+            continue;
+
+        if (rec.type == trace::kind::Collidable) {
+            auto& collisions = (*frame)["collisions"];
+            collisions.push_back({ {"collidable", to_json(rec.collidable)} });
+            collision = &collisions.back();
+            solver = nullptr;
+            stack = nullptr;
+            continue;
+        }
+
+        if (!collision)
+            continue;
+
+        if (rec.type != trace::kind::Stack) {
+            stack = nullptr;
+        }
+
+        switch (rec.type) {
+        case trace::kind::BroadPhase:
+            (*collision)["broad_phase"]["init_bounds"]  = to_json(rec.broad_phase.init_bounds);
+            (*collision)["broad_phase"]["final_bounds"] = to_json(rec.broad_phase.final_bounds);
+            break;
+        case trace::kind::BroadCollider:
+            (*collision)["broad_phase"]["colliders"].push_back({
+                { "id",             rec.broad_collider.id },
+                { "vel",            fmt::format("{}", to_vec(rec.broad_collider.vel)) },
+                { "position",       fmt::format("{}", to_vec(rec.broad_collider.pos)) },
+                { "delta_pos",      fmt::format("{}", to_vec(rec.broad_collider.delta_pos)) },
+                { "arbiter_count",  rec.broad_collider.arbiter_count },
+            });
+            break;
+        case trace::kind::Section:
+            switch (rec.section_data.which) {
+            case trace::section::Solver:
+                solver = &(*collision)["solver"];
+                break;
+            case trace::section::Compare:
+                if (solver) (*solver)["compare"];
+                break;
+            case trace::section::Apply:
+                if (solver) (*solver)["apply"];
+                break;
+            case trace::section::XStack:
+            case trace::section::YStack:
+                if (solver) {
+                    bool x_axis = rec.section_data.which == trace::section::XStack;
+                    auto& apply = (*solver)["apply"];
+                    apply.push_back({
+                        { x_axis ? "x_stack" : "y_stack", {
+                            { x_axis ? "east" : "north", nlohmann::ordered_json::array() },
+                            { x_axis ? "west" : "south", nlohmann::ordered_json::array() },
+                        }}
+                    });
+                    stack = &apply.back()[x_axis ? "x_stack" : "y_stack"];
+                }
+                break;
+            }
+            break;
+        case trace::kind::Stack:
+            if (stack) {
+                (*stack)[std::string{ to_string(rec.stack.side) }].push_back(to_ptr(rec.stack.handle));
+            }
+            break;
+        case trace::kind::Contact:
+            if (!solver)
+                break;
+
+            switch (rec.contact.stage) {
+            case trace::contact_stage::Precompare:
+                (*solver)["precompare"].push_back(to_json(rec.contact));
+                break;
+            case trace::contact_stage::Postcompare:
+                (*solver)["postcompare"].push_back(to_json(rec.contact));
+                break;
+            case trace::contact_stage::Wedge:
+                if (auto& wedges = (*solver)["wedges"]; !wedges.empty()) {
+                    wedges.back()["created_contact"] = to_json(rec.contact);
+                }
+                break;
+            case trace::contact_stage::Applied:
+                (*solver)["apply"].push_back(to_json(rec.contact));
+                (*solver)["apply"].back()["type"] = rec.contact.type;
+                break;
+            }
+            break;
+        case trace::kind::Compare:
+            if (solver) {
+                (*solver)["compare"].push_back({
+                    {"first",  to_ptr(rec.compare.first) },
+                    {"second", to_ptr(rec.compare.second) },
+                    {"result", {
+                            {"first",  (rec.compare.discard_first ? "discard" : "keep")},
+                            {"second", (rec.compare.discard_second ? "discard" : "keep")}
+                        }
+                    }
+                });
+            }
+            break;
+        case trace::kind::Event:
+            if (!solver)
+                break;
+
+            switch (rec.event_data.which) {
+            case trace::event::PickingFrom:
+                (*solver)["apply"].push_back({
+                    { "picking_from", { to_ptr(rec.event_data.first), to_ptr(rec.event_data.second) }}
+                });
+                break;
+            case trace::event::WedgeFrom:
+                (*solver)["wedges"].push_back({
+                    {"north", to_ptr(rec.event_data.first) },
+                    {"south", to_ptr(rec.event_data.second) },
+                });
+                break;
+            default:
+                (*solver)["apply"].push_back({
+                    { std::string{ to_string(rec.event_data.which) }, to_ptr(rec.event_data.first) }
+                });
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return out;
+}
+
+}
@@ -2,6 +2,8 @@
 
 #include "fastfall/game/World.hpp"
 
+#include <algorithm>
+
 namespace ff {
 
 void ActorSystem::update(World& world, secs deltaTime)
@@ -15,28 +17,34 @@ void ActorSystem::update(World& world, secs deltaTime)
 
 void ActorSystem::predraw(World& world, predraw_state_t predraw_state)
 {
-    std::vector<ID<Entity>> to_erase;
     for (auto& id : update_order) {
         auto& actor = world.at(id);
         if (actor.is_dead()) {
-            to_erase.push_back(actor.entity_id);
+            world.destroy(actor.entity_id);
         }
         else {
             actor.predraw(world, predraw_state);
         }
     }
-    for (auto ent : to_erase) {
-        world.erase(ent);
-    }
 }
 
-void ActorSystem::notify_created(World& world, ID<Actor> id) {
-    created_actors.push_back(id);
+void ActorSystem::notify_created(World& world, std::span<const ID<Actor>> ids) {
+    created_actors.insert(created_actors.end(), ids.begin(), ids.end());
 }
 
-void ActorSystem::notify_erased(World& world, ID<Actor> id) {
-    std::erase(update_order, id);
-    std::erase(created_actors, id);
+void ActorSystem::notify_erased(World& world, std::span<const ID<Actor>> ids) {
+    if (ids.size() == 1) {
+        std::erase(update_order, ids.front());
+        std::erase(created_actors, ids.front());
+        return;
+    }
+
+    // one pass over the lists for the whole batch
+    std::vector<ID<Actor>> erased{ ids.begin(), ids.end() };
+    std::sort(erased.begin(), erased.end());
+    auto is_erased = [&erased](ID<Actor> id) { return std::binary_search(erased.begin(), erased.end(), id); };
+    std::erase_if(update_order, is_erased);
+    std::erase_if(created_actors, is_erased);
 }
 
 void ActorSystem::append_created(const World& world) {
@@ -4,10 +4,39 @@
 
 #include "fastfall/engine/Engine.hpp"
 
+#include <algorithm>
+
 namespace ff {
 
+AudioSystem::AudioSystem() {
+    played_this_tick.reserve(audio::voice_count);
+}
+
+std::optional<SoundHandle> AudioSystem::play(const SoundAsset& sound_asset, SoundCfg cfg) {
+    if (std::find(played_this_tick.begin(), played_this_tick.end(), &sound_asset) != played_this_tick.end()) {
+        deduplicated++;
+        return std::nullopt;
+    }
+
+    if (!cfg.tag) {
+        cfg.tag = "game";
+    }
+
+    SoundHandle sound_handle{ cfg };
+    if (!sound_handle.valid()) {
+        return std::nullopt;
+    }
+
+    sound_handle.apply_config();
+    sound_handle.set_sound(sound_asset);
+    sound_handle.play();
+    played_this_tick.push_back(&sound_asset);
+    return sound_handle;
+}
+
 void AudioSystem::update(secs deltaTime) {
     upTime += deltaTime;
+    played_this_tick.clear();
 }
 
 SoundAsset* AudioSystem::get_asset_impl(std::string_view sound_asset_name) {
@@ -2,6 +2,7 @@
 
 #include "fastfall/game/phys/CollisionSolver.hpp"
 #include "fastfall/game/World.hpp"
+#include "fastfall/engine/telemetry.hpp"
 
 #include <algorithm>
 
@@ -10,14 +11,49 @@
 
 namespace ff {
 
+CollisionSystem::CollisionSystem(const CollisionSystem& other)
+	: arbiters(other.arbiters)
+	, rest_states(other.rest_states)
+	, disturbed_areas(other.disturbed_areas)
+	, created_regions(other.created_regions)
+	, solver(other.solver)
+	, contact_buffer(other.contact_buffer)
+	, frame_count(other.frame_count)
+	, frame_collision_count(other.frame_collision_count)
+{
+}
+
+CollisionSystem& CollisionSystem::operator=(const CollisionSystem& other) {
+	arbiters = other.arbiters;
+	rest_states = other.rest_states;
+	disturbed_areas = other.disturbed_areas;
+	created_regions = other.created_regions;
+	solver = other.solver;
+	contact_buffer = other.contact_buffer;
+	frame_count = other.frame_count;
+	frame_collision_count = other.frame_collision_count;
+
+	collision_dump = nullptr;
+	dump_trace.reset();
+	trace = nullptr;
+	return *this;
+}
+
 void CollisionSystem::update(World& world, secs deltaTime)
 {
+	CollisionTrace* tracer = trace;
 	if (collision_dump)
 	{
-		(*collision_dump) = {
-			{"frame", frame_count},
-			{"delta", deltaTime}
-		};
+		if (!dump_trace)
+			dump_trace.emplace();
+
+		dump_trace->clear();
+		tracer = &*dump_trace;
+	}
+
+	if (tracer)
+	{
+		tracer->begin_frame((uint32_t)frame_count, deltaTime);
 	}
 
     auto& collidables = world.all<Collidable>();
@@ -27,33 +63,77 @@ void CollisionSystem::update(World& world, secs deltaTime)
 	{
         {
             ZoneScopedN("Update Colliders");
+            disturbed_areas.clear();
             for (auto [id, collider]: colliders) {
                 collider->update(deltaTime);
+
+                if (collider->hasMoved()
+                    || collider->velocity != Vec2f{}
+                    || collider->delta_velocity != Vec2f{})
+                {
+                    disturbed_areas.push_back(collider->getSweptBoundingBox());
+                }
+                if (auto area = collider->takeChangedArea()) {
+                    disturbed_areas.push_back(*area);
+                }
+            }
+
+            for (auto id : created_regions) {
+                if (auto* collider = world.get(id)) {
+                    disturbed_areas.push_back(collider->getBoundingBox());
+                }
+            }
+            created_regions.clear();
+        }
+
+        {
+            ZoneScopedN("Check Resting Collidables");
+            for (auto& [id, rest] : rest_states) {
+                // dumps always get the full solve
+                if (collision_dump) {
+                    rest.wake();
+                }
+                rest.prepare(world.at(id), disturbed_areas);
             }
         }
 
-        size_t ndx = 0;
         {
             ZoneScopedN("Update Collidables");
             for (auto [id, col]: collidables) {
-                col.update(&colliders, deltaTime);
+                if (!rest_states.at(id).is_asleep()) {
+                    col.update(&colliders, deltaTime);
+                }
             }
         }
 
         {
             ZoneScopedN("Solve Collisions");
             for (auto [id, arb]: arbiters) {
-                auto *dump_ptr = (collision_dump ? &(*collision_dump)["collisions"][ndx] : nullptr);
-                arb.gather_and_solve_collisions(world, deltaTime, dump_ptr);
-                ndx++;
+                auto& rest = rest_states.at(id);
+                auto& col = world.at(id);
+                if (rest.is_asleep()) {
+                    rest.sleep(world, col, deltaTime);
+                    continue;
+                }
+
+                arb.gather_and_solve_collisions(world, solver, contact_buffer, deltaTime, tracer);
+                rest.update(col);
             }
         }
 
+        {
+            static const auto contacts_channel = telemetry::counter("contacts solved");
+            size_t contact_count = 0;
+            for (auto [id, col]: collidables) {
+                contact_count += col.get_contacts().size();
+            }
+            telemetry::record(contacts_channel, contact_count);
+        }
+
         {
             ZoneScopedN("Update Collidable Attachpoints");
             // update attachments
-            for (auto [id, col]: collidables) {
-                auto &attach = world.at(col.get_attach_id());
+            for (auto [id, col, attach]: world.view<Collidable, AttachPoint>()) {
                 //attach.teleport(col.getPrevPosition());
                 attach.set_pos(col.getPosition() + col.get_attach_origin());
                 attach.set_parent_vel(col.get_global_vel());
@@ -64,6 +144,20 @@ void CollisionSystem::update(World& world, secs deltaTime)
 	for (auto [id, col] : collidables) {
 		col.debug_draw();
 	}
+	if (collision_dump)
+	{
+		auto records = dump_trace->records();
+		auto frames = trace_to_json(records);
+		(*collision_dump) = frames.empty() ? nlohmann::ordered_json{} : std::move(frames.front());
+
+		// the persistent trace still gets this frame
+		if (trace) {
+			for (auto& rec : records) {
+				trace->record(rec);
+			}
+		}
+	}
+
 	collision_dump = nullptr;
 	frame_count++;
 };
@@ -71,22 +165,48 @@ void CollisionSystem::update(World& world, secs deltaTime)
 void CollisionSystem::notify_created(World& world, ID<Collidable> id)
 {
     arbiters[id] = CollidableArbiter{.collidable_id = id};
+    rest_states[id] = CollidableRest{};
 }
 
 void CollisionSystem::notify_created(World& world, ID<ColliderRegion> id)
 {
+    // wakes anything resting where it appeared
+    created_regions.push_back(id);
 }
 
-void CollisionSystem::notify_erased(World& world, ID<Collidable> id)
+void CollisionSystem::notify_erased(World& world, std::span<const ID<Collidable>> ids)
 {
-    arbiters.erase(id);
+    for (auto id : ids) {
+        arbiters.erase(id);
+        rest_states.erase(id);
+    }
 }
 
-void CollisionSystem::notify_erased(World& world, ID<ColliderRegion> id)
+void CollisionSystem::notify_erased(World& world, std::span<const ID<ColliderRegion>> ids)
 {
     for (auto& [_, arb] : arbiters)
     {
-        arb.erase_region(id);
+        for (auto id : ids) {
+            arb.erase_region(id);
+        }
+    }
+
+    // contacts may refer to the erased regions
+    for (auto& [col_id, rest] : rest_states)
+    {
+        if (!rest.is_asleep())
+            continue;
+
+        auto* col = world.get(col_id);
+        if (!col)
+            continue;
+
+        for (auto& contact : col->get_contacts()) {
+            if (contact.id && std::find(ids.begin(), ids.end(), contact.id->collider) != ids.end()) {
+                rest.wake();
+                break;
+            }
+        }
     }
 }
 
@@ -1,6 +1,9 @@
 #include "fastfall/game/systems/EmitterSystem.hpp"
 
 #include "fastfall/game/World.hpp"
+#include "fastfall/engine/jobs.hpp"
+#include "fastfall/engine/telemetry.hpp"
+#include "fastfall/render/DebugDraw.hpp"
 
 #include "tracy/Tracy.hpp"
 
@@ -14,16 +17,59 @@ void EmitterSystem::update(World& world, secs deltaTime) {
         events_per_emitter.clear();
 
         const poly_id_map<ColliderRegion>& collider_regions = world.all<ColliderRegion>();
+
+        emitters.clear();
         for (auto [eid, e]: world.all<Emitter>()) {
+            emitters.push_back(&e);
+        }
+
+        // each emitter writes to its own buffer, reused across ticks
+        if (emitter_events.size() < emitters.size())
+            emitter_events.resize(emitters.size());
+
+        auto update_emitter = [&](size_t ndx) {
             ZoneScopedN("Update Emitter");
-            size_t init_events_count = events.size();
-            auto output_it = std::back_inserter(events);
-            e.update(deltaTime, &output_it);
-            e.apply_collision(collider_regions, &output_it);
-            events_per_emitter.push_back(events.size() - init_events_count);
+            auto& out = emitter_events[ndx];
+            out.clear();
+            auto output_it = std::back_inserter(out);
+            emitters[ndx]->update(deltaTime, &output_it);
+            emitters[ndx]->apply_collision(collider_regions, &output_it);
+        };
+
+        jobs::parallel_for(emitters.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t ndx = begin; ndx < end; ++ndx) {
+                if (emitters[ndx]->parallelize)
+                    update_emitter(ndx);
+            }
+        });
 
+        for (size_t ndx = 0; ndx < emitters.size(); ++ndx) {
+            if (!emitters[ndx]->parallelize)
+                update_emitter(ndx);
         }
 
+        // merge in emitter order, so events don't depend on which thread ran which emitter
+        size_t particle_count = 0;
+        for (size_t ndx = 0; ndx < emitters.size(); ++ndx) {
+            auto& out = emitter_events[ndx];
+            events.insert(events.end(), out.begin(), out.end());
+            events_per_emitter.push_back(static_cast<int>(out.size()));
+            particle_count += emitters[ndx]->particles.size();
+        }
+
+        static const auto particles_channel = telemetry::counter("particles alive");
+        telemetry::record(particles_channel, particle_count);
+
+        if (debug::enabled(debug::Emitter)) {
+            for (auto* e : emitters) {
+                e->debug_draw(collider_regions);
+            }
+        }
+    }
+}
+
+void EmitterSystem::dispatch_events(World& world, secs deltaTime) {
+    if (deltaTime > 0.0 && !events_per_emitter.empty()) {
         auto count_it  = events_per_emitter.begin();
         auto events_it = events.begin();
         for (auto [eid, e]: world.all<Emitter>()) {
@@ -42,12 +88,32 @@ void EmitterSystem::update(World& world, secs deltaTime) {
 }
 
 void EmitterSystem::predraw(World& world, predraw_state_t predraw_state) {
-    for (auto [eid, e] : world.all<Emitter>())
-    {
+    auto& scene = world.system<SceneSystem>();
+
+    emitters.clear();
+    for (auto [eid, e] : world.all<Emitter>()) {
+        emitters.push_back(&e);
+    }
+
+    // each emitter only writes its own vertex array and scene config
+    auto predraw_emitter = [&](Emitter& e) {
+        ZoneScopedN("Predraw Emitter");
         e.predraw(
                 world.at(e.get_drawid()),
-                world.system<SceneSystem>().config(e.get_drawid()),
+                scene.config(e.get_drawid()),
                 predraw_state);
+    };
+
+    jobs::parallel_for(emitters.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t ndx = begin; ndx < end; ++ndx) {
+            if (emitters[ndx]->parallelize)
+                predraw_emitter(*emitters[ndx]);
+        }
+    });
+
+    for (auto* e : emitters) {
+        if (!e->parallelize)
+            predraw_emitter(*e);
     }
 }
 
@@ -7,8 +7,8 @@
 namespace ff {
 
 void PathSystem::update(World& world, secs deltaTime) {
-    for (auto [id, pm] : world.all<PathMover>()) {
-        pm.update(world.at(pm.get_attach_id()), deltaTime);
+    for (auto [id, pm, attach] : world.view<PathMover, AttachPoint>()) {
+        pm.update(attach, deltaTime);
 
         if (debug::enabled(debug::Path) && !debug::repeat((void*)&pm.get_path(), pm.get_path().origin))
         {
@@ -100,13 +100,9 @@ void SceneSystem::add_to_scene(World& world)
 
 }
 
-void SceneSystem::notify_erased(World& world, ID<Drawable> id)
+void SceneSystem::notify_erased(World& world, std::span<const ID<Drawable>> ids)
 {
-    to_erase.insert(id);
-}
-
-void SceneSystem::set_cam_pos(Vec2f center) {
-	cam_pos = center;
+    to_erase.insert(ids.begin(), ids.end());
 }
 
 void SceneSystem::set_bg_color(Color color) {
@@ -123,7 +119,9 @@ void SceneSystem::set_size(Vec2u size) {
 
 void SceneSystem::draw(const World& world, RenderTarget& target, RenderState state) const {
 
-	bool scissor_enabled = enableScissor(target, cam_pos);
+	// background layers are clipped to the level
+	bool scissor_enabled = true;
+	target.enableScissor(Rectf{ {}, scene_size });
 
 	target.draw(background, state);
 
@@ -133,11 +131,7 @@ void SceneSystem::draw(const World& world, RenderTarget& target, RenderState sta
 
         if (scissor_enabled && cfg.layer_id >= 0) {
             scissor_enabled = false;
-            disableScissor();
-        }
-        else if (!scissor_enabled && cfg.layer_id < 0)
-        {
-            continue;
+            target.disableScissor();
         }
 
         if (cfg.visible)
@@ -161,53 +155,8 @@ void SceneSystem::draw(const World& world, RenderTarget& target, RenderState sta
     }
 
 	if (scissor_enabled) {
-		disableScissor();
+		target.disableScissor();
 	}
 }
 
-
-bool SceneSystem::enableScissor(const RenderTarget& target, Vec2f viewPos) const {
-
-	glm::fvec4 scissor;
-	View view = target.getView();
-	scissor = view.getViewport();
-
-	Vec2f vpOff{ view.getViewport()[0], view.getViewport()[1] };
-	Vec2f vpSize{ view.getViewport()[2], view.getViewport()[3] };
-
-	if (scene_size.x * scene_size.y > 0.f) {
-		float zoom = view.getViewport()[2] / view.getSize().x;
-
-		glm::fvec2 levelsize = Vec2f{ scene_size };
-		glm::fvec2 campos = viewPos;
-		glm::fvec2 campos2window = vpOff + (vpSize / 2.f);
-		glm::fvec2 lvlbotleft2cam{ campos.x, levelsize.y - campos.y };
-		glm::fvec2 levelbotleft2window = campos2window - (lvlbotleft2cam * zoom);
-
-		scissor[0] = roundf((std::max)(scissor[0], levelbotleft2window.x));
-		scissor[1] = roundf((std::max)(scissor[1], levelbotleft2window.y));
-
-		scissor[2] = (std::min)(vpOff.x + vpSize.x, levelbotleft2window.x + (levelsize.x * zoom)) - scissor[0];
-		scissor[3] = (std::min)(vpOff.y + vpSize.y, levelbotleft2window.y + (levelsize.y * zoom)) - scissor[1];
-
-		scissor[2] = roundf((std::max)(scissor[2], 0.f));
-		scissor[3] = roundf((std::max)(scissor[3], 0.f));
-	}
-
-	if (scissor[2] > 0.f && scissor[3] > 0.f) {
-		glScissor(
-			scissor[0],
-			scissor[1],
-			scissor[2],
-			scissor[3]
-		);
-		glEnable(GL_SCISSOR_TEST);
-	}
-	return scissor[2] > 0.f && scissor[3] > 0.f;
-}
-
-void SceneSystem::disableScissor() const {
-	glDisable(GL_SCISSOR_TEST);
-}
-
 }
\ No newline at end of file
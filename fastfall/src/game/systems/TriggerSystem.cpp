@@ -3,6 +3,8 @@
 #include "fastfall/render/DebugDraw.hpp"
 #include "fastfall/game/World.hpp"
 
+#include <algorithm>
+
 
 namespace ff {
 
@@ -60,24 +62,34 @@ void TriggerSystem::notify_created(World& world, ID<Trigger> id)
 {
 }
 
-void TriggerSystem::notify_erased(World& world, ID<Trigger> id)
+void TriggerSystem::notify_erased(World& world, std::span<const ID<Trigger>> ids)
 {
+    std::vector<ID<Trigger>> erased{ ids.begin(), ids.end() };
+    std::sort(erased.begin(), erased.end());
+    auto is_erased = [&erased](ID<Trigger> id) { return std::binary_search(erased.begin(), erased.end(), id); };
+
     // if the trigger is being erased, try to trigger any drivers associated first
-    auto& tr = world.at(id);
-    for (auto [_, trigger] : world.all<Trigger>()) {
-        auto iter = trigger.drivers.find(id);
-        if (iter != trigger.drivers.end())
+    // one scan over the triggers for the whole batch
+    for (auto [tid, trigger] : world.all<Trigger>()) {
+        if (is_erased(tid))
+            continue;
+
+        for (auto iter = trigger.drivers.begin(); iter != trigger.drivers.end();)
         {
+            if (!is_erased(iter->first)) {
+                ++iter;
+                continue;
+            }
             if (trigger.is_enabled()) {
                 auto pull = TriggerPull{
                     .self = &trigger,
-                    .source = &tr,
+                    .source = &world.at(iter->first),
                     .state = Trigger::State::Exit,
                     .duration = iter->second.duration,
                 };
                 trigger.trigger(world, pull);
             }
-            trigger.drivers.erase(iter);
+            iter = trigger.drivers.erase(iter);
         }
     }
 }
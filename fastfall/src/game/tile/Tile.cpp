@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <array>
 #include <random>
+#include <span>
 
 namespace ff {
 
@@ -125,6 +126,23 @@ namespace ff {
 		}
 	}
 
+	// touches of every shape, indexed by type then flips
+	const TileTouch& shape_touch(TileShape shape)
+	{
+		const static auto touches = []() {
+			std::array<TileTouch, TileShape::TypeCount * 4> arr;
+			for (unsigned i = 0; i < arr.size(); i++) {
+				arr[i] = TileTouch{ TileShape{
+					.type   = static_cast<TileShape::Type>(i / 4),
+					.flip_h = (i & 1) != 0,
+					.flip_v = (i & 2) != 0
+				} };
+			}
+			return arr;
+		}();
+		return touches[static_cast<unsigned>(shape.type) * 4 + shape.flip_h + 2 * shape.flip_v];
+	}
+
 	// Tile State
 
 	bool autotile_has_edge(
@@ -161,6 +179,25 @@ namespace ff {
 	}
 
 
+	TileState make_autotile_state(
+		const TileTouch& auto_shape,
+		const cardinal_array<TileTouch>& neighbors_card,
+		const ordinal_array<TileTouch>& neighbors_ord)
+	{
+		TileState state;
+		state.shape = auto_shape.shape;
+
+		for ( auto dir : direction::cardinals ) {
+			state.occupied_edges[dir] = autotile_has_edge(dir, auto_shape, neighbors_card[dir]);
+			state.card_shapes[dir] = neighbors_card[dir].shape;
+		}
+		for ( auto dir : direction::ordinals ) {
+			state.inner_corners[dir] = autotile_has_inner_corner(dir, auto_shape, neighbors_card, neighbors_ord);
+			state.ord_shapes[dir] = neighbors_ord[dir].shape;
+		}
+		return state;
+	}
+
 	TileState get_autotile_state(
 		TileShape init_shape,
 		grid_view<TileShape> grid,
@@ -202,19 +239,88 @@ namespace ff {
 		cardinal_array<TileTouch> neighbors_card = dir_transform(direction::cardinals);
 		ordinal_array<TileTouch>  neighbors_ord  = dir_transform(direction::ordinals);
 
-		TileState state;
-		state.shape = init_shape;
+		return make_autotile_state(auto_shape, neighbors_card, neighbors_ord);
+	}
 
-		for ( auto dir : direction::cardinals ) {
-			state.occupied_edges[dir] = autotile_has_edge(dir, auto_shape, neighbors_card[dir]);
-			state.card_shapes[dir] = neighbors_card[dir].shape;
-		}
-		for ( auto dir : direction::ordinals ) {
-			state.inner_corners[dir] = autotile_has_inner_corner(dir, auto_shape, neighbors_card, neighbors_ord);
-			state.ord_shapes[dir] = neighbors_ord[dir].shape;
+	void get_autotile_states(
+		grid_view<TileShape> grid,
+		Recti area,
+		AutoTileOffGridSubstitute offgrid_shape,
+		std::vector<TileState>& out)
+	{
+		out.clear();
+		if (area.width <= 0 || area.height <= 0)
+			return;
+
+		int columns = grid.column_count();
+		int rows = grid.row_count();
+		bool wrap = std::holds_alternative<AUTOTILE_GRID_WRAP>(offgrid_shape) && columns > 0 && rows > 0;
+		TileTouch offgrid_touch = std::holds_alternative<TileShape>(offgrid_shape)
+			? shape_touch(std::get<TileShape>(offgrid_shape))
+			: TileTouch{};
+
+		auto touch_at = [&](int x, int y) -> const TileTouch& {
+			if (wrap) {
+				x = ((x % columns) + columns) % columns;
+				y = ((y % rows) + rows) % rows;
+			}
+			if (x >= 0 && x < columns && y >= 0 && y < rows) {
+				return shape_touch(grid.at(x, y));
+			}
+			return offgrid_touch;
+		};
+
+		// rows above, at and below the current one, with a column either side of the area
+		size_t width = area.width + 2;
+		std::array<std::vector<TileTouch>, 3> touch_rows;
+		auto fill_row = [&](std::vector<TileTouch>& row, int y) {
+			row.resize(width);
+			for (size_t i = 0; i < width; i++) {
+				row[i] = touch_at(area.left - 1 + static_cast<int>(i), y);
+			}
+		};
+
+		fill_row(touch_rows[0], area.top - 1);
+		fill_row(touch_rows[1], area.top);
+		out.reserve(static_cast<size_t>(area.width) * area.height);
+
+		for (int y = area.top; y < area.top + area.height; y++) {
+			fill_row(touch_rows[2], y + 1);
+			const auto& north = touch_rows[0];
+			const auto& row   = touch_rows[1];
+			const auto& south = touch_rows[2];
+
+			for (size_t i = 1; i < width - 1; i++) {
+				cardinal_array<TileTouch> neighbors_card;
+				neighbors_card[Cardinal::N] = north[i];
+				neighbors_card[Cardinal::E] = row[i + 1];
+				neighbors_card[Cardinal::S] = south[i];
+				neighbors_card[Cardinal::W] = row[i - 1];
+
+				ordinal_array<TileTouch> neighbors_ord;
+				neighbors_ord[Ordinal::NW] = north[i - 1];
+				neighbors_ord[Ordinal::NE] = north[i + 1];
+				neighbors_ord[Ordinal::SE] = south[i + 1];
+				neighbors_ord[Ordinal::SW] = south[i - 1];
+
+				out.push_back(make_autotile_state(row[i], neighbors_card, neighbors_ord));
+			}
+			std::rotate(touch_rows.begin(), touch_rows.begin() + 1, touch_rows.end());
 		}
+	}
 
-		return state;
+	uint8_t autotile_mask(const TileState& state)
+	{
+		uint8_t mask = 0;
+		for (auto dir : direction::cardinals) {
+			if (state.occupied_edges[dir])
+				mask |= 1 << static_cast<unsigned>(dir);
+		}
+		for (auto dir : direction::ordinals) {
+			if (state.inner_corners[dir])
+				mask |= 1 << (4 + static_cast<unsigned>(dir));
+		}
+		return mask;
 	}
 
 	// Tile Constraint
@@ -354,12 +460,12 @@ namespace ff {
 		return match;
 	}
 
-	std::optional<TileID> auto_best_tile(
+	// the equally best matches, in the order they're picked from
+	void best_matches(
 		const TileState& state,
 		const std::vector<TileConstraint>& constraints,
-		unsigned seed)
+		std::vector<TileID>& out)
 	{
-		//std::vector<Match> matches;
 		std::vector<Match> matches;
 		matches.reserve(constraints.size());
 
@@ -372,30 +478,115 @@ namespace ff {
 			}
 		}
 
-		// pick best
 		if (!matches.empty())
 		{
 			auto& first = *matches.rbegin();
-			unsigned count = 0;
 			for (auto rit = matches.rbegin(); rit != matches.rend(); rit++)
 			{
 				if (*rit == first)
-					count++;
+					out.push_back(rit->tile_id);
 				else
 					break;
 			}
+		}
+	}
+
+	std::optional<TileID> pick_match(std::span<const TileID> best, unsigned seed)
+	{
+		if (best.empty())
+			return std::nullopt;
+
+		if (best.size() == 1)
+			return best[0];
+
+		// multiple valid matches, pick random one
+		std::mt19937 gen(seed);
+		std::uniform_int_distribution<> distrib(0, static_cast<int>(best.size()) - 1);
+		return best[distrib(gen)];
+	}
+
+	std::optional<TileID> auto_best_tile(
+		const TileState& state,
+		const std::vector<TileConstraint>& constraints,
+		unsigned seed)
+	{
+		std::vector<TileID> best;
+		best_matches(state, constraints, best);
+		return pick_match(best, seed);
+	}
+
+	// Autotile Table
 
-			// multiple valid matches, pick random one
-            std::mt19937 gen(seed);
-            std::uniform_int_distribution<> distrib(0, count - 1);
-			TileID tID = (matches.rbegin() + distrib(gen))->tile_id;
+	AutotileTable::AutotileTable(const std::vector<TileConstraint>& constraints)
+	{
+		std::vector<std::vector<TileConstraint>> by_shape;
+		for (const auto& constraint : constraints)
+		{
+			auto it = std::find_if(shapes.begin(), shapes.end(),
+				[&](const ShapeTable& table) { return table.shape == constraint.shape; });
 
-			return tID;
+			if (it == shapes.end()) {
+				shapes.push_back(ShapeTable{ .shape = constraint.shape });
+				by_shape.emplace_back();
+				it = shapes.end() - 1;
+			}
+			by_shape[std::distance(shapes.begin(), it)].push_back(constraint);
 		}
-		else
+
+		std::vector<TileID> best;
+		for (size_t i = 0; i < shapes.size(); i++)
 		{
-			return std::nullopt;
+			auto& table = shapes[i];
+			auto& shape_constraints = by_shape[i];
+
+			bool reads_shapes = std::any_of(shape_constraints.begin(), shape_constraints.end(),
+				[](const TileConstraint& constraint) {
+					return std::any_of(constraint.edges.begin(), constraint.edges.end(),
+						[](const TileConstraint::Edge& edge) {
+							return edge && std::holds_alternative<TileShape>(*edge);
+						});
+				});
+
+			if (reads_shapes) {
+				table.shape_constraints = std::move(shape_constraints);
+				continue;
+			}
+
+			for (unsigned mask = 0; mask < table.by_mask.size(); mask++)
+			{
+				TileState state;
+				state.shape = table.shape;
+				for (auto dir : direction::cardinals) {
+					state.occupied_edges[dir] = (mask & (1 << static_cast<unsigned>(dir))) != 0;
+				}
+				for (auto dir : direction::ordinals) {
+					state.inner_corners[dir] = (mask & (1 << (4 + static_cast<unsigned>(dir)))) != 0;
+				}
+
+				best.clear();
+				best_matches(state, shape_constraints, best);
+				table.by_mask[mask] = {
+					.first = static_cast<uint32_t>(candidates.size()),
+					.count = static_cast<uint32_t>(best.size())
+				};
+				candidates.insert(candidates.end(), best.begin(), best.end());
+			}
 		}
 	}
 
+	std::optional<TileID> AutotileTable::best_tile(const TileState& state, unsigned seed) const
+	{
+		auto it = std::find_if(shapes.begin(), shapes.end(),
+			[&](const ShapeTable& table) { return table.shape == state.shape; });
+
+		if (it == shapes.end())
+			return std::nullopt;
+
+		if (!it->shape_constraints.empty())
+			return auto_best_tile(state, it->shape_constraints, seed);
+
+		auto [first, count] = it->by_mask[autotile_mask(state)];
+		return pick_match({ candidates.data() + first, count }, seed);
+	}
+
 }
@@ -4,6 +4,7 @@
 #include "fastfall/render/drawable/ShapeRectangle.hpp"
 #include "detail/error.hpp"
 #include "fastfall/render/render.hpp"
+#include "fastfall/util/triple_buffer.hpp"
 
 #include <set>
 #include <deque>
@@ -47,6 +48,9 @@ namespace ff::debug {
     detail::state_t* curr_state = &state_A;
     detail::state_t* prev_state = &state_B;
 
+    // predraw hands the finished state to draw, which may be on another thread
+    triple_buffer<detail::state_t> drawn_states;
+
     detail::gpu_state_t gl;
 
     void set(type t, bool set) {
@@ -172,6 +176,9 @@ namespace ff::debug {
     void reset() {
         curr_state->clear();
         prev_state->clear();
+
+        drawn_states.back().clear();
+        drawn_states.publish();
     }
 
     void predraw(bool updated) {
@@ -184,7 +191,9 @@ namespace ff::debug {
 
             std::swap(curr_state, prev_state);
             curr_state->clear();
-            gl.m_sync = false;
+
+            drawn_states.back() = *prev_state;
+            drawn_states.publish();
         }
     }
 
@@ -221,7 +230,11 @@ namespace ff::debug {
             }
         }
 
-        auto& state = *prev_state;
+        if (drawn_states.acquire()) {
+            gl.m_sync = false;
+        }
+
+        auto& state = drawn_states.front();
         if (!gl.m_sync && !state.vertices.empty()) {
             glCheck(glBindBuffer(GL_ARRAY_BUFFER, gl.m_buffer));
             if (!gl.m_bound || state.vertices.size() > gl.m_bufsize) {
@@ -241,7 +254,7 @@ namespace ff::debug {
             target.draw(sh, states);
         }
 
-        target.draw(*prev_state, gl);
+        target.draw(state, gl);
     }
 
     void cleanup() {
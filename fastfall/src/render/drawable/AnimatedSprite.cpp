@@ -127,10 +127,7 @@ void AnimatedSprite::predraw(predraw_state_t predraw_state)
 {
 	if (animation) {
 		if (flag_dirty) {
-			if (curr_anim != animation->anim_id) {
-				curr_anim = animation->anim_id;
-				sprite.setTexture(&animation->get_sprite_texture());
-			}
+			curr_anim = animation->anim_id;
 
 			sprite.setScale(Vec2f{ (hflip ? -1.f : 1.f), 1.f });
 			sprite.setOrigin(glm::fvec2(animation->origin.x, animation->origin.y));
@@ -138,10 +135,12 @@ void AnimatedSprite::predraw(predraw_state_t predraw_state)
 			flag_dirty = false;
 		}
 
-        Rectf area = Rectf(
-                animation->area.getPosition(),
-                animation->area.getSize()
-        );
+        // the sprite's texture moves between its own and an atlas page when reloaded
+        if (sprite.getTexture() != &animation->get_sprite_texture()) {
+            sprite.setTexture(&animation->get_sprite_texture());
+        }
+
+        Rectf area{ animation->get_texture_area() };
 
         secs time_buffer_interp = time_buffer + (predraw_state.update_dt * predraw_state.interp);
         unsigned int next_frame = time_buffer_interp >= curr_frame_duration ? 1 : 0;
@@ -14,10 +14,14 @@ ChunkVertexArray::ChunkVertexArray(Vec2u t_size, Vec2u t_max_chunk_size)
 
 }
 
-void ChunkVertexArray::setTexture(const Texture& texture) noexcept {
+void ChunkVertexArray::setTexture(const Texture& texture, Recti area) noexcept {
+	if (m_tex.get() == &texture && m_tex_area == area)
+		return;
+
 	m_tex = texture;
+	m_tex_area = area;
 	for (auto& chunk : m_chunks) {
-		chunk.tva.setTexture(texture);
+		chunk.tva.setTexture(texture, area);
 	}
 }
 
@@ -77,7 +81,7 @@ void ChunkVertexArray::do_setTile(Vec2u at, TileID tile) {
 			.tva = Array{nSize}
 			});
 
-		m_chunks.back().tva.setTexture(*m_tex.get());
+		m_chunks.back().tva.setTexture(*m_tex.get(), m_tex_area);
 		m_chunks.back().tva.setTile(innerPos, tile);
 		m_chunks.back().tva.offset = Vec2f{ (float)chunkPos.x * m_chunk_size.x, (float)chunkPos.y * m_chunk_size.y } * TILESIZE_F;
 	}
@@ -87,7 +91,7 @@ void ChunkVertexArray::do_setTile(Vec2u at, TileID tile) {
 			.chunk_size = nSize,
 			.tva = Array{nSize}
 			});
-		iter->tva.setTexture(*m_tex.get());
+		iter->tva.setTexture(*m_tex.get(), m_tex_area);
 		iter->tva.setTile(innerPos, tile);
 		iter->tva.offset = Vec2f{ (float)chunkPos.x * m_chunk_size.x, (float)chunkPos.y * m_chunk_size.y } * TILESIZE_F;
 	}
@@ -62,6 +62,7 @@ Sprite::Sprite(const Texture* texture, Rectf textureRect, float spriteSizeX, flo
 }
 
 void Sprite::setTexture(const Texture* texture, bool resetRect) {
+	const Texture* prev = m_texture.get();
 	m_texture = texture ? *texture : Texture::getNullTexture();
 
 	if (resetRect && m_texture.exists()) {
@@ -71,6 +72,12 @@ void Sprite::setTexture(const Texture* texture, bool resetRect) {
 			});
 		m_size = m_texture.get()->size();
 	}
+	else if (prev && prev != m_texture.get()) {
+		// tex coords depend on the texture size
+		Rectf rect = m_textureRect;
+		m_textureRect = Rectf{};
+		setTextureRect(rect);
+	}
 }
 
 void Sprite::setTextureRect(Rectf textureRect) {
@@ -1,11 +1,28 @@
 #include "fastfall/render/drawable/Text.hpp"
 #include "fastfall/util/log.hpp"
 
+#include <algorithm>
+#include <mutex>
+
 #include "GL/glew.h"
 #include "../detail/error.hpp"
 #include "fastfall/render/render.hpp"
 
 namespace ff {
+
+	namespace {
+		// layouts shared by all text, which may be updated from more than one thread
+		struct shared_layouts_t {
+			std::mutex lock;
+			TextLayoutCache cache;
+		};
+
+		shared_layouts_t& get_shared_layouts() {
+			static shared_layouts_t layouts;
+			return layouts;
+		}
+	}
+
 	Text::Text()
 	{
 
@@ -26,6 +43,61 @@ namespace ff {
 		setText(font, size, text);
 	}
 
+	Text::~Text()
+	{
+		glStaleVertexArrays(gl.m_array);
+		glStaleVertexBuffers(gl.m_buffer);
+	}
+
+	Text::Text(const Text& rhs)
+	{
+		*this = rhs;
+	}
+
+	Text& Text::operator=(const Text& rhs)
+	{
+		Transformable::operator=(rhs);
+		gl_text_fresh = rhs.gl_text_fresh;
+		gl_text = rhs.gl_text;
+		m_text = rhs.m_text;
+		m_layout = rhs.m_layout;
+		bounding_size = rhs.bounding_size;
+		bitmap_texture = rhs.bitmap_texture;
+		bitmap_area = rhs.bitmap_area;
+		px_size = rhs.px_size;
+		v_spacing = rhs.v_spacing;
+		m_font = rhs.m_font;
+		m_color = rhs.m_color;
+
+		gl.sync = false;
+		gl.dirty_begin = 0;
+		return *this;
+	}
+
+	Text::Text(Text&& rhs) noexcept
+	{
+		*this = std::move(rhs);
+	}
+
+	Text& Text::operator=(Text&& rhs) noexcept
+	{
+		Transformable::operator=(rhs);
+		gl_text_fresh = rhs.gl_text_fresh;
+		gl_text = std::move(rhs.gl_text);
+		m_text = std::move(rhs.m_text);
+		m_layout = std::move(rhs.m_layout);
+		bounding_size = rhs.bounding_size;
+		bitmap_texture = rhs.bitmap_texture;
+		bitmap_area = rhs.bitmap_area;
+		px_size = rhs.px_size;
+		v_spacing = rhs.v_spacing;
+		m_font = rhs.m_font;
+		m_color = rhs.m_color;
+
+		std::swap(gl, rhs.gl);
+		return *this;
+	}
+
 	void Text::setText(std::optional<const_font_ref> font, std::optional<unsigned> pixel_size, std::optional<std::string_view> text)
 	{
 		bool update = false;
@@ -67,6 +139,7 @@ namespace ff {
 		}
 		m_color = color;
 		gl.sync = false;
+		gl.dirty_begin = 0;
 	}
 
 
@@ -79,86 +152,69 @@ namespace ff {
 
 	void Text::update_text()
 	{
+		if (!m_font
+			|| px_size == 0
+			|| m_text.empty()
+			|| !m_font->setPixelSize(px_size))
+		{
+			clear();
+			gl.sync = false;
+			return;
+		}
 
-		if (m_font 
-			&& px_size > 0 
-			&& !m_text.empty()
-			&& m_font->setPixelSize(px_size))
+		auto& shared_layouts = get_shared_layouts();
+		bool cache_hit = false;
 		{
-			if (!m_font->setPixelSize(px_size))
+			std::lock_guard guard{ shared_layouts.lock };
+			if (auto* cached = shared_layouts.cache.find(m_font->getId(), px_size, v_spacing, m_text))
 			{
-				clear();
-				return;
+				m_layout = *cached;
+				cache_hit = true;
 			}
+		}
 
-			gl_text.clear();
-
-			bounding_size = { 0, 0, 0, 0 };
-
-			size_t ndx = 0;
-
-			glm::fvec2 pen = {0, m_font->getYMax() };
+		if (!cache_hit)
+		{
+			// only redoes the characters after the part shared with the previous text
+			m_layout.build(*m_font, px_size, v_spacing, m_text);
 
-			for (unsigned char ch : m_text)
-			{
-				if (ch >= 128)
-					continue;
-
-				if (ch == '\n') {
-					pen = { 0, pen.y + (m_font->getHeight() * v_spacing) };
-					continue;
-				}
-
-				if (ch == '\t') {
-					unsigned space_width = m_font->getMetrics(' ').advance_x;
-
-					float x = 0.f;
-					while (x < pen.x + space_width)
-					{
-						x += 4.f * space_width;
-					}
-					pen.x = x;
-
-					//pen.x = pen.x /
-					continue;
-
-				}
-
-				if (ch == ' ') {
-					unsigned space_width = m_font->getMetrics(' ').advance_x;
-					pen.x += space_width;
-					continue;
-				}
-
-				auto& metrics = m_font->getMetrics(ch);
-
-				gl_text.push_back({
-					.offset = {
-						pen.x + metrics.bearing.x,
-						pen.y - metrics.bearing.y
-					},
-					.color = m_color,
-					.character = ch,
-					});
-
-				pen.x += metrics.advance_x;
-
-				bounding_size = math::rect_bound(Rectf{
-						(float)pen.x + metrics.bearing.x,
-						(float)pen.y - m_font->getYMax(),
-						(float)metrics.size.x,
-						(float)m_font->getYMax() - m_font->getYMin()
-					}, bounding_size);
+			std::lock_guard guard{ shared_layouts.lock };
+			shared_layouts.cache.insert(m_layout);
+		}
+		bounding_size = m_layout.bounds;
+
+		// leave the unchanged front of the string alone so only the rest is transferred
+		size_t count = m_layout.glyphs.size();
+		size_t prev_count = gl_text.size();
+		size_t same = 0;
+		while (same < std::min(prev_count, count)
+			&& gl_text[same].character == m_layout.glyphs[same].character
+			&& gl_text[same].offset.x == m_layout.glyphs[same].offset.x
+			&& gl_text[same].offset.y == m_layout.glyphs[same].offset.y)
+		{
+			same++;
+		}
 
-			}
+		gl_text.resize(count);
+		for (size_t i = same; i < count; i++)
+		{
+			gl_text[i] = {
+				.offset = m_layout.glyphs[i].offset,
+				.color = m_color,
+				.character = m_layout.glyphs[i].character,
+			};
+		}
 
-			bitmap_texture = m_font->getBitmapTex();
-			
+		if (gl.sync) {
+			gl.dirty_begin = same;
 		}
 		else {
-			clear();
+			gl.dirty_begin = std::min(gl.dirty_begin, same);
 		}
-		gl.sync = false;
+		gl.sync = same == count && count == prev_count && gl.sync;
+
+		bitmap_texture = m_font->getBitmapTex();
+		bitmap_area = m_font->getBitmapArea();
 	}
 
 	void Text::glTransfer() const {
@@ -205,10 +261,14 @@ namespace ff {
 				gl.m_bufsize = gl_text.size();
 				gl.m_bound = true;
 			}
-			else {
-				glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, gl_text.size() * sizeof(glChar), &gl_text[0]));
+			else if (gl.dirty_begin < gl_text.size()) {
+				glCheck(glBufferSubData(GL_ARRAY_BUFFER,
+					gl.dirty_begin * sizeof(glChar),
+					(gl_text.size() - gl.dirty_begin) * sizeof(glChar),
+					&gl_text[gl.dirty_begin]));
 			}
 			gl.sync = true;
+			gl.dirty_begin = gl_text.size();
 		}
 
 	}
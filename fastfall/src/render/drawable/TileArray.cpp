@@ -27,6 +27,7 @@ TileArray::TileArray(const TileArray& rhs)
 {
 	offset = rhs.offset;
 	m_tex = rhs.m_tex;
+	m_tex_area = rhs.m_tex_area;
 	tile_count = rhs.tile_count;
 	tiles = rhs.tiles;
 
@@ -38,6 +39,7 @@ TileArray& TileArray::operator= (const TileArray& rhs)
 	m_size = rhs.m_size;
 	offset = rhs.offset;
 	m_tex = rhs.m_tex;
+	m_tex_area = rhs.m_tex_area;
 	tile_count = rhs.tile_count;
 	tiles = rhs.tiles;
 
@@ -51,6 +53,7 @@ TileArray::TileArray(TileArray&& rhs) noexcept
 	offset = rhs.offset;
 	m_size = rhs.m_size;
 	m_tex = rhs.m_tex;
+	m_tex_area = rhs.m_tex_area;
 	tile_count = rhs.tile_count;
 
 	std::swap(tiles, rhs.tiles);
@@ -61,6 +64,7 @@ TileArray& TileArray::operator=(TileArray&& rhs) noexcept
 	offset = rhs.offset;
 	m_size = rhs.m_size;
 	m_tex = rhs.m_tex;
+	m_tex_area = rhs.m_tex_area;
 	tile_count = rhs.tile_count;
 
 	std::swap(tiles, rhs.tiles);
@@ -68,9 +72,10 @@ TileArray& TileArray::operator=(TileArray&& rhs) noexcept
 	return *this;
 }
 
-void TileArray::setTexture(const Texture& texture) noexcept
+void TileArray::setTexture(const Texture& texture, Recti area) noexcept
 {
 	m_tex = texture;
+	m_tex_area = area;
 }
 
 const TextureRef& TileArray::getTexture() const noexcept
@@ -114,6 +119,7 @@ void TileArray::blank(Vec2u at)
 void TileArray::clear()
 {
 	m_tex = TextureRef{};
+	m_tex_area = Recti{};
 	tile_count = 0;
 
 	std::fill(tiles.begin(), tiles.end(), TileID{});
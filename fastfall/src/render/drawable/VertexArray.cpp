@@ -30,7 +30,7 @@ VertexArray& VertexArray::operator= (const VertexArray& varray) {
 	m_usage = varray.m_usage;
 	m_primitive = varray.m_primitive;
 	m_vec = varray.m_vec;
-	//gl.sync = false;
+	gl.sync = false;
 
 	return *this;
 }
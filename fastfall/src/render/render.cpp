@@ -184,9 +184,12 @@ void ImGuiNewFrame(Window& window) {
     ImGui::NewFrame();
 }
 
+void ImGuiEndFrame() {
+    ImGui::Render();
+}
+
 void ImGuiRender() {
 
-    ImGui::Render();
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
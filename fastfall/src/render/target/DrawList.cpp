@@ -0,0 +1,84 @@
+#include "fastfall/render/target/DrawList.hpp"
+
+#include "tracy/Tracy.hpp"
+
+namespace ff {
+
+// the vertex and tile array copies don't carry the drawable's transform, so it's folded into the state
+
+void DrawList::draw(const VertexArray& varray, const RenderState& state) {
+	if (varray.empty())
+		return;
+
+	RenderState st = state;
+	st.transform = Transform::combine(varray.getTransform(), state.transform);
+
+	m_commands.push_back(command_t{
+		.type  = Command::VertexArray,
+		.index = m_varrays.copy(varray),
+		.state = st
+	});
+}
+
+void DrawList::draw(const TileArray& tarray, RenderState state) {
+	state.transform = Transform::combine(tarray.getTransform(), state.transform);
+
+	m_commands.push_back(command_t{
+		.type  = Command::TileArray,
+		.index = m_tarrays.copy(tarray),
+		.state = state
+	});
+}
+
+void DrawList::draw(const Text& text, RenderState state) {
+	m_commands.push_back(command_t{
+		.type  = Command::Text,
+		.index = m_texts.copy(text),
+		.state = state
+	});
+}
+
+void DrawList::enableScissor(Rectf area) {
+	m_commands.push_back(command_t{
+		.type = Command::EnableScissor,
+		.area = area
+	});
+}
+
+void DrawList::disableScissor() {
+	m_commands.push_back(command_t{
+		.type = Command::DisableScissor
+	});
+}
+
+void DrawList::reset() {
+	m_commands.clear();
+	m_varrays.reset();
+	m_tarrays.reset();
+	m_texts.reset();
+}
+
+void DrawList::replay(RenderTarget& target) const {
+	ZoneScoped;
+	for (auto& cmd : m_commands) {
+		switch (cmd.type) {
+		case Command::VertexArray:
+			target.draw(m_varrays.items[cmd.index], cmd.state);
+			break;
+		case Command::TileArray:
+			target.draw(m_tarrays.items[cmd.index], cmd.state);
+			break;
+		case Command::Text:
+			target.draw(m_texts.items[cmd.index], cmd.state);
+			break;
+		case Command::EnableScissor:
+			target.enableScissor(cmd.area);
+			break;
+		case Command::DisableScissor:
+			target.disableScissor();
+			break;
+		}
+	}
+}
+
+}
@@ -13,6 +13,26 @@
 
 namespace ff {
 
+namespace {
+    const ShaderHandle tile_shader{ "tile.glsl" };
+    const ShaderHandle text_shader{ "text.glsl" };
+
+    const Uniform<glm::mat3> model_uniform    { "model" };
+    const Uniform<glm::mat3> view_uniform     { "view" };
+    const Uniform<GLuint>    columns_uniform  { "columns" };
+    const Uniform<glm::vec2> char_size_uniform{ "char_size" };
+    const Uniform<glm::vec4> tex_area_uniform { "tex_area" };
+
+    // pixel area of the image on its texture, the whole texture if unset
+    glm::vec4 textureArea(const Recti& area, const TextureRef& texture) {
+        if (area.width > 0 && area.height > 0) {
+            return { area.left, area.top, area.width, area.height };
+        }
+        glm::uvec2 size = texture.get() ? texture.get()->size() : glm::uvec2{ 1, 1 };
+        return { 0.f, 0.f, size.x, size.y };
+    }
+}
+
 RenderTarget::RenderTarget()
 	: m_view{ {0, 0}, {0, 0} },
 	m_context{ nullptr }
@@ -92,7 +112,7 @@ void RenderTarget::draw(const VertexArray& varray, const RenderState& state) {
 		hasBlend = true;
 	}
 
-	if (state.program != previousRender->program || !hasShader) {
+	if (shaderChanged(state.program)) {
 		applyShader(state.program);
 		hasShader = (state.program != nullptr);
 	}
@@ -123,12 +143,9 @@ void RenderTarget::draw(const TileArray& tarray, RenderState state) {
 
 	state.transform = Transform::combine(state.transform, Transform(tarray.offset));
 	state.texture = tarray.m_tex;
-    constexpr std::string_view shader = "tile.glsl";
-    if (auto ptr = Resources::get<ShaderAsset>(shader)) {
-        state.program = &ptr->getProgram();
-    }
-    else {
-        LOG_ERR_("failed to render, {} shader not loaded", shader);
+    state.program = tile_shader.get();
+    if (!state.program) {
+        LOG_ERR_("failed to render, {} shader not loaded", tile_shader.getName());
         return;
     }
 
@@ -146,17 +163,15 @@ void RenderTarget::draw(const TileArray& tarray, RenderState state) {
 	}
 
 	//LOG_INFO("using shader: {}", state.program ? state.program->getID() : -1);
-	if (state.program != previousRender->program || !hasShader) {
+	if (shaderChanged(state.program)) {
 		applyShader(state.program);
 		hasShader = (state.program != nullptr);
 	}
 
 	if (state.program) {
 		applyUniforms(Transform::combine(tarray.getTransform(), state.transform), state);
-		auto columns = state.program->getUniform("columns");
-		if (columns) {
-			glCheck(glUniform1ui(columns->loc, tarray.m_size.x));
-		}
+		state.program->setUniform(columns_uniform, static_cast<GLuint>(tarray.m_size.x));
+		state.program->setUniform(tex_area_uniform, textureArea(tarray.m_tex_area, state.texture));
 	}
 
 	if (state.texture.get()->getID() != previousRender->texture.get()->getID() || justCleared) {
@@ -183,15 +198,19 @@ void RenderTarget::draw(const Text& text, RenderState state) {
 	if (text.m_font && !text.bitmap_texture.exists())
 	{
 		text.m_font->loadBitmapTex(text.px_size);
+
+		// the bitmap may have gone into the atlas instead of its own texture
+		auto bitmap = text.m_font->getBitmap(text.px_size);
+		if (bitmap.texture) {
+			text.bitmap_texture = *bitmap.texture;
+			text.bitmap_area = bitmap.area;
+		}
 	}
 
 	state.texture = text.bitmap_texture;
-    constexpr std::string_view shader = "text.glsl";
-    if (auto ptr = Resources::get<ShaderAsset>(shader)) {
-        state.program = &ptr->getProgram();
-    }
-    else {
-        LOG_ERR_("failed to render, {} shader not loaded", shader);
+    state.program = text_shader.get();
+    if (!state.program) {
+        LOG_ERR_("failed to render, {} shader not loaded", text_shader.getName());
         return;
     }
 
@@ -206,18 +225,16 @@ void RenderTarget::draw(const Text& text, RenderState state) {
 		hasBlend = true;
 	}
 
-	if (state.program != previousRender->program || !hasShader) {
+	if (shaderChanged(state.program)) {
 		applyShader(state.program);
 		hasShader = (state.program != nullptr);
 	}
 
 	if (state.program) {
 		applyUniforms(Transform::combine(text.getTransform(), state.transform), state);
-		auto char_size_uni = state.program->getUniform("char_size");
-		if (char_size_uni) {
-			Vec2f size { text.getFont()->getGlyphSize() };
-			glCheck(glUniform2f(char_size_uni->loc, size.x, size.y));
-		}
+		Vec2f size { text.getFont()->getGlyphSize() };
+		state.program->setUniform(char_size_uniform, glm::vec2{ size.x, size.y });
+		state.program->setUniform(tex_area_uniform, textureArea(text.bitmap_area, state.texture));
 	}
 
 	if (state.texture.get()->getID() != previousRender->texture.get()->getID() || justCleared) {
@@ -254,7 +271,7 @@ void RenderTarget::draw(debug::detail::state_t& debug, debug::detail::gpu_state_
         hasBlend = true;
     }
 
-    if (state.program != previousRender->program || !hasShader) {
+    if (shaderChanged(state.program)) {
         applyShader(state.program);
         hasShader = (state.program != nullptr);
     }
@@ -275,6 +292,40 @@ void RenderTarget::draw(debug::detail::state_t& debug, debug::detail::gpu_state_
     justCleared = false;
 }
 
+void RenderTarget::enableScissor(Rectf area) {
+
+	glm::fvec4 scissor = m_view.getViewport();
+
+	Vec2f vpOff{ scissor[0], scissor[1] };
+	Vec2f vpSize{ scissor[2], scissor[3] };
+
+	if (area.width * area.height > 0.f) {
+		float zoom = vpSize.x / m_view.getSize().x;
+
+		glm::fvec2 campos = m_view.getCenter();
+		glm::fvec2 campos2window = vpOff + (vpSize / 2.f);
+		glm::fvec2 areabotleft2cam{ campos.x - area.left, area.top + area.height - campos.y };
+		glm::fvec2 areabotleft2window = campos2window - (areabotleft2cam * zoom);
+
+		scissor[0] = roundf((std::max)(scissor[0], areabotleft2window.x));
+		scissor[1] = roundf((std::max)(scissor[1], areabotleft2window.y));
+
+		scissor[2] = (std::min)(vpOff.x + vpSize.x, areabotleft2window.x + (area.width * zoom)) - scissor[0];
+		scissor[3] = (std::min)(vpOff.y + vpSize.y, areabotleft2window.y + (area.height * zoom)) - scissor[1];
+
+		scissor[2] = roundf((std::max)(scissor[2], 0.f));
+		scissor[3] = roundf((std::max)(scissor[3], 0.f));
+	}
+
+	// an empty scissor still clips, nothing gets drawn until it's disabled
+	glCheck(glScissor(scissor[0], scissor[1], scissor[2], scissor[3]));
+	glCheck(glEnable(GL_SCISSOR_TEST));
+}
+
+void RenderTarget::disableScissor() {
+	glCheck(glDisable(GL_SCISSOR_TEST));
+}
+
 // ------------------------------------------------------
 
 glm::fvec2 RenderTarget::coordToWorldPos(glm::ivec2 windowCoord) {
@@ -360,24 +411,29 @@ void RenderTarget::applyBlend(const BlendMode& blend) const {
 
 }
 
-void RenderTarget::applyShader(const ShaderProgram* shader) const {
+bool RenderTarget::shaderChanged(const ShaderProgram* shader) const {
+	// a reloaded shader keeps its address but is a new gl program
+	return shader != previousRender->program
+		|| !hasShader
+		|| (shader && shader->getGeneration() != boundShaderGeneration);
+}
+
+void RenderTarget::applyShader(const ShaderProgram* shader) {
 
 	if (shader != nullptr) {
 		shader->use();
+		boundShaderGeneration = shader->getGeneration();
 	}
 	else {
 		glCheck(glUseProgram(0));
+		boundShaderGeneration = 0;
 	}
 }
 
 void RenderTarget::applyUniforms(const Transform& transform, const RenderState& state) const {
-	if (auto uni = state.program->getUniform("model")) {
-		glCheck(glUniformMatrix3fv(uni->loc, 1, GL_FALSE, glm::value_ptr(transform.getMatrix())));
-	}
-	if (auto uni = state.program->getUniform("view")) {
-        auto mat = m_view.getMatrix();
-		glCheck(glUniformMatrix3fv(uni->loc, 1, GL_FALSE, glm::value_ptr(mat)));
-	}
+	// unchanged values are skipped by the program's uniform cache
+	state.program->setUniform(model_uniform, transform.getMatrix());
+	state.program->setUniform(view_uniform, m_view.getMatrix());
 }
 
 void RenderTarget::applyTexture(const TextureRef& texture) const {
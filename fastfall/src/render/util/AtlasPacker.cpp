@@ -0,0 +1,155 @@
+#include "fastfall/render/util/AtlasPacker.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+
+namespace ff {
+
+AtlasPacker::AtlasPacker(Vec2u t_page_size, unsigned t_padding)
+	: page_size{ t_page_size }
+	, pad{ t_padding }
+{
+}
+
+std::optional<AtlasRegion> AtlasPacker::insert(Vec2u size) {
+	if (size.x == 0 || size.y == 0 || size.x > page_size.x || size.y > page_size.y) {
+		return std::nullopt;
+	}
+
+	// padding goes on the right and bottom, it may hang off the page edge
+	Vec2i padded{ static_cast<int>(size.x + pad), static_cast<int>(size.y + pad) };
+
+	for (unsigned ndx = 0; ndx < pages.size(); ndx++) {
+		size_t segment;
+		if (auto pos = findPosition(pages[ndx], padded, segment)) {
+			place(pages[ndx], segment, *pos, padded);
+			pages[ndx].used_area += size.x * size.y;
+			return AtlasRegion{ ndx, Recti{ *pos, Vec2i{ size } } };
+		}
+	}
+
+	auto& page = pages.emplace_back();
+	page.skyline.push_back(Segment{ 0, 0, static_cast<int>(page_size.x + pad) });
+
+	size_t segment;
+	auto pos = findPosition(page, padded, segment);
+	assert(pos);
+	place(page, segment, *pos, padded);
+	page.used_area += size.x * size.y;
+	return AtlasRegion{ static_cast<unsigned>(pages.size() - 1), Recti{ *pos, Vec2i{ size } } };
+}
+
+std::vector<std::optional<AtlasRegion>> AtlasPacker::insert(std::span<const Vec2u> sizes) {
+	std::vector<size_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+		return sizes[lhs].y != sizes[rhs].y
+			? sizes[lhs].y > sizes[rhs].y
+			: sizes[lhs].x > sizes[rhs].x;
+	});
+
+	std::vector<std::optional<AtlasRegion>> regions(sizes.size());
+	for (auto ndx : order) {
+		regions[ndx] = insert(sizes[ndx]);
+	}
+	return regions;
+}
+
+void AtlasPacker::clear() {
+	pages.clear();
+}
+
+float AtlasPacker::occupancy(unsigned page) const {
+	if (page >= pages.size())
+		return 0.f;
+
+	return static_cast<float>(pages[page].used_area) / static_cast<float>(page_size.x * page_size.y);
+}
+
+std::optional<Vec2i> AtlasPacker::findPosition(const Page& page, Vec2i size, size_t& segment) const {
+	const int page_w = static_cast<int>(page_size.x + pad);
+	const int page_h = static_cast<int>(page_size.y + pad);
+
+	std::optional<Vec2i> best;
+	int best_bottom = page_h + 1;
+	int best_width = page_w + 1;
+
+	for (size_t i = 0; i < page.skyline.size(); i++) {
+		int x = page.skyline[i].x;
+		if (x + size.x > page_w)
+			break;
+
+		// rest on the highest segment spanned
+		int y = 0;
+		int remaining = size.x;
+		for (size_t j = i; remaining > 0; j++) {
+			y = std::max(y, page.skyline[j].y);
+			remaining -= page.skyline[j].width;
+		}
+
+		int bottom = y + size.y;
+		if (bottom > page_h)
+			continue;
+
+		if (bottom < best_bottom || (bottom == best_bottom && page.skyline[i].width < best_width)) {
+			best = Vec2i{ x, y };
+			best_bottom = bottom;
+			best_width = page.skyline[i].width;
+			segment = i;
+		}
+	}
+	return best;
+}
+
+void AtlasPacker::place(Page& page, size_t segment, Vec2i pos, Vec2i size) {
+	auto& skyline = page.skyline;
+	skyline.insert(skyline.begin() + segment, Segment{ pos.x, pos.y + size.y, size.x });
+
+	// trim the segments now under the new one
+	int right = pos.x + size.x;
+	for (size_t j = segment + 1; j < skyline.size(); ) {
+		if (skyline[j].x >= right)
+			break;
+
+		int overlap = right - skyline[j].x;
+		skyline[j].x += overlap;
+		skyline[j].width -= overlap;
+
+		if (skyline[j].width <= 0) {
+			skyline.erase(skyline.begin() + j);
+		}
+		else {
+			break;
+		}
+	}
+
+	// merge neighbours of equal height
+	for (size_t j = 0; j + 1 < skyline.size(); ) {
+		if (skyline[j].y == skyline[j + 1].y) {
+			skyline[j].width += skyline[j + 1].width;
+			skyline.erase(skyline.begin() + j + 1);
+		}
+		else {
+			j++;
+		}
+	}
+}
+
+void atlasBlit(std::span<uint8_t> page_pixels, Vec2u page_size, const AtlasRegion& region, const uint8_t* src_pixels, size_t src_pitch) {
+	constexpr size_t channels = 4;
+
+	assert(region.area.left >= 0 && region.area.top >= 0);
+	assert(static_cast<unsigned>(region.area.left + region.area.width)  <= page_size.x);
+	assert(static_cast<unsigned>(region.area.top  + region.area.height) <= page_size.y);
+	assert(page_pixels.size() >= (size_t)page_size.x * page_size.y * channels);
+
+	size_t row_bytes = (size_t)region.area.width * channels;
+	for (int row = 0; row < region.area.height; row++) {
+		size_t dst = (((size_t)region.area.top + row) * page_size.x + region.area.left) * channels;
+		std::memcpy(&page_pixels[dst], src_pixels + row * src_pitch, row_bytes);
+	}
+}
+
+}
@@ -5,7 +5,6 @@
 
 #include <vector>
 #include <algorithm>
-#include <bitset>
 #include <string_view>
 
 long get22_6p(long value)
@@ -19,46 +18,37 @@ long get16_16p(long value)
 }
 
 
-void draw_glyph(FT_Bitmap bm, SDL_Surface* surf, int x, int y)
+// writes a monochrome glyph straight into an RGBA32 surface
+void draw_glyph(const FT_Bitmap& bm, SDL_Surface* surf, int x, int y)
 {
 	if (bm.width == 0 || bm.rows == 0)
 	{
 		return;
 	}
 
-	std::vector<uint32_t> rgba((size_t)bm.rows * bm.width);
+	int width  = std::min((int)bm.width, surf->w - x);
+	int height = std::min((int)bm.rows, surf->h - y);
 
-	for (size_t y = 0; y < bm.rows; ++y)
+	auto* pixels = static_cast<uint8_t*>(surf->pixels);
+	for (int row = 0; row < height; ++row)
 	{
-		for (size_t x = 0; x < bm.width; ++x)
-		{
-			unsigned int c = (x / 8);
-
-			std::bitset<8> val = bm.buffer[c + (y * bm.pitch)];
+		const uint8_t* src = bm.buffer + (ptrdiff_t)row * bm.pitch;
+		auto* dst = reinterpret_cast<uint32_t*>(pixels + (size_t)(y + row) * surf->pitch) + x;
 
-			if ( val.test(7 - (x % 8)) ) {
-				rgba[(y * (size_t)bm.width) + x] = UINT32_MAX;
+		for (int col = 0; col < width; ++col)
+		{
+			if (src[col / 8] & (0x80 >> (col % 8))) {
+				dst[col] = UINT32_MAX;
 			}
 		}
 	}
-
-
-	SDL_Surface* glyph = SDL_CreateSurfaceFrom(
-		bm.width,
-		bm.rows,
-		SDL_PIXELFORMAT_RGBA8888,
-		rgba.data(),
-		bm.width
-	);
-
-	SDL_SetSurfaceBlendMode(glyph, SDL_BLENDMODE_BLEND);
-	SDL_Rect dest = { x, y, 0, 0 };
-	SDL_BlitSurface(glyph, nullptr, surf, &dest);
-	SDL_DestroySurface(glyph);
 }
 
 namespace ff {
 
+	TextureAtlas* Font::glyph_atlas = nullptr;
+	uint64_t Font::id_counter = 0;
+
 	Font::Font()
 	{
 	}
@@ -77,6 +67,7 @@ namespace ff {
 			LOG_ERR_("Failed to load face: {}", font_file);
 			return false;
 		}
+		m_id = ++id_counter;
 		return true;
 	}
 
@@ -89,6 +80,7 @@ namespace ff {
             LOG_ERR_("Failed to load face: {}", str.data());
             return false;
         }
+        m_id = ++id_counter;
         return true;
     }
 
@@ -101,6 +93,7 @@ namespace ff {
 			LOG_ERR_("Failed to load face from memory");
 			return false;
 		}
+		m_id = ++id_counter;
 		return true;
 	}
 
@@ -114,6 +107,7 @@ namespace ff {
 
 		caches.clear();
 		curr_cache = nullptr;
+		m_id = 0;
 	}
 
 
@@ -132,28 +126,28 @@ namespace ff {
 			return false;
 		}
 
-        //caches.begin();
-        //caches.end();
-
-		auto it = std::find_if(
-            caches.begin(),
-            caches.end(),
-           [&](auto& cache) {
-                return cache->px_size == pixel_size;
-            }
-        );
-
-		if (it != caches.end())
+		if (curr_cache && curr_cache->px_size == pixel_size)
 		{
-			curr_cache = it->get();
 			return true;
 		}
-		else
+
+		if (auto* cache = find_cache(pixel_size))
 		{
-			curr_cache = cache_for_size(pixel_size);
+			curr_cache = cache;
 			return true;
 		}
-		return false;
+
+		curr_cache = cache_for_size(pixel_size);
+		return curr_cache != nullptr;
+	}
+
+	Font::FontCache* Font::find_cache(unsigned size) const
+	{
+		// caches are sorted by pixel size
+		auto it = std::lower_bound(caches.begin(), caches.end(), size,
+			[](const auto& cache, unsigned size) { return cache->px_size < size; });
+
+		return it != caches.end() && (*it)->px_size == size ? it->get() : nullptr;
 	}
 
 
@@ -167,7 +161,7 @@ namespace ff {
 
 		auto& cache = *caches.insert(
 			std::lower_bound(caches.begin(), caches.end(), size,
-				[](const auto& cache, unsigned size) { return size > cache->px_size; }),
+				[](const auto& cache, unsigned size) { return cache->px_size < size; }),
 			std::make_unique<FontCache>(size)
 		);
 
@@ -216,6 +210,10 @@ namespace ff {
 		cache->yMax	 = get22_6p(m_face->bbox.yMax);
 		cache->height = get22_6p(FT_MulFix(m_face->units_per_EM, m_face->size->metrics.y_scale));
 
+		if (SDL_MUSTLOCK(cache->bitmap_surface)) {
+			SDL_LockSurface(cache->bitmap_surface);
+		}
+
 		for (unsigned i = 0; i < CHAR_COUNT; i++)
 		{
 			if (!FT_Load_Char(m_face, i, FT_LOAD_RENDER | FT_LOAD_TARGET_MONO))
@@ -230,26 +228,42 @@ namespace ff {
 			}
 		}
 
+		if (SDL_MUSTLOCK(cache->bitmap_surface)) {
+			SDL_UnlockSurface(cache->bitmap_surface);
+		}
+
 		cache->valid = true;
 		return cache.get();
 	}
 
-	void Font::loadBitmapTex(unsigned px_size) const
+	Font::Bitmap Font::getBitmap(unsigned px_size) const
 	{
-		auto it = std::find_if(caches.begin(), caches.end(), [&](auto& cache) {
-			return cache->px_size == px_size;
-			});
+		auto* cache = find_cache(px_size);
+		if (!cache)
+			return {};
 
-		FontCache* cache;
-		if (it != caches.end())
-		{
-			cache = it->get();
+		return Bitmap{ &cache->getTexture(), cache->getArea() };
+	}
 
+	void Font::loadBitmapTex(unsigned px_size) const
+	{
+		if (FontCache* cache = find_cache(px_size))
+		{
 			if (cache->valid 
 				&& cache->bitmap_surface 
-				&& !cache->bitmap_texture.exists()) 
+				&& !cache->bitmap_texture.exists()
+				&& !cache->atlas_page) 
 			{
-				if (!cache->bitmap_texture.loadFromSurface(cache->bitmap_surface))
+				if (glyph_atlas) {
+					if (auto region = glyph_atlas->add(cache->bitmap_surface)) {
+						glyph_atlas->upload();
+						cache->atlas_page = &glyph_atlas->getPage(region->page);
+						cache->atlas_area = region->area;
+					}
+				}
+
+				if (!cache->atlas_page 
+					&& !cache->bitmap_texture.loadFromSurface(cache->bitmap_surface))
 				{
 					LOG_ERR_("Failed to load texture from surface for font size");
 				}
@@ -4,7 +4,12 @@
 
 #include "fastfall/render/render.hpp"
 
+#include "glm/gtc/type_ptr.hpp"
+
 #include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 namespace ff {
 
@@ -80,19 +85,23 @@ ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept {
         glDeleteProgram(id);
     }
 
-    initialized = other.initialized;
-    m_is_linked = other.m_is_linked;
-    id          = other.id;
-    attributes  = other.attributes;
-    uniforms    = other.uniforms;
-    shaders     = std::move(other.shaders);
-
-    other.initialized = false;
-    other.m_is_linked = false;
-    other.id          = 0;
-    other.attributes  = {};
-    other.uniforms    = {};
-    other.shaders     = {};
+    initialized    = other.initialized;
+    m_is_linked    = other.m_is_linked;
+    id             = other.id;
+    generation     = other.generation;
+    attributes     = other.attributes;
+    uniforms       = other.uniforms;
+    shaders        = std::move(other.shaders);
+    uniform_lookup = std::move(other.uniform_lookup);
+
+    other.initialized    = false;
+    other.m_is_linked    = false;
+    other.id             = 0;
+    other.generation     = 0;
+    other.attributes     = {};
+    other.uniforms       = {};
+    other.shaders        = {};
+    other.uniform_lookup = {};
 }
 
 ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
@@ -106,19 +115,23 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
         glDeleteProgram(id);
     }
 
-    initialized = other.initialized;
-    m_is_linked = other.m_is_linked;
-    id          = other.id;
-    attributes  = other.attributes;
-    uniforms    = other.uniforms;
-    shaders     = std::move(other.shaders);
-
-    other.initialized = false;
-    other.m_is_linked = false;
-    other.id          = 0;
-    other.attributes  = {};
-    other.uniforms    = {};
-    other.shaders     = {};
+    initialized    = other.initialized;
+    m_is_linked    = other.m_is_linked;
+    id             = other.id;
+    generation     = other.generation;
+    attributes     = other.attributes;
+    uniforms       = other.uniforms;
+    shaders        = std::move(other.shaders);
+    uniform_lookup = std::move(other.uniform_lookup);
+
+    other.initialized    = false;
+    other.m_is_linked    = false;
+    other.id             = 0;
+    other.generation     = 0;
+    other.attributes     = {};
+    other.uniforms       = {};
+    other.shaders        = {};
+    other.uniform_lookup = {};
     return *this;
 }
 
@@ -234,6 +247,10 @@ void ShaderProgram::link() {
         uniforms.push_back({ i, location, type, name });
     }
 
+    static std::atomic<uint32_t> link_counter = 0;
+    generation = ++link_counter;
+    uniform_lookup.clear();
+
 	m_is_linked = true;
 }
 
@@ -258,6 +275,50 @@ const ShaderProgram::gl_uniform* ShaderProgram::getUniform(std::string_view name
     return (it != uniforms.end() ? &*it : nullptr);
 }
 
+namespace {
+    struct uniform_names_t {
+        std::mutex mutex;
+        std::vector<std::string> names;
+    };
+
+    // uniform ids may be created during static initialization
+    uniform_names_t& uniform_names() {
+        static uniform_names_t names;
+        return names;
+    }
+
+    std::string uniform_name(ShaderProgram::UniformID uniform_id) {
+        auto& registry = uniform_names();
+        std::lock_guard lock{ registry.mutex };
+        return registry.names[uniform_id];
+    }
+}
+
+ShaderProgram::UniformID ShaderProgram::uniformID(std::string_view name) {
+    auto& registry = uniform_names();
+    std::lock_guard lock{ registry.mutex };
+    auto& names = registry.names;
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end()) {
+        it = names.emplace(names.end(), name);
+    }
+    return static_cast<UniformID>(it - names.begin());
+}
+
+const ShaderProgram::gl_uniform* ShaderProgram::getUniform(UniformID uniform_id) const
+{
+    if (uniform_id >= uniform_lookup.size()) {
+        uniform_lookup.resize(uniform_id + 1, UniformUnresolved);
+    }
+
+    auto& ndx = uniform_lookup[uniform_id];
+    if (ndx == UniformUnresolved) {
+        auto* uni = getUniform(uniform_name(uniform_id));
+        ndx = uni ? static_cast<int16_t>(uni - uniforms.data()) : UniformMissing;
+    }
+    return ndx >= 0 ? &uniforms[ndx] : nullptr;
+}
+
 const ShaderProgram::gl_attribute* ShaderProgram::getAttribute(std::string_view name) const
 {
     auto it = std::find_if(attributes.begin(), attributes.end(),
@@ -265,6 +326,15 @@ const ShaderProgram::gl_attribute* ShaderProgram::getAttribute(std::string_view
     return (it != attributes.end() ? &*it : nullptr);
 }
 
+namespace detail {
+    void uploadUniform(GLint loc, GLint value)              { glCheck(glUniform1i(loc, value)); }
+    void uploadUniform(GLint loc, GLuint value)             { glCheck(glUniform1ui(loc, value)); }
+    void uploadUniform(GLint loc, float value)              { glCheck(glUniform1f(loc, value)); }
+    void uploadUniform(GLint loc, const glm::vec2& value)   { glCheck(glUniform2f(loc, value.x, value.y)); }
+    void uploadUniform(GLint loc, const glm::vec4& value)   { glCheck(glUniform4f(loc, value.x, value.y, value.z, value.w)); }
+    void uploadUniform(GLint loc, const glm::mat3& value)   { glCheck(glUniformMatrix3fv(loc, 1, GL_FALSE, glm::value_ptr(value))); }
+}
+
 std::string_view uniformTypeEnumToString(GLenum type) {
     switch (type) {
         case GL_FLOAT: return "float";
@@ -0,0 +1,181 @@
+#include "fastfall/render/util/TextLayout.hpp"
+
+#include "fastfall/render/util/Font.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+namespace ff {
+
+bool TextLayout::build(const Font& font, unsigned t_px_size, float t_v_spacing, std::string_view t_text)
+{
+	if (!font.setPixelSize(t_px_size)) {
+		clear();
+		return false;
+	}
+
+	// how much of the previous layout still applies
+	size_t keep = 0;
+	if (font_id == font.getId()
+		&& px_size == t_px_size
+		&& v_spacing == t_v_spacing
+		&& steps.size() == text.size() + 1)
+	{
+		keep = std::mismatch(text.begin(), text.end(), t_text.begin(), t_text.end()).first - text.begin();
+	}
+
+	font_id = font.getId();
+	px_size = t_px_size;
+	v_spacing = t_v_spacing;
+	text = t_text;
+
+	Vec2f pen = { 0.f, (float)font.getYMax() };
+	bounds = { 0, 0, 0, 0 };
+
+	if (keep > 0) {
+		const Step& step = steps[keep];
+		pen = step.pen;
+		bounds = step.bounds;
+		glyphs.resize(step.glyph_count);
+	}
+	else {
+		glyphs.clear();
+	}
+	steps.resize(keep);
+	steps.reserve(text.size() + 1);
+
+	unsigned space_width = font.getMetrics(' ').advance_x;
+
+	for (size_t i = keep; i < text.size(); i++)
+	{
+		steps.push_back({ pen, bounds, (uint32_t)glyphs.size() });
+
+		unsigned char ch = text[i];
+
+		if (ch >= 128)
+			continue;
+
+		if (ch == '\n') {
+			pen = Vec2f{ 0.f, pen.y + (font.getHeight() * v_spacing) };
+			continue;
+		}
+
+		if (ch == '\t') {
+			float x = 0.f;
+			while (x < pen.x + space_width)
+			{
+				x += 4.f * space_width;
+			}
+			pen.x = x;
+			continue;
+		}
+
+		if (ch == ' ') {
+			pen.x += space_width;
+			continue;
+		}
+
+		auto& metrics = font.getMetrics(ch);
+
+		glyphs.push_back({
+			.offset = {
+				pen.x + metrics.bearing.x,
+				pen.y - metrics.bearing.y
+			},
+			.character = ch,
+		});
+
+		pen.x += metrics.advance_x;
+
+		bounds = math::rect_bound(Rectf{
+				(float)pen.x + metrics.bearing.x,
+				(float)pen.y - font.getYMax(),
+				(float)metrics.size.x,
+				(float)font.getYMax() - font.getYMin()
+			}, bounds);
+	}
+	steps.push_back({ pen, bounds, (uint32_t)glyphs.size() });
+
+	return true;
+}
+
+void TextLayout::clear()
+{
+	font_id = 0;
+	px_size = 0;
+	text.clear();
+	glyphs.clear();
+	steps.clear();
+	bounds = { 0, 0, 0, 0 };
+}
+
+TextLayoutCache::TextLayoutCache(size_t t_capacity)
+	: max_entries{ std::max(t_capacity, size_t{ 1 }) }
+{
+	entries.reserve(max_entries);
+}
+
+uint64_t TextLayoutCache::hash(uint64_t font_id, unsigned px_size, float v_spacing, std::string_view text)
+{
+	uint64_t h = std::hash<std::string_view>{}(text);
+	auto combine = [&h](uint64_t v) {
+		h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+	};
+	combine(font_id);
+	combine(px_size);
+	combine(std::bit_cast<uint32_t>(v_spacing));
+	return h;
+}
+
+TextLayoutCache::Entry* TextLayoutCache::find_entry(uint64_t key, uint64_t font_id, unsigned px_size, float v_spacing, std::string_view text)
+{
+	for (auto& entry : entries) {
+		if (entry.key == key && entry.layout.matches(font_id, px_size, v_spacing, text)) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+const TextLayout* TextLayoutCache::find(uint64_t font_id, unsigned px_size, float v_spacing, std::string_view text)
+{
+	if (auto* entry = find_entry(hash(font_id, px_size, v_spacing, text), font_id, px_size, v_spacing, text)) {
+		entry->last_used = ++use_counter;
+		hit_count++;
+		return &entry->layout;
+	}
+	miss_count++;
+	return nullptr;
+}
+
+void TextLayoutCache::insert(const TextLayout& layout)
+{
+	uint64_t key = hash(layout.font_id, layout.px_size, layout.v_spacing, layout.text);
+
+	Entry* entry = find_entry(key, layout.font_id, layout.px_size, layout.v_spacing, layout.text);
+	if (!entry) {
+		if (entries.size() < max_entries) {
+			entry = &entries.emplace_back();
+		}
+		else {
+			// reuse the least recently used entry, along with its buffers
+			entry = &*std::min_element(entries.begin(), entries.end(),
+				[](const Entry& lhs, const Entry& rhs) { return lhs.last_used < rhs.last_used; });
+		}
+	}
+
+	entry->key = key;
+	entry->last_used = ++use_counter;
+	entry->layout = layout;
+}
+
+void TextLayoutCache::clear()
+{
+	entries.clear();
+	use_counter = 0;
+	hit_count = 0;
+	miss_count = 0;
+}
+
+}
@@ -126,6 +126,19 @@ bool Texture::loadFromSurface(const SDL_Surface* surface) {
 	return exists();
 }
 
+bool Texture::loadFromPixels(const void* rgba, glm::uvec2 size) {
+	return load(rgba, size.x, size.y, ImageFormat::PNG);
+}
+
+bool Texture::update(const void* rgba, glm::uvec2 offset, glm::uvec2 size) {
+	if (!exists() || offset.x + size.x > m_size.x || offset.y + size.y > m_size.y)
+		return false;
+
+	glCheck(glBindTexture(GL_TEXTURE_2D, texture_id));
+	glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, offset.x, offset.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, rgba));
+	return true;
+}
+
 bool Texture::load(const void* data, unsigned width, unsigned height, ImageFormat format) {
 	clear();
 	if (data) {
@@ -0,0 +1,113 @@
+#include "fastfall/render/util/TextureAtlas.hpp"
+
+#include "fastfall/util/log.hpp"
+
+#include "../detail/error.hpp"
+
+namespace ff {
+
+TextureAtlas::TextureAtlas(Vec2u page_size, unsigned padding)
+	: packer{ page_size, padding }
+{
+}
+
+std::optional<AtlasRegion> TextureAtlas::add(const SDL_Surface* surface) {
+	checkSDL(surface);
+	if (!surface)
+		return std::nullopt;
+
+	auto region = packer.insert(Vec2u{ (unsigned)surface->w, (unsigned)surface->h });
+	if (!region)
+		return std::nullopt;
+
+	while (pages.size() < packer.pageCount()) {
+		pages.emplace_back();
+	}
+
+	if (!copySurface(*region, surface)) {
+		// the space stays reserved, it's only reclaimed by clear()
+		return std::nullopt;
+	}
+	return region;
+}
+
+bool TextureAtlas::replace(const AtlasRegion& region, const SDL_Surface* surface) {
+	checkSDL(surface);
+	if (!surface
+		|| region.page >= pages.size()
+		|| region.area.width != surface->w
+		|| region.area.height != surface->h)
+	{
+		return false;
+	}
+	return copySurface(region, surface);
+}
+
+void TextureAtlas::upload() {
+	for (auto& page : pages) {
+		if (!page.pixels.empty()) {
+			if (!page.texture.loadFromPixels(page.pixels.data(), glm::uvec2{ packer.pageSize() })) {
+				LOG_ERR_("Failed to upload atlas page");
+			}
+			page.pixels.clear();
+			page.pixels.shrink_to_fit();
+		}
+	}
+}
+
+void TextureAtlas::clear() {
+	packer.clear();
+	pages.clear();
+}
+
+bool TextureAtlas::copySurface(const AtlasRegion& region, const SDL_Surface* surface) {
+	SDL_Surface* src = const_cast<SDL_Surface*>(surface);
+	SDL_Surface* converted = nullptr;
+	if (src->format != SDL_PIXELFORMAT_RGBA32) {
+		converted = SDL_ConvertSurface(src, SDL_PIXELFORMAT_RGBA32);
+		checkSDL(converted);
+		if (!converted)
+			return false;
+		src = converted;
+	}
+
+	if (SDL_MUSTLOCK(src)) {
+		SDL_LockSurface(src);
+	}
+
+	auto& page = pages[region.page];
+	Vec2u page_size = packer.pageSize();
+	const auto* src_pixels = static_cast<const uint8_t*>(src->pixels);
+	size_t row_bytes = (size_t)src->w * 4;
+
+	if (page.texture.exists()) {
+		glm::uvec2 offset{ (unsigned)region.area.left, (unsigned)region.area.top };
+		glm::uvec2 size{ (unsigned)region.area.width, (unsigned)region.area.height };
+
+		if ((size_t)src->pitch == row_bytes) {
+			page.texture.update(src_pixels, offset, size);
+		}
+		else {
+			std::vector<uint8_t> tight(row_bytes * src->h);
+			AtlasRegion local{ 0, Recti{ 0, 0, src->w, src->h } };
+			atlasBlit(tight, Vec2u{ (unsigned)src->w, (unsigned)src->h }, local, src_pixels, src->pitch);
+			page.texture.update(tight.data(), offset, size);
+		}
+	}
+	else {
+		if (page.pixels.empty()) {
+			page.pixels.resize((size_t)page_size.x * page_size.y * 4, 0);
+		}
+		atlasBlit(page.pixels, page_size, region, src_pixels, src->pitch);
+	}
+
+	if (SDL_MUSTLOCK(src)) {
+		SDL_UnlockSurface(src);
+	}
+	if (converted) {
+		SDL_DestroySurface(converted);
+	}
+	return true;
+}
+
+}
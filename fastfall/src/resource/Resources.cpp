@@ -5,6 +5,7 @@
 #include "rapidxml/rapidxml.hpp"
 using namespace rapidxml;
 
+#include <algorithm>
 #include <mutex>
 #include <future>
 
@@ -55,6 +56,7 @@ bool Resources::loadAll(std::filesystem::path root) {
     resource.for_each_asset_type([]<is_asset T>(asset_type<T>& type) {
         type.assets.clear();
     });
+    resource.generation++;
     result = resource.loadAssetsFromDirectory( root );
     if (result) {
         loadControllerDB();
@@ -66,6 +68,9 @@ void Resources::unloadAll()
     resource.for_each_asset_type([]<is_asset T>(asset_type<T>& type) {
         type.assets.clear();
     });
+    resource.generation++;
+    Font::setGlyphAtlas(nullptr);
+    resource.atlas.clear();
 	AnimID::resetCounter();
 	Texture::destroyNullTexture();
     AnimDB::reset();
@@ -78,6 +83,9 @@ bool Resources::loadAssetsFromDirectory(const std::filesystem::path& asset_dir)
     for_each_asset_type([&]<is_asset T>(asset_type<T>& type) {
         type.assets.clear();
     });
+    generation++;
+    atlas.clear();
+    Font::setGlyphAtlas(&atlas);
 
     namespace fs = std::filesystem;
 
@@ -108,6 +116,7 @@ bool Resources::loadAssetsFromDirectory(const std::filesystem::path& asset_dir)
             });
         }
     }
+    generation++;
 
 	LOG_INFO("Loading assets");
     LOG_INFO("");
@@ -135,9 +144,37 @@ bool Resources::loadAssetsFromDirectory(const std::filesystem::path& asset_dir)
         LOG_INFO("");
     });
 
+    packTextures();
+    for (unsigned page = 0; page < atlas.pageCount(); page++) {
+        LOG_INFO("Texture atlas page {}: {:.1f}% used", page, atlas.occupancy(page) * 100.f);
+    }
+
 	return r;
 }
 
+void Resources::packTextures()
+{
+    std::vector<TextureAsset*> pending;
+    for (auto& [name, asset] : sprites.assets) {
+        if (asset->hasUnpackedImage())
+            pending.push_back(asset.get());
+    }
+    for (auto& [name, asset] : tilesets.assets) {
+        if (asset->hasUnpackedImage())
+            pending.push_back(asset.get());
+    }
+
+    // tallest first packs tighter
+    std::stable_sort(pending.begin(), pending.end(), [](const TextureAsset* lhs, const TextureAsset* rhs) {
+        return lhs->getImageSize().y > rhs->getImageSize().y;
+    });
+
+    for (auto* asset : pending) {
+        asset->packIntoAtlas(atlas);
+    }
+    atlas.upload();
+}
+
 void Resources::ImGui_getContent(secs deltaTime) {
 	if (ImGui::CollapsingHeader("Sprites", ImGuiTreeNodeFlags_DefaultOpen)) {
 		for (auto& [name, asset] : sprites.assets) {
@@ -220,6 +257,10 @@ bool Resources::reloadOutOfDateAssets()
         }
     });
 
+    if (!assets_changed.empty()) {
+        resource.packTextures();
+    }
+
 	for (auto asset : assets_changed) {
         auto& all_subs = ResourceSubscriber::get_asset_subscriptions();
 		for (auto subscriber : all_subs) {
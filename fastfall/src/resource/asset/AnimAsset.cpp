@@ -20,4 +20,9 @@ const Texture& Animation::get_sprite_texture() const noexcept {
 	return my_sprite->getTexture();
 }
 
+Recti Animation::get_texture_area() const noexcept {
+	auto sprite_area = my_sprite->getTextureArea();
+	return Recti{ area.left + sprite_area.left, area.top + sprite_area.top, area.width, area.height };
+}
+
 }
@@ -1,4 +1,5 @@
 #include "fastfall/resource/asset/ShaderAsset.hpp"
+#include "fastfall/resource/Resources.hpp"
 #include "fastfall/util/log.hpp"
 
 #include <fstream>
@@ -100,5 +101,12 @@ bool ShaderAsset::compileShaderFromFile()
     return program.isLinked();
 }
 
+const ShaderProgram* ShaderHandle::get() const {
+    if (resources_generation != Resources::getGeneration()) {
+        asset = Resources::get<ShaderAsset>(name);
+        resources_generation = Resources::getGeneration();
+    }
+    return asset ? &asset->getProgram() : nullptr;
 }
 
+}
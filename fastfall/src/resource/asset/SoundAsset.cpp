@@ -1,6 +1,7 @@
 #include "fastfall/resource/asset/SoundAsset.hpp"
 
 #include "fastfall/engine/audio.hpp"
+#include "fastfall/resource/Resources.hpp"
 #include <SDL3_mixer/SDL_mixer.h>
 
 #include "fastfall/util/log.hpp"
@@ -48,4 +49,12 @@ std::vector<std::filesystem::path> SoundAsset::getDependencies() const {
     return { asset_path };
 }
 
+const SoundAsset* SoundRef::get() const {
+    if (resources_generation != Resources::getGeneration()) {
+        asset = Resources::get<SoundAsset>(name);
+        resources_generation = Resources::getGeneration();
+    }
+    return asset;
+}
+
 }
@@ -370,7 +370,7 @@ void SpriteAsset::ImGui_getContent(secs deltaTime) {
 
 				if (ImGui::BeginTabItem("Texture"))
 				{
-					ImGui::Image(tex.getID(), ImVec2(tex.size().x, tex.size().y));
+					ImGui_image();
 					ImGui::EndTabItem();
 				}
 				ImGui::EndTabBar();
@@ -1,6 +1,8 @@
 
 //#include "fastfall/resource/Resources.hpp"
 #include "fastfall/resource/asset/TextureAsset.hpp"
+#include "fastfall/util/log.hpp"
+
 #include "imgui.h"
 
 //#include "ImGui-SFML/imgui-SFML.h"
@@ -22,29 +24,59 @@ void TextureAsset::set_texture_path(const std::filesystem::path& t_tex_path) {
     texture_path = t_tex_path;
 }
 
-bool TextureAsset::loadFromFile() {
-	if (loaded) {
-		ff::Texture n_tex;
-		bool n_loaded = n_tex.loadFromFile(texture_path);
-		if (n_loaded) {
-			tex = std::move(n_tex);
-		}
-	}
-	else {
-		loaded = tex.loadFromFile(texture_path);
+bool TextureAsset::loadImage() {
+	std::string path = texture_path.generic_string();
+	std::unique_ptr<SDL_Surface, SurfaceDeleter> n_image{ IMG_Load(path.c_str()) };
+	if (!n_image) {
+		LOG_ERR_("Failed to load image {}: {}", path, SDL_GetError());
+		return false;
 	}
 
+	// uploaded once packed, to the atlas or to its own texture if it doesn't fit
+	image = std::move(n_image);
+	image_size = Vec2u{ (unsigned)image->w, (unsigned)image->h };
+	return true;
+}
+
+bool TextureAsset::loadFromFile() {
+	bool n_loaded = loadImage();
+	if (!loaded) {
+		loaded = n_loaded;
+	}
 	return loaded;
 }
 
 bool TextureAsset::reloadFromFile() {
+	return loadImage();
+}
 
-	ff::Texture n_tex;
-	bool n_loaded = n_tex.loadFromFile(texture_path);
-	if (n_loaded) {
-		tex = std::move(n_tex);
+Recti TextureAsset::getTextureArea() const noexcept {
+	return atlas_region ? atlas_region->area : Recti{ Vec2i{}, Vec2i{ image_size } };
+}
+
+void TextureAsset::packIntoAtlas(TextureAtlas& atlas) {
+	if (!image)
+		return;
+
+	if (atlas_region
+		&& packed_atlas == &atlas
+		&& atlas.replace(*atlas_region, image.get()))
+	{
+		// reloaded in place
+	}
+	else {
+		// a resized image gets a new region, the old one isn't reclaimed until the atlas is cleared
+		atlas_region = atlas.add(image.get());
+		packed_atlas = atlas_region ? &atlas : nullptr;
+	}
+
+	if (atlas_region) {
+		tex.clear();
+	}
+	else if (!tex.loadFromSurface(image.get())) {
+		LOG_ERR_("Failed to upload image {}", texture_path.generic_string());
 	}
-	return n_loaded;
+	image.reset();
 }
 
 void TextureAsset::ImGui_getContent(secs deltaTime) {
@@ -57,11 +89,19 @@ void TextureAsset::ImGui_getContent(secs deltaTime) {
 	if (imgui_showTex) {
 		if (ImGui::Begin(imgui_title.c_str(), &imgui_showTex)) {
 			
-			ImGui::Image(tex.getID(), ImVec2(tex.size().x, tex.size().y));
+			ImGui_image();
 
 			ImGui::End();
 		}
 	}
 }
 
-}
\ No newline at end of file
+void TextureAsset::ImGui_image() const {
+	const Texture& page = getTexture();
+	Rectf area{ getTextureArea() };
+	ImVec2 uv0 = { area.left * page.inverseSize().x, area.top * page.inverseSize().y };
+	ImVec2 uv1 = { (area.left + area.width) * page.inverseSize().x, (area.top + area.height) * page.inverseSize().y };
+	ImGui::Image(page.getID(), ImVec2(area.width, area.height), uv0, uv1);
+}
+
+}
@@ -67,13 +67,16 @@ void TileLayerData::resize(Vec2u size, Vec2i offset) {
 
 	if (old_area.intersects(new_area, intersection))
 	{
-		for (auto& tile : tiles.take_view(intersection.getPosition(), intersection.getSize()))
+		auto view = tiles.take_view(intersection.getPosition(), intersection.getSize());
+		for (auto it = view.cbegin(); it != view.cend(); ++it)
 		{
-			if (!tile.has_tile)
+			if (!it->has_tile())
 				continue;
 
-			n_data.setTile(tile.pos + offset, tile.tile_id, *tilesets[tile.tileset_ndx].tileset);
+			Vec2i pos = intersection.getPosition() + Vec2i{ (int)it.column(), (int)it.row() };
+			n_data.placeTile(Vec2u{ pos + offset }, getBaseID(*it), *tilesets[it->tileset_ndx].tileset);
 		}
+		n_data.solveAutotiles(Recti{ {}, Vec2i{ size } });
 	}
 
 	*this = std::move(n_data);
@@ -116,6 +119,17 @@ void TileLayerData::setCollision(bool enabled, unsigned border)
 }
 
 TileLayerData::TileChangeResult TileLayerData::setTile(Vec2u at, TileID tile_id, const TilesetAsset& tileset) {
+	TileChangeResult result = placeTile(at, tile_id, tileset);
+	if (tiles[at].is_autotile()) {
+		solveAutotiles(Recti{ Vec2i{ at }, { 1, 1 } });
+	}
+	if (result.shape_changed) {
+		solveAutotiles(Recti{ Vec2i{ at } - Vec2i{ 1, 1 }, { 3, 3 } }, &result.changes);
+	}
+	return result;
+}
+
+TileLayerData::TileChangeResult TileLayerData::placeTile(Vec2u at, TileID tile_id, const TilesetAsset& tileset) {
 	assert(at.x < tileSize.x && at.y < tileSize.y);
 	TileChangeResult result;
 
@@ -140,49 +154,37 @@ TileLayerData::TileChangeResult TileLayerData::setTile(Vec2u at, TileID tile_id,
 	if (!tile) {
         // empty tile
 		result.changes.push({ prev_tileset_ndx, nullptr, at });
-		setShape(at, TileShape{}, result.changes);
+		result.shape_changed = setShape(at, TileShape{});
 		tiles[at] = TileData{};
 	}
     else {
-
-        TileID placed_tiled_id = tile->id;
-        if (tile->auto_substitute) {
-            unsigned rseed = (at.x + at.y * getSize().x);
-            TileState state;
-            auto shapes_view = shapes.take_view(
-                    { 0, 0 },
-                    (hasParallax() ? getParallaxSize() : getSize())
-                );
-
-            if (hasScrolling()) {
-                state = get_autotile_state(tile->shape, shapes_view, at, AUTOTILE_GRID_WRAP{});
-            } else {
-                state = get_autotile_state(tile->shape, shapes_view, at, autotile_default);
-            }
-            auto opt_tile_id = auto_best_tile(state, tileset.getConstraints(), rseed);
-            placed_tiled_id = opt_tile_id.value_or(placed_tiled_id);
-        }
-
+        // autotiles are placed as their base tile until solved
         result.changes.push({ prev_tileset_ndx, &tileset, at });
-        setShape(at, tile->shape, result.changes);
+        result.shape_changed = setShape(at, tile->shape);
         tiles[at] = TileData{
-            .has_tile       = true,
-            .is_autotile    = tile->auto_substitute,
-            .pos            = at,
-            .base_id        = tile->id,
-            .tile_id        = placed_tiled_id,
-            .tileset_ndx    = tileset_ndx
+            .tile_id        = tile->id,
+            .tileset_ndx    = tileset_ndx,
+            .autotile_ndx   = tile->auto_substitute ? autotileNdx(tile->id) : (uint8_t)UINT8_MAX
         };
     }
     return result;
 }
 
 TileLayerData::TileChangeResult TileLayerData::removeTile(Vec2u at)
+{
+	TileChangeResult result = clearTile(at);
+	if (result.shape_changed) {
+		solveAutotiles(Recti{ Vec2i{ at } - Vec2i{ 1, 1 }, { 3, 3 } }, &result.changes);
+	}
+	return result;
+}
+
+TileLayerData::TileChangeResult TileLayerData::clearTile(Vec2u at)
 {
 	assert(at.x < tileSize.x&& at.y < tileSize.y);
 	TileChangeResult result;
 	if (TileData& tile = tiles[at];
-        tile.has_tile)
+        tile.has_tile())
 	{
         auto [prev_tileset_ndx, count] = decrTileset(tile.tileset_ndx);
         if (count == 0) {
@@ -192,13 +194,14 @@ TileLayerData::TileChangeResult TileLayerData::removeTile(Vec2u at)
 
 		tile = TileData{};
         result.changes.push({ prev_tileset_ndx, nullptr, at });
-		setShape(at, TileShape{}, result.changes);
+		result.shape_changed = setShape(at, TileShape{});
 	}
 	return result;
 }
 
 void TileLayerData::clearTiles() {
 	tilesets.clear();
+	autotile_bases.clear();
 	tiles = grid_vector<TileData>(tileSize);
 	shapes = grid_vector<TileShape>(tileSize);
 }
@@ -258,65 +261,86 @@ TileLayerData::tileset_state_t TileLayerData::decrTileset(uint8_t asset_ndx) {
     }
 }
 
-void TileLayerData::setShape(Vec2u at, TileShape shape, TileChangeArray& changes) {
+uint8_t TileLayerData::autotileNdx(TileID base_id) {
+    auto it = std::find(autotile_bases.begin(), autotile_bases.end(), base_id);
+    if (it != autotile_bases.end()) {
+        return std::distance(autotile_bases.begin(), it);
+    }
+    else if (autotile_bases.size() < UINT8_MAX) {
+        autotile_bases.push_back(base_id);
+        return autotile_bases.size() - 1;
+    }
+    LOG_ERR_("autotile max reached for layer: {}, tile placed without autotiling", autotile_bases.size());
+    return UINT8_MAX;
+}
 
-	if (shapes[at] != shape)
-	{
+bool TileLayerData::setShape(Vec2u at, TileShape shape) {
+	if (shapes[at] != shape) {
 		shapes[at] = shape;
+		return true;
+	}
+	return false;
+}
 
-		auto update_adj_tile = [&](auto dir) {
-			Vec2i vdir = direction::to_vector<int>(dir);
-			Vec2u adj_at;
+template<class OnChange>
+void TileLayerData::solveAutotilesImpl(Recti area, OnChange&& on_change) {
+	auto shapes_view = shapes.take_view({ 0, 0 },
+		hasParallax() ? getParallaxSize() : getSize());
 
-			auto shapes_view = shapes.take_view({ 0, 0 },
-				hasParallax() ? getParallaxSize() : getSize());
+	Recti grid_area{ {}, Vec2i{ (int)shapes_view.column_count(), (int)shapes_view.row_count() } };
+	if (grid_area.width <= 0 || grid_area.height <= 0)
+		return;
 
-			if (hasScrolling()) {
-				adj_at = at;
-				if (vdir.x < 0 && adj_at.x == 0) adj_at.x += shapes_view.column_count();
-				if (vdir.y < 0 && adj_at.y == 0) adj_at.y += shapes_view.row_count();
-				adj_at += vdir;
-				adj_at.x %= shapes_view.column_count();
-				adj_at.y %= shapes_view.row_count();
-			}
-			else {
-				adj_at = at + vdir;
-			}
+	// scrolling layers wrap around, so their neighbors may be on the other side
+	AutoTileOffGridSubstitute offgrid = autotile_default;
+	if (hasScrolling()) {
+		offgrid = AUTOTILE_GRID_WRAP{};
+	}
+	else if (!grid_area.intersects(area, area)) {
+		return;
+	}
 
+	std::vector<TileState> states;
+	get_autotile_states(shapes_view, area, offgrid, states);
 
-			if (tiles.valid(adj_at) && tiles[adj_at].is_autotile) {
-				unsigned rseed = (adj_at.x + adj_at.y * getSize().x);
-                auto prev_tileset_ndx = tiles[adj_at].tileset_ndx;
-				const TilesetAsset* tileset_ptr = tilesets[tiles[adj_at].tileset_ndx].tileset;
+	for (int y = 0; y < area.height; y++) {
+		for (int x = 0; x < area.width; x++) {
+			Vec2u pos{
+				(unsigned)(((area.left + x) % grid_area.width + grid_area.width) % grid_area.width),
+				(unsigned)(((area.top + y) % grid_area.height + grid_area.height) % grid_area.height)
+			};
 
-				TileState state;
-				if (hasScrolling()) {
-					state = get_autotile_state(shapes_view[adj_at], shapes_view, adj_at, AUTOTILE_GRID_WRAP{});
-				}
-				else {
-					state = get_autotile_state(shapes_view[adj_at], shapes_view, adj_at, autotile_default);
-				}
+			TileData& tile = tiles[pos];
+			if (!tile.is_autotile())
+				continue;
 
-				auto opt_tile_id = auto_best_tile(state, tileset_ptr->getConstraints(), rseed);
+			unsigned rseed = (pos.x + pos.y * getSize().x);
+			const TilesetAsset* tileset_ptr = tilesets[tile.tileset_ndx].tileset;
+			auto opt_tile_id = tileset_ptr->getAutotileTable().best_tile(states[y * area.width + x], rseed);
 
-				if (opt_tile_id)
-				{
-					tiles[adj_at].tile_id = *opt_tile_id;
-					changes.push({ prev_tileset_ndx, tileset_ptr, adj_at });
-				}
-				
+			if (opt_tile_id && *opt_tile_id != tile.tile_id)
+			{
+				tile.tile_id = *opt_tile_id;
+				on_change(TileChange{ tile.tileset_ndx, tileset_ptr, pos });
 			}
-		};
-
-		for (auto dir : direction::cardinals) {
-			update_adj_tile(dir);
-		}
-		for (auto dir : direction::ordinals) {
-			update_adj_tile(dir);
 		}
 	}
 }
 
+void TileLayerData::solveAutotiles(Recti area, TileChangeArray* changes) {
+	solveAutotilesImpl(area, [changes](TileChange change) {
+		if (changes) {
+			changes->push(change);
+		}
+	});
+}
+
+void TileLayerData::solveAutotiles(Recti area, std::vector<TileChange>& changes) {
+	solveAutotilesImpl(area, [&changes](TileChange change) {
+		changes.push_back(change);
+	});
+}
+
 // SERIALIZATION
 
 TileLayerData TileLayerData::loadFromTMX(xml_node<>* layerNode, const TilesetMap& tilesets)
@@ -456,7 +480,7 @@ TileLayerData TileLayerData::loadFromTMX(xml_node<>* layerNode, const TilesetMap
 
 				TileID texture_pos{ (tilesetgid - it->first) % columns, (tilesetgid - it->first) / columns };
 
-				layer.setTile(tilepos, texture_pos, *tileAsset);
+				layer.placeTile(tilepos, texture_pos, *tileAsset);
 			}
 
 			tilepos.x++;
@@ -465,6 +489,9 @@ TileLayerData TileLayerData::loadFromTMX(xml_node<>* layerNode, const TilesetMap
 				tilepos.y++;
 			}
 		}
+
+		// autotile the whole layer in one pass, rather than per tile as it's placed
+		layer.solveAutotiles(Recti{ {}, Vec2i{ layer.tileSize } });
 	}
 	return layer;
 }
@@ -334,7 +334,7 @@ void TilesetAsset::loadFromFile_Header(xml_node<>* tileset_node)
 	if (!TextureAsset::loadFromFile())
 		throw parse_error("could not load sprite source", nullptr);
 
-	texTileSize = Vec2u(tex.size()) / TILESIZE;
+	texTileSize = image_size / TILESIZE;
 
 	if (texTileSize.x > TileID::dimension_max 
 		|| texTileSize.y > TileID::dimension_max)
@@ -368,6 +368,7 @@ bool TilesetAsset::loadFromFile() {
 	tileLogic.clear();
 	tileMat.clear();
 	constraints.clear();
+	autotileTable = AutotileTable{};
 	auto_shape_cache.clear();
 
 	texTileSize = Vec2u{};
@@ -395,6 +396,8 @@ bool TilesetAsset::loadFromFile() {
 				loadFromFile_Tile(tileNode);
 				tileNode = tileNode->next_sibling();
 			}
+
+			autotileTable = AutotileTable{ constraints };
 		}
 		catch (parse_error& err) {
 			std::cout << asset_path << ": " << err.what() << std::endl;
@@ -416,6 +419,10 @@ bool TilesetAsset::reloadFromFile() {
 		TilesetAsset n_tile{ asset_path };
 		
 		if (n_tile.loadFromFile()) {
+			// keep our atlas region so the repack can overwrite it in place
+			n_tile.packed_atlas = packed_atlas;
+			n_tile.atlas_region = atlas_region;
+
 			*this = std::move(n_tile);
 			for (auto& tile_data : tiles)
 			{
@@ -0,0 +1,68 @@
+#include "fastfall/util/alloc.hpp"
+
+#include <atomic>
+
+namespace ff::alloc {
+
+namespace {
+    // constant initialized, allocations may happen before dynamic initialization
+    struct {
+        std::atomic<bool> hooked = false;
+        std::atomic<bool> enabled = false;
+        std::atomic<uint64_t> count = 0;
+        std::atomic<uint64_t> bytes = 0;
+    } state;
+
+    thread_local Scope* current_scope = nullptr;
+}
+
+void detail::track(size_t size) {
+    if (!state.enabled.load(std::memory_order_relaxed))
+        return;
+
+    state.count.fetch_add(1, std::memory_order_relaxed);
+    state.bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (current_scope) {
+        current_scope->totals.count++;
+        current_scope->totals.bytes += size;
+    }
+}
+
+void detail::set_hook_installed() {
+    state.hooked = true;
+}
+
+bool hook_installed() {
+    return state.hooked;
+}
+
+void set_enabled(bool enabled) {
+    state.enabled = enabled;
+}
+
+bool is_enabled() {
+    return state.enabled;
+}
+
+Stats global_stats() {
+    return {
+        .count = state.count.load(std::memory_order_relaxed),
+        .bytes = state.bytes.load(std::memory_order_relaxed)
+    };
+}
+
+Scope::Scope()
+    : parent(current_scope)
+{
+    current_scope = this;
+}
+
+Scope::~Scope() {
+    current_scope = parent;
+    if (parent) {
+        parent->totals += totals;
+    }
+}
+
+}
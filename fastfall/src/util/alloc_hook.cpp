@@ -0,0 +1,79 @@
+// replaces the global operator new to count allocations, see fastfall/util/alloc.hpp
+// built as its own object library rather than into fastfall, so only what links fastfall_alloc_hook is hooked
+
+#include "fastfall/util/alloc.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace {
+
+    // lets hook_installed() know this file was linked in
+    [[maybe_unused]] const bool registered = (ff::alloc::detail::set_hook_installed(), true);
+
+    void* tracked_alloc(std::size_t size) {
+        ff::alloc::detail::track(size);
+        if (size == 0)
+            size = 1;
+        return std::malloc(size);
+    }
+
+    void* tracked_alloc(std::size_t size, std::align_val_t align) {
+        ff::alloc::detail::track(size);
+        if (size == 0)
+            size = 1;
+        auto alignment = static_cast<std::size_t>(align);
+#if defined(_WIN32)
+        return _aligned_malloc(size, alignment);
+#else
+        // aligned_alloc requires size to be a multiple of the alignment
+        return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+    }
+
+    void tracked_free(void* ptr) noexcept {
+        std::free(ptr);
+    }
+
+    void tracked_free(void* ptr, std::align_val_t) noexcept {
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    template<class... Align>
+    void* throwing_alloc(std::size_t size, Align... align) {
+        void* ptr = tracked_alloc(size, align...);
+        if (!ptr)
+            throw std::bad_alloc{};
+        return ptr;
+    }
+}
+
+void* operator new(std::size_t size)                                        { return throwing_alloc(size); }
+void* operator new[](std::size_t size)                                      { return throwing_alloc(size); }
+void* operator new(std::size_t size, std::align_val_t align)                { return throwing_alloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align)              { return throwing_alloc(size, align); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept        { return tracked_alloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept      { return tracked_alloc(size); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept   { return tracked_alloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return tracked_alloc(size, align); }
+
+void operator delete(void* ptr) noexcept                                    { tracked_free(ptr); }
+void operator delete[](void* ptr) noexcept                                  { tracked_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept                       { tracked_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept                     { tracked_free(ptr); }
+void operator delete(void* ptr, std::align_val_t align) noexcept            { tracked_free(ptr, align); }
+void operator delete[](void* ptr, std::align_val_t align) noexcept          { tracked_free(ptr, align); }
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept   { tracked_free(ptr, align); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t align) noexcept { tracked_free(ptr, align); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept             { tracked_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept           { tracked_free(ptr); }
+void operator delete(void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept   { tracked_free(ptr, align); }
+void operator delete[](void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept { tracked_free(ptr, align); }
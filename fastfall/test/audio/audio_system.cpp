@@ -4,43 +4,173 @@
 #include "fastfall/engine/audio.hpp"
 #include "fastfall/resource/asset/SoundAsset.hpp"
 #include "fastfall/game/systems/AudioSystem.hpp"
-#include "soloud_speech.h"
 
-#include <thread>
+#include <SDL3/SDL.h>
+
+#include <vector>
 
 using namespace ff;
 
+class audio_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // no output device needed
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+        ASSERT_TRUE(audio::init());
+    }
+
+    void TearDown() override {
+        audio::quit();
+    }
+};
 
-TEST(audio, init)
+TEST_F(audio_test, init)
 {
-    audio::init(audio::AudioBackends::Null);
     EXPECT_TRUE(audio::is_init());
-    audio::quit();
-    EXPECT_TRUE(!audio::is_init());
+    EXPECT_EQ(audio::free_voice_count(), audio::voice_count);
 }
 
-TEST(audio, system)
+TEST_F(audio_test, pool_exhaustion)
 {
-    using namespace std::chrono_literals;
-    audio::init(audio::AudioBackends::SDL2);
+    std::vector<SoundHandle> held;
+    for (uint32_t i = 0; i < audio::voice_count; i++) {
+        held.emplace_back();
+        EXPECT_TRUE(held.back().valid());
+    }
+    EXPECT_EQ(audio::free_voice_count(), 0);
+
+    // held voices are never stolen
+    SoundHandle extra{ SoundCfg{ .priority = 100 } };
+    EXPECT_FALSE(extra.valid());
 
+    held.pop_back();
+    EXPECT_EQ(audio::free_voice_count(), 1);
+
+    SoundHandle reused;
+    EXPECT_TRUE(reused.valid());
+}
+
+TEST_F(audio_test, voice_stealing)
+{
     SoundAsset sound{ "data/Bump.wav" };
-    if (!sound.loadFromFile()) {
-        LOG_ERR_("Failed to load {}", "data/Bump.wav");
+    ASSERT_TRUE(sound.loadFromFile());
+
+    // fill the pool with released, looping sounds
+    for (uint32_t i = 0; i < audio::voice_count; i++) {
+        SoundHandle handle{ SoundCfg{ .distance = (float)i, .loops = -1 } };
+        ASSERT_TRUE(handle.valid());
+        handle.set_sound(sound);
+        handle.play();
     }
+    audio::process_commands();
+    EXPECT_EQ(audio::free_voice_count(), 0);
+
+    SoundHandle important{ SoundCfg{ .priority = 1 } };
+    EXPECT_TRUE(important.valid());
+    EXPECT_EQ(audio::voices_stolen(), 1);
 
-    AudioSystem sys{ &audio::primary_bus() };
+    SoundHandle unimportant{ SoundCfg{ .priority = -1 } };
+    EXPECT_FALSE(unimportant.valid());
 
-    for (int v = 100; v > 0; v -= 10) {
-        sys.play(sound,
-                 audio::Volume{ (float)v * 0.01f },
-                 audio::Pan{ -1.f + ((float)v / 50.f) }
-                 );
+    // further than every playing sound
+    SoundHandle distant{ SoundCfg{ .distance = 1000.f } };
+    EXPECT_FALSE(distant.valid());
+
+    SoundHandle near{ SoundCfg{ .distance = 0.f } };
+    EXPECT_TRUE(near.valid());
+    EXPECT_EQ(audio::voices_stolen(), 2);
+}
+
+TEST_F(audio_test, command_queue)
+{
+    SoundAsset sound{ "data/Bump.wav" };
+    ASSERT_TRUE(sound.loadFromFile());
+
+    SoundHandle handle;
+    ASSERT_TRUE(handle.valid());
+    EXPECT_TRUE(handle.set_sound(sound));
+    EXPECT_TRUE(handle.play());
+
+    // nothing reaches the mixer until processed
+    EXPECT_EQ(audio::pending_commands(), 2);
+    EXPECT_EQ(audio::process_commands(), 2);
+    EXPECT_EQ(audio::pending_commands(), 0);
+    EXPECT_EQ(audio::commands_dropped(), 0);
+}
+
+TEST_F(audio_test, drop_rewound_plays)
+{
+    SoundAsset sound{ "data/Bump.wav" };
+    ASSERT_TRUE(sound.loadFromFile());
 
-        LOG_INFO("Playing {} at {}%", sound.get_name(), v);
-        std::this_thread::sleep_for(0.5s);
-        sys.update(0.5);
+    SoundHandle handle;
+    handle.set_sound(sound);
+
+    audio::set_tick(10);
+    handle.play();
+    audio::process_commands();
+    EXPECT_EQ(audio::commands_dropped(), 0);
+
+    // simulation went back in time, the sound was already heard
+    audio::set_tick(5);
+    handle.play();
+    audio::process_commands();
+    EXPECT_EQ(audio::commands_dropped(), 1);
+}
+
+TEST_F(audio_test, drop_stale_plays)
+{
+    SoundAsset sound{ "data/Bump.wav" };
+    ASSERT_TRUE(sound.loadFromFile());
+
+    audio::set_max_command_age(6);
+
+    // released handles keep their voice until the sound is done with it
+    {
+        SoundHandle old_sound;
+        old_sound.set_sound(sound);
+        audio::set_tick(20);
+        old_sound.play();
+    }
+
+    SoundHandle new_sound;
+    new_sound.set_sound(sound);
+    audio::set_tick(40);
+    new_sound.play();
+
+    // several ticks ran in one frame, only the recent sound is played
+    audio::process_commands();
+    EXPECT_EQ(audio::commands_dropped(), 1);
+
+    // the dropped play frees its voice
+    EXPECT_EQ(audio::free_voice_count(), audio::voice_count - 1);
+}
+
+TEST_F(audio_test, tick_deduplication)
+{
+    SoundAsset sound{ "data/Bump.wav" };
+    ASSERT_TRUE(sound.loadFromFile());
+
+    AudioSystem sys;
+
+    int played = 0;
+    for (int i = 0; i < 30; i++) {
+        if (sys.play(sound)) {
+            played++;
+        }
     }
+    EXPECT_EQ(played, 1);
+    EXPECT_EQ(sys.get_deduplicated_count(), 29);
+
+    sys.update(1.0 / 60.0);
+    EXPECT_TRUE(sys.play(sound));
+}
+
+TEST_F(audio_test, sound_ref)
+{
+    SoundRef missing{ "missing.wav" };
+    EXPECT_EQ(missing.get(), nullptr);
 
-    audio::quit();
+    AudioSystem sys;
+    EXPECT_FALSE(sys.play(missing));
 }
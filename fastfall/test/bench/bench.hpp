@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// minimal timing harness, benchmarks are plain executables run by hand and aren't part of ctest
+namespace bench {
+
+// keeps the optimizer from dropping a result
+template<class T>
+void keep(const T& value) {
+#if defined(_MSC_VER)
+    static const void* volatile sink;
+    sink = &value;
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+// runs fn repeatedly and prints the median time per run
+template<class Fn>
+double run(const char* name, unsigned runs, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+
+    fn(); // warm up
+
+    std::vector<double> times;
+    times.reserve(runs);
+    for (unsigned i = 0; i < runs; i++) {
+        auto start = clock::now();
+        fn();
+        times.push_back(std::chrono::duration<double, std::micro>(clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    double median = times[times.size() / 2];
+
+    std::printf("%-40s %10.2f us  (min %.2f, max %.2f)\n", name, median, times.front(), times.back());
+    return median;
+}
+
+}
@@ -0,0 +1,119 @@
+#include "bench.hpp"
+
+#include "fastfall/util/grid_vector.hpp"
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+using namespace ff;
+
+namespace {
+
+constexpr size_t Columns = 2048;
+constexpr size_t Rows = 512;
+constexpr unsigned Runs = 50;
+
+constexpr size_t Lookups = 100'000;
+constexpr size_t RectSize = 24;
+
+// about the size of a tile's collision data
+struct Cell {
+    uint32_t value = 0;
+    std::array<uint8_t, 12> rest{};
+};
+
+struct Point {
+    size_t x;
+    size_t y;
+};
+
+std::vector<Point> random_points(size_t count, size_t margin) {
+    std::mt19937 rng{ 12345 };
+    std::uniform_int_distribution<size_t> x_dist{ 1, Columns - margin - 1 };
+    std::uniform_int_distribution<size_t> y_dist{ 1, Rows - margin - 1 };
+
+    std::vector<Point> points(count);
+    for (auto& point : points) {
+        point = { x_dist(rng), y_dist(rng) };
+    }
+    return points;
+}
+
+template<class Layout>
+void run_layout(const char* layout_name) {
+    grid_vector<Cell, Layout> grid(Columns, Rows);
+    uint32_t n = 0;
+    for (auto& cell : grid) {
+        cell.value = n++;
+    }
+
+    auto points = random_points(Lookups, RectSize);
+    char name[64];
+
+    // every cell with its 3x3 neighbors, like a full ghost or autotile pass
+    std::snprintf(name, sizeof(name), "%s 3x3 all cells", layout_name);
+    bench::run(name, Runs, [&] {
+        uint64_t sum = 0;
+        for (size_t y = 1; y < Rows - 1; y++) {
+            for (size_t x = 1; x < Columns - 1; x++) {
+                for (size_t dy = 0; dy < 3; dy++) {
+                    for (size_t dx = 0; dx < 3; dx++) {
+                        sum += grid.at(x + dx - 1, y + dy - 1).value;
+                    }
+                }
+            }
+        }
+        bench::keep(sum);
+    });
+
+    // 3x3 around scattered cells, like updating ghosts after tile edits
+    std::snprintf(name, sizeof(name), "%s 3x3 random", layout_name);
+    bench::run(name, Runs, [&] {
+        uint64_t sum = 0;
+        for (auto [x, y] : points) {
+            for (size_t dy = 0; dy < 3; dy++) {
+                for (size_t dx = 0; dx < 3; dx++) {
+                    sum += grid.at(x + dx - 1, y + dy - 1).value;
+                }
+            }
+        }
+        bench::keep(sum);
+    });
+
+    // small rects through take_view, like a collidable's tile area
+    std::snprintf(name, sizeof(name), "%s %zux%zu view scan", layout_name, RectSize, RectSize);
+    bench::run(name, Runs, [&] {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < points.size(); i += 16) {
+            auto [x, y] = points[i];
+            for (auto& cell : grid.take_view(x, y, RectSize, RectSize)) {
+                sum += cell.value;
+            }
+        }
+        bench::keep(sum);
+    });
+
+    // the whole grid in row order, the case row major is best at
+    std::snprintf(name, sizeof(name), "%s full scan", layout_name);
+    bench::run(name, Runs, [&] {
+        uint64_t sum = 0;
+        for (const auto& cell : grid) {
+            sum += cell.value;
+        }
+        bench::keep(sum);
+    });
+}
+
+}
+
+int main()
+{
+    std::printf("%zux%zu grid of %zu byte cells, %u runs\n", Columns, Rows, sizeof(Cell), Runs);
+
+    run_layout<grid_layout::row_major>("row major");
+    run_layout<grid_layout::blocked<8>>("blocked 8x8");
+    run_layout<grid_layout::blocked<16>>("blocked 16x16");
+
+    return 0;
+}
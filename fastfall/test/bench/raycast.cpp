@@ -0,0 +1,107 @@
+#include "bench.hpp"
+
+#include "fastfall/game/phys/collider_regiontypes/ColliderTileMap.hpp"
+#include "fastfall/engine/config.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ff;
+
+namespace {
+
+constexpr Vec2i MapSize = { 512, 256 };
+constexpr unsigned Rays = 1000;
+constexpr unsigned Runs = 100;
+
+// a floor and a few pillars, like a large cavern
+void make_sparse(ColliderTileMap& map) {
+    for (int x = 0; x < MapSize.x; x++) {
+        map.setTile({ x, MapSize.y - 1 }, TileShape::from_string("solid"));
+    }
+    for (int x = 32; x < MapSize.x; x += 96) {
+        for (int y = MapSize.y - 24; y < MapSize.y - 1; y++) {
+            map.setTile({ x, y }, TileShape::from_string("solid"));
+        }
+    }
+    map.applyChanges();
+}
+
+// scattered tiles everywhere, like a cluttered room
+void make_dense(ColliderTileMap& map) {
+    std::mt19937 rand{ 1234 };
+    std::uniform_int_distribution<int> chance{ 0, 3 };
+    for (int y = 0; y < MapSize.y; y++) {
+        for (int x = 0; x < MapSize.x; x++) {
+            if (chance(rand) == 0)
+                map.setTile({ x, y }, TileShape::from_string("solid"));
+        }
+    }
+    map.applyChanges();
+}
+
+std::vector<Linef> make_rays(float length) {
+    std::mt19937 rand{ 5678 };
+    std::uniform_real_distribution<float> pos_x{ 0.f, MapSize.x * TILESIZE_F };
+    std::uniform_real_distribution<float> pos_y{ 0.f, MapSize.y * TILESIZE_F };
+    std::uniform_real_distribution<float> angle{ 0.f, 6.2831853f };
+
+    std::vector<Linef> rays;
+    for (unsigned i = 0; i < Rays; i++) {
+        Vec2f from{ pos_x(rand), pos_y(rand) };
+        float ang = angle(rand);
+        rays.push_back({ from, from + Vec2f{ cosf(ang), sinf(ang) } * length });
+    }
+    return rays;
+}
+
+void run_rays(const char* name, const ColliderTileMap& map, const std::vector<Linef>& rays) {
+    std::string label = name;
+
+    // one virtual call per quad step
+    bench::run((label + " in_line").c_str(), Runs, [&] {
+        size_t count = 0;
+        for (auto& ray : rays) {
+            for (auto quad : map.in_line(ray)) {
+                count += quad.id.value;
+            }
+        }
+        bench::keep(count);
+    });
+
+    // bulk, stepping over empty pyramid blocks
+    std::vector<ColliderRegion::quad_iter> buffer;
+    bench::run((label + " quads_in_line").c_str(), Runs, [&] {
+        size_t count = 0;
+        for (auto& ray : rays) {
+            for (auto quad : map.quads_in_line(ray, buffer)) {
+                count += quad.id.value;
+            }
+        }
+        bench::keep(count);
+    });
+}
+
+}
+
+int main()
+{
+    std::printf("%u rays through a %dx%d tile map, %u runs\n", Rays, MapSize.x, MapSize.y, Runs);
+
+    ColliderTileMap sparse{ MapSize };
+    make_sparse(sparse);
+
+    ColliderTileMap dense{ MapSize };
+    make_dense(dense);
+
+    auto long_rays  = make_rays(MapSize.x * TILESIZE_F * 0.5f);
+    auto short_rays = make_rays(4 * TILESIZE_F);
+
+    run_rays("sparse, long", sparse, long_rays);
+    run_rays("sparse, short", sparse, short_rays);
+    run_rays("dense, long", dense, long_rays);
+    run_rays("dense, short", dense, short_rays);
+
+    return 0;
+}
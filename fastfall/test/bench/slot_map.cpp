@@ -0,0 +1,103 @@
+#include "bench.hpp"
+
+#include "fastfall/util/slot_map.hpp"
+#include "fastfall/util/split_slot_map.hpp"
+
+#include <array>
+#include <cstdint>
+
+using namespace ff;
+
+namespace {
+
+constexpr size_t Count = 100'000;
+constexpr unsigned Runs = 200;
+constexpr float dt = 1.f / 60.f;
+
+// roughly the shape of a collidable, a few fields touched every tick and a lot that aren't
+struct Body {
+    float pos_x = 0.f, pos_y = 0.f;
+    float vel_x = 1.f, vel_y = 1.f;
+    float box_x = 0.f, box_y = 0.f, box_w = 16.f, box_h = 16.f;
+    std::array<uint8_t, 192> cold{};
+};
+
+struct BodyHot {
+    float pos_x = 0.f, pos_y = 0.f;
+    float vel_x = 1.f, vel_y = 1.f;
+    float box_x = 0.f, box_y = 0.f, box_w = 16.f, box_h = 16.f;
+};
+
+struct BodyCold {
+    std::array<uint8_t, 192> cold{};
+};
+
+template<class T>
+void step(T& body) {
+    body.pos_x += body.vel_x * dt;
+    body.pos_y += body.vel_y * dt;
+    body.box_x = body.pos_x - body.box_w * 0.5f;
+    body.box_y = body.pos_y - body.box_h;
+}
+
+// erase every fourth so the dense order no longer matches creation order
+template<class Map, class Fn>
+void fill(Map& map, Fn&& emplace) {
+    std::vector<slot_key> keys;
+    keys.reserve(Count + Count / 3);
+    for (size_t i = 0; i < Count + Count / 3; i++) {
+        keys.push_back(emplace(map));
+    }
+    for (size_t i = 0; i < keys.size() && map.size() > Count; i += 4) {
+        map.erase(keys[i]);
+    }
+}
+
+}
+
+int main()
+{
+    std::printf("iterating %zu components, %u runs\n", Count, Runs);
+
+    // keys interleaved with values
+    slot_map<Body> interleaved;
+    fill(interleaved, [](auto& map) { return map.emplace_back(); });
+    bench::run("slot_map<Body>", Runs, [&] {
+        for (auto& [key, body] : interleaved) {
+            step(body);
+        }
+        bench::keep(interleaved);
+    });
+
+    // keys apart from values
+    split_slot_map<Body> split;
+    fill(split, [](auto& map) { return map.emplace_back(Body{}); });
+    bench::run("split_slot_map<Body>", Runs, [&] {
+        for (auto& body : split.column<Body>()) {
+            step(body);
+        }
+        bench::keep(split);
+    });
+
+    // hot fields in their own column
+    split_slot_map<BodyHot, BodyCold> hot_cold;
+    fill(hot_cold, [](auto& map) { return map.emplace_back(BodyHot{}, BodyCold{}); });
+    bench::run("split_slot_map<BodyHot, BodyCold>", Runs, [&] {
+        for (auto& body : hot_cold.column<BodyHot>()) {
+            step(body);
+        }
+        bench::keep(hot_cold);
+    });
+
+    // keys are still wanted alongside, e.g. to look up another component
+    bench::run("split_slot_map for_each w/ key", Runs, [&] {
+        uint64_t sum = 0;
+        hot_cold.for_each([&](slot_key key, BodyHot& body, BodyCold&) {
+            step(body);
+            sum += key.sparse_index;
+        });
+        bench::keep(sum);
+    });
+
+    return 0;
+}
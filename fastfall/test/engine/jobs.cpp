@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/engine/jobs.hpp"
+
+#include <vector>
+
+using namespace ff;
+
+void run_jobs_test() {
+    std::vector<size_t> values(100000, 0);
+    jobs::parallel_for(values.size(), 1000, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            values[i] = i * 2;
+        }
+    });
+
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(values[i], i * 2);
+    }
+
+    // nested groups
+    jobs::Group group;
+    std::atomic<int> counter = 0;
+    for (int i = 0; i < 1000; i++) {
+        jobs::run(group, [&]() {
+            jobs::Group inner;
+            jobs::run(inner, [&]() { counter++; });
+            jobs::wait(inner);
+            counter++;
+        });
+    }
+    jobs::wait(group);
+    EXPECT_TRUE(group.done());
+    EXPECT_EQ(counter, 2000);
+}
+
+TEST(jobs, inline_without_init)
+{
+    ASSERT_FALSE(jobs::is_init());
+    run_jobs_test();
+}
+
+TEST(jobs, workers)
+{
+    ASSERT_TRUE(jobs::init(4));
+    EXPECT_EQ(jobs::worker_count(), 4);
+    run_jobs_test();
+    jobs::quit();
+    EXPECT_FALSE(jobs::is_init());
+}
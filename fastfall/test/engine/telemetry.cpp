@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/engine/telemetry.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace ff;
+using namespace ff::telemetry;
+
+TEST(telemetry, histogram_buckets)
+{
+    // exact below SubBuckets, then within one sub-bucket
+    for (uint64_t v = 0; v < Histogram::SubBuckets * 2; v++) {
+        EXPECT_EQ(Histogram::bucket_max(Histogram::bucket_of(v)), v);
+    }
+
+    for (uint64_t v : std::initializer_list<uint64_t>{ 100, 12345, 1000000, 987654321, UINT64_MAX }) {
+        size_t bucket = Histogram::bucket_of(v);
+        EXPECT_LT(bucket, Histogram::BucketCount);
+        EXPECT_GE(Histogram::bucket_max(bucket), v);
+        EXPECT_LE(Histogram::bucket_max(bucket) - v, v / Histogram::SubBuckets);
+    }
+}
+
+TEST(telemetry, histogram_percentiles)
+{
+    Histogram hist;
+    EXPECT_EQ(hist.percentile(0.5), 0);
+
+    for (uint64_t v = 1; v <= 1000; v++) {
+        hist.record(v);
+    }
+    // one hitch
+    hist.record(1000000);
+
+    EXPECT_EQ(hist.count(), 1001);
+    EXPECT_EQ(hist.min(), 1);
+    EXPECT_EQ(hist.max(), 1000000);
+
+    auto near = [](uint64_t value, uint64_t expected) {
+        return value >= expected && value - expected <= expected / Histogram::SubBuckets;
+    };
+    EXPECT_TRUE(near(hist.percentile(0.5), 501));
+    EXPECT_TRUE(near(hist.percentile(0.99), 991));
+    EXPECT_TRUE(near(hist.percentile(0.999), 1000));
+    EXPECT_EQ(hist.percentile(1.0), 1000000);
+
+    hist.reset();
+    EXPECT_EQ(hist.count(), 0);
+    EXPECT_EQ(hist.max(), 0);
+}
+
+TEST(telemetry, channels)
+{
+    auto a = counter("test counter");
+    auto b = counter("test counter");
+    EXPECT_TRUE(a.valid());
+    EXPECT_EQ(a.index, b.index);
+
+    for (uint64_t v = 1; v <= RingSize + 10; v++) {
+        record(a, v);
+    }
+
+    auto s = summarize(a);
+    EXPECT_EQ(s.name, "test counter");
+    EXPECT_EQ(s.kind, Kind::Counter);
+    EXPECT_EQ(s.count, RingSize + 10);
+
+    // ring holds the latest samples, oldest first
+    std::vector<uint64_t> samples(RingSize * 2);
+    size_t n = recent(a, samples);
+    ASSERT_EQ(n, RingSize);
+    EXPECT_EQ(samples.front(), 11);
+    EXPECT_EQ(samples[n - 1], RingSize + 10);
+
+    set_enabled(false);
+    record(a, 1);
+    EXPECT_EQ(summarize(a).count, RingSize + 10);
+    set_enabled(true);
+}
+
+TEST(telemetry, threaded)
+{
+    auto ch = timing("test threaded");
+
+    constexpr size_t per_thread = 10000;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+        threads.emplace_back([ch]() {
+            for (size_t i = 0; i < per_thread; i++) {
+                ScopedTimer timer{ ch };
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(summarize(ch).count, per_thread * 4);
+}
@@ -0,0 +1,116 @@
+#include "fastfall/game/tile/Tile.hpp"
+
+#include "gtest/gtest.h"
+
+#include <random>
+
+using namespace ff;
+
+namespace {
+
+TileShape random_shape(std::mt19937& rng) {
+    return TileShape{
+        .type   = static_cast<TileShape::Type>(rng() % 11),
+        .flip_h = rng() % 2 == 0,
+        .flip_v = rng() % 2 == 0
+    };
+}
+
+std::vector<TileConstraint> random_constraints(std::mt19937& rng, bool with_shapes) {
+    std::vector<TileConstraint> constraints;
+    for (int i = 0; i < 24; i++) {
+        TileConstraint constraint{
+            .tile_id = TileID{ (unsigned)(rng() % 16), (unsigned)(rng() % 16) },
+            .shape   = rng() % 2 == 0 ? "solid"_ts : random_shape(rng)
+        };
+        for (auto dir : direction::cardinals) {
+            switch (rng() % 4) {
+            case 0: constraint.edges[dir] = tile_constraint_options::yes; break;
+            case 1: constraint.edges[dir] = tile_constraint_options::no; break;
+            case 2: if (with_shapes) constraint.edges[dir] = random_shape(rng); break;
+            }
+        }
+        for (auto dir : direction::ordinals) {
+            switch (rng() % 3) {
+            case 0: constraint.corners[dir] = tile_constraint_options::yes; break;
+            case 1: constraint.corners[dir] = tile_constraint_options::no; break;
+            }
+        }
+        constraints.push_back(constraint);
+    }
+    return constraints;
+}
+
+}
+
+TEST(autotile, bulk_matches_per_tile)
+{
+    std::mt19937 rng{ 7 };
+
+    for (int trial = 0; trial < 64; trial++) {
+        unsigned width = 1 + rng() % 9;
+        unsigned height = 1 + rng() % 9;
+
+        grid_vector<TileShape> shapes(width, height);
+        for (auto& shape : shapes) {
+            shape = rng() % 3 == 0 ? TileShape{} : random_shape(rng);
+        }
+
+        auto constraints = random_constraints(rng, trial % 2 == 0);
+        AutotileTable table{ constraints };
+
+        AutoTileOffGridSubstitute offgrid = trial % 4 < 2
+            ? AutoTileOffGridSubstitute{ AUTOTILE_GRID_WRAP{} }
+            : AutoTileOffGridSubstitute{ random_shape(rng) };
+
+        grid_view<TileShape> view = shapes.take_view();
+        std::vector<TileState> states;
+        get_autotile_states(view, Recti{ 0, 0, (int)width, (int)height }, offgrid, states);
+        ASSERT_EQ(states.size(), width * height);
+
+        for (unsigned y = 0; y < height; y++) {
+            for (unsigned x = 0; x < width; x++) {
+                auto expected = get_autotile_state(shapes.at(x, y), view, Vec2u{ x, y }, offgrid);
+                auto& state = states[y * width + x];
+
+                EXPECT_TRUE(state.shape == expected.shape);
+                EXPECT_EQ(autotile_mask(state), autotile_mask(expected));
+                for (auto dir : direction::cardinals) {
+                    EXPECT_TRUE(state.card_shapes[dir] == expected.card_shapes[dir]);
+                }
+
+                unsigned seed = x + y * width;
+                auto expected_tile = auto_best_tile(expected, constraints, seed);
+                auto tile = table.best_tile(state, seed);
+                ASSERT_EQ(tile.has_value(), expected_tile.has_value());
+                if (tile) {
+                    EXPECT_TRUE(*tile == *expected_tile);
+                }
+            }
+        }
+    }
+}
+
+TEST(autotile, bulk_wraps_off_grid)
+{
+    grid_vector<TileShape> shapes(4, 3);
+    shapes.at(0, 0) = "solid"_ts;
+    shapes.at(3, 0) = "solid"_ts;
+    shapes.at(0, 2) = "solid"_ts;
+    shapes.at(3, 2) = "solid"_ts;
+
+    std::vector<TileState> states;
+    get_autotile_states(shapes.take_view(), Recti{ -1, -1, 3, 3 }, AUTOTILE_GRID_WRAP{}, states);
+    ASSERT_EQ(states.size(), 9);
+
+    // the corner at (3, 2) is up and left of (0, 0), across both edges
+    for (int y = 0; y < 3; y++) {
+        for (int x = 0; x < 3; x++) {
+            Vec2u pos{ (unsigned)((x + 3) % 4), (unsigned)((y + 2) % 3) };
+            auto expected = get_autotile_state(shapes[pos], shapes.take_view(), pos, AUTOTILE_GRID_WRAP{});
+            EXPECT_EQ(autotile_mask(states[y * 3 + x]), autotile_mask(expected));
+        }
+    }
+    EXPECT_TRUE(states[0].occupied_edges[Cardinal::E]);
+    EXPECT_TRUE(states[0].occupied_edges[Cardinal::S]);
+}
@@ -0,0 +1,117 @@
+#include "fastfall/game/World.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace ff;
+
+TEST(world_batch, create)
+{
+    World world;
+    world.reserve<Entity>(100);
+    world.reserve<Collidable>(100);
+
+    std::vector<ID<Entity>> ents;
+    std::vector<ID<Collidable>> cols;
+    {
+        auto batch = world.batch();
+        EXPECT_TRUE(world.in_batch());
+        for (int i = 0; i < 100; i++) {
+            auto ent = world.create_entity();
+            auto col = world.create<Collidable>(ent, Vec2f{ 16.f * i, 0.f }, Vec2f{ 16, 16 });
+            ents.push_back(ent);
+            cols.push_back(col.id);
+
+            // lookups work before the batch ends
+            EXPECT_EQ(world.entity_of(col.id), ent);
+            EXPECT_EQ(world.entity_of(col->get_attach_id()), ent);
+        }
+    }
+    EXPECT_FALSE(world.in_batch());
+
+    for (size_t i = 0; i < ents.size(); i++) {
+        EXPECT_EQ(world.entity_of(cols[i]), ents[i]);
+        EXPECT_EQ(world.components_of(ents[i]).size(), 2);
+    }
+    EXPECT_EQ((world.view<Collidable, AttachPoint>().size()), 100);
+}
+
+TEST(world_batch, erase)
+{
+    World world;
+    std::vector<ID<Entity>> ents;
+    std::vector<ID<Trigger>> trigs;
+    for (int i = 0; i < 10; i++) {
+        auto ent = world.create_entity();
+        trigs.push_back(world.create<Trigger>(ent, id_placeholder).id);
+        world.create<Collidable>(ent, Vec2f{}, Vec2f{ 16, 16 });
+        ents.push_back(ent);
+    }
+
+    // every other entity
+    std::vector<ID<Entity>> erased;
+    for (size_t i = 0; i < ents.size(); i += 2) {
+        erased.push_back(ents[i]);
+    }
+    EXPECT_EQ(world.erase(erased), 5);
+    EXPECT_EQ(world.erase(erased), 0);
+
+    EXPECT_EQ(world.entities().size(), 5);
+    EXPECT_EQ(world.all<Collidable>().size(), 5);
+    EXPECT_EQ(world.all<AttachPoint>().size(), 5);
+    for (size_t i = 1; i < ents.size(); i += 2) {
+        EXPECT_EQ(world.entity_of(trigs[i]), ents[i]);
+    }
+}
+
+TEST(world_batch, create_erase_in_batch)
+{
+    World world;
+    auto kept = world.create_entity();
+    {
+        auto batch = world.batch();
+        auto ent = world.create_entity();
+        auto col = world.create<Collidable>(ent, Vec2f{}, Vec2f{ 16, 16 });
+        world.create<Collidable>(kept, Vec2f{}, Vec2f{ 16, 16 });
+        EXPECT_TRUE(world.erase(col.id));
+        EXPECT_FALSE(world.erase(col.id));
+
+        // nested batches end with the outermost one
+        {
+            auto inner = world.batch();
+            world.erase(ent);
+        }
+        EXPECT_TRUE(world.in_batch());
+    }
+    EXPECT_EQ(world.entities().size(), 1);
+    EXPECT_EQ(world.all<Collidable>().size(), 1);
+    EXPECT_EQ(world.components_of(kept).size(), 2);
+    for (auto [id, col] : world.all<Collidable>()) {
+        EXPECT_EQ(world.entity_of(id), kept);
+    }
+}
+
+TEST(world_batch, destroy_queue)
+{
+    World world;
+    auto ent_a = world.create_entity();
+    auto ent_b = world.create_entity();
+    auto col = world.create<Collidable>(ent_a, Vec2f{}, Vec2f{ 16, 16 });
+    auto trig = world.create<Trigger>(ent_b, id_placeholder);
+
+    world.destroy(ent_a);
+    world.destroy(ent_a);
+    world.destroy(trig.id);
+    EXPECT_EQ(world.pending_destroyed(), 3);
+
+    // nothing is erased until the queue is processed
+    EXPECT_TRUE(world.get(col.id));
+    EXPECT_TRUE(world.get(trig.id));
+
+    world.process_destroyed();
+    EXPECT_EQ(world.pending_destroyed(), 0);
+    EXPECT_FALSE(world.get(col.id));
+    EXPECT_FALSE(world.get(trig.id));
+    EXPECT_TRUE(world.all<AttachPoint>().empty());
+    EXPECT_EQ(world.entities().size(), 1);
+    EXPECT_TRUE(world.components_of(ent_b).empty());
+}
@@ -0,0 +1,83 @@
+#include "fastfall/game/World.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace ff;
+
+TEST(world_view, linked_component)
+{
+    World world;
+    auto ent = world.create_entity();
+
+    // another attach point on the entity, created first
+    auto other = world.create<AttachPoint>(ent, id_placeholder);
+    auto col = world.create<Collidable>(ent, Vec2f{}, Vec2f{ 16, 16 });
+
+    size_t count = 0;
+    for (auto [id, c, attach] : world.view<Collidable, AttachPoint>()) {
+        EXPECT_EQ(id, col.id);
+        EXPECT_EQ(&c, col.ptr);
+        EXPECT_EQ(&attach, world.get(c.get_attach_id()));
+        EXPECT_NE(&attach, other.ptr);
+        count++;
+    }
+    EXPECT_EQ(count, 1);
+}
+
+TEST(world_view, same_entity)
+{
+    World world;
+    auto ent_a = world.create_entity();
+    auto ent_b = world.create_entity();
+
+    auto trig_a = world.create<Trigger>(ent_a, id_placeholder);
+    world.create<Trigger>(ent_b, id_placeholder);
+    world.create<Collidable>(ent_a, Vec2f{}, Vec2f{ 16, 16 });
+
+    // only ent_a has both
+    auto view = world.view<Collidable, Trigger>();
+    ASSERT_EQ(view.size(), 1);
+    auto [id, col, trig] = *view.begin();
+    EXPECT_EQ(&trig, trig_a.ptr);
+}
+
+TEST(world_view, refresh)
+{
+    World world;
+    auto ent = world.create_entity();
+    auto col_a = world.create<Collidable>(ent, Vec2f{}, Vec2f{ 16, 16 });
+    EXPECT_EQ((world.view<Collidable, AttachPoint>().size()), 1);
+
+    auto col_b = world.create<Collidable>(ent, Vec2f{ 32, 0 }, Vec2f{ 16, 16 });
+    auto view = world.view<Collidable, AttachPoint>();
+    EXPECT_EQ(view.size(), 2);
+
+    // entries follow the components as they move in storage
+    for (auto [id, col, attach] : view) {
+        EXPECT_EQ(&col, world.get(id));
+        EXPECT_EQ(&attach, world.get(col.get_attach_id()));
+    }
+
+    world.erase(col_a.id);
+    view = world.view<Collidable, AttachPoint>();
+    ASSERT_EQ(view.size(), 1);
+    EXPECT_EQ(std::get<0>(*view.begin()), col_b.id);
+
+    world.erase(ent);
+    EXPECT_TRUE((world.view<Collidable, AttachPoint>().empty()));
+}
+
+TEST(world_view, stale_view)
+{
+    World world;
+    auto ent = world.create_entity();
+    world.create<Collidable>(ent, Vec2f{}, Vec2f{ 16, 16 });
+    auto view = world.view<Collidable, AttachPoint>();
+    EXPECT_EQ(view.size(), 1);
+
+    // creating alone leaves the cache as it is, the next view() rebuilds it
+    world.create<Collidable>(ent, Vec2f{ 32, 0 }, Vec2f{ 16, 16 });
+    EXPECT_EQ(view.size(), 1);
+    EXPECT_EQ((world.view<Collidable, AttachPoint>().size()), 2);
+    EXPECT_DEBUG_DEATH(view.size(), "rebuilt");
+}
@@ -1,13 +1,17 @@
 
 #include "fastfall/game/phys/collider_regiontypes/ColliderTileMap.hpp"
+#include "fastfall/game/phys/collider_regiontypes/ColliderMesh.hpp"
 #include "fastfall/game/phys/Collidable.hpp"
+#include "fastfall/game/phys/Raycast.hpp"
 #include "fastfall/game/World.hpp"
 
 #include "TestPhysRenderer.hpp"
 #include "gtest/gtest.h"
 
 #include "nlohmann/json.hpp"
+#include <array>
 #include <fstream>
+#include <random>
 
 using namespace ff;
 
@@ -19,6 +23,7 @@ protected:
     World world;
     ID<Entity> collider_obj_id;
     ID<Entity> collidable_obj_id;
+	ID<Collidable> box_id;
 	Collidable* box = nullptr;
 	ColliderTileMap* collider = nullptr;
 	std::fstream log;
@@ -53,7 +58,9 @@ protected:
         //auto id = world.create_entity();
         collidable_obj_id = world.create_entity();
         collider_obj_id = world.create_entity();
-		box = world.create<Collidable>(collidable_obj_id, pos, size, grav).ptr;
+		auto box_ptr = world.create<Collidable>(collidable_obj_id, pos, size, grav);
+		box_id = box_ptr.id;
+		box = box_ptr.ptr;
         colMan = &world.system<CollisionSystem>();
 	}
 
@@ -67,6 +74,12 @@ protected:
 		colMan->update(world, one_frame);
 	}
 
+	// without dumping, which keeps every collidable awake
+	void update_undumped()
+	{
+		colMan->update(world, one_frame);
+	}
+
 	void initTileMap(grid_vector<std::string_view> tiles)
 	{
 		collider =
@@ -726,3 +739,363 @@ TEST_F(collision, across_oneway) {
 }
 
 
+
+TEST_F(collision, sleep_at_rest)
+{
+    initTileMap({
+        {""},
+        {""},
+        {"solid"},
+    });
+
+    box->teleport(Vec2f{ 8, 32 });
+    box->set_gravity(Vec2f{ 0.f, 500.f });
+
+    for (size_t i = 0; i < CollidableRest::sleep_ticks + 10; i++) {
+        update_undumped();
+    }
+
+    ASSERT_TRUE(colMan->get_rest(box_id).is_asleep());
+    EXPECT_TRUE(box->getPosition() == Vec2f(8, 32));
+    EXPECT_EQ(box->get_contacts().size(), 1);
+
+    // still asleep while nothing changes
+    update_undumped();
+    EXPECT_TRUE(colMan->get_rest(box_id).is_asleep());
+    EXPECT_TRUE(box->getPosition() == Vec2f(8, 32));
+    EXPECT_EQ(box->get_contacts().size(), 1);
+
+    // external velocity change wakes it
+    box->set_local_vel(Vec2f{ 60.f, 0.f });
+    update_undumped();
+    EXPECT_FALSE(colMan->get_rest(box_id).is_asleep());
+    EXPECT_GT(box->getPosition().x, 8.f);
+}
+
+TEST_F(collision, sleep_wake_on_tile_edit)
+{
+    initTileMap({
+        {""},
+        {""},
+        {"solid"},
+        {""},
+    });
+
+    box->teleport(Vec2f{ 8, 32 });
+    box->set_gravity(Vec2f{ 0.f, 500.f });
+
+    for (size_t i = 0; i < CollidableRest::sleep_ticks + 10; i++) {
+        update_undumped();
+    }
+    ASSERT_TRUE(colMan->get_rest(box_id).is_asleep());
+
+    collider->removeTile({ 0, 2 });
+    collider->applyChanges();
+
+    update_undumped();
+    EXPECT_FALSE(colMan->get_rest(box_id).is_asleep());
+    EXPECT_GT(box->getPosition().y, 32.f);
+    EXPECT_EQ(box->get_contacts().size(), 0);
+}
+
+TEST_F(collision, sleep_matches_solve)
+{
+    initTileMap({
+        {""},
+        {""},
+        {"solid"},
+    });
+
+    box->teleport(Vec2f{ 8, 32 });
+    box->set_gravity(Vec2f{ 0.f, 500.f });
+
+    for (size_t i = 0; i < CollidableRest::sleep_ticks + 10; i++) {
+        update_undumped();
+    }
+    ASSERT_TRUE(colMan->get_rest(box_id).is_asleep());
+
+    Vec2f pos = box->getPosition();
+    Vec2f vel = box->get_local_vel();
+
+    // dumping forces the full solve, which should land in the same state sleeping kept
+    for (size_t i = 0; i < 10; i++) {
+        update();
+        EXPECT_FALSE(colMan->get_rest(box_id).is_asleep());
+        EXPECT_TRUE(box->getPosition() == pos);
+        EXPECT_TRUE(box->get_local_vel() == vel);
+        EXPECT_EQ(box->get_contacts().size(), 1);
+    }
+}
+
+TEST(collider_tilemap, collect_quads_matches_in_rect)
+{
+	// wider than one occupancy word, with a border
+	ColliderTileMap collider{ Vec2i{ 70, 4 }, true };
+	collider.setBorders(Vec2u{ 70, 4 }, direction::to_bits(Cardinal::W) | direction::to_bits(Cardinal::S));
+	for (int x = 0; x < 70; x += 3) {
+		collider.setTile({ x, 3 }, TileShape::from_string("solid"));
+		collider.setTile({ x, x % 4 }, TileShape::from_string("slope"));
+	}
+	collider.applyChanges();
+	collider.removeTile({ 63, 3 });
+	collider.removeTile({ 66, 3 });
+	collider.applyChanges();
+
+	auto expected_in = [&](Rectf area) {
+		std::vector<QuadID> ids;
+		for (auto quad : collider.in_rect(area)) {
+			ids.push_back(quad.id);
+		}
+		return ids;
+	};
+
+	std::vector<ColliderRegion::quad_iter> buffer;
+	for (Rectf area : {
+			Rectf{ -32.f, -32.f, 1200.f, 128.f },
+			Rectf{ 0.f, 48.f, 16.f, 16.f },
+			Rectf{ 980.f, 40.f, 100.f, 30.f },
+			Rectf{ 2000.f, 0.f, 16.f, 16.f } })
+	{
+		auto expected = expected_in(area);
+		auto quads = collider.quads_in_rect(area, buffer);
+
+		ASSERT_EQ(quads.size(), expected.size());
+		for (size_t i = 0; i < quads.size(); i++) {
+			EXPECT_EQ(quads[i].id, expected[i]);
+			EXPECT_EQ(quads[i].ptr, collider.get_quad(expected[i]));
+		}
+	}
+
+	// too small, still counts the rest
+	std::array<ColliderRegion::quad_iter, 2> small;
+	EXPECT_EQ(collider.collect_quads(Rectf{ -32.f, -32.f, 1200.f, 128.f }, small),
+			  expected_in(Rectf{ -32.f, -32.f, 1200.f, 128.f }).size());
+}
+
+TEST(collider_tilemap, collect_quads_matches_in_line)
+{
+	ColliderTileMap collider{ Vec2i{ 8, 8 } };
+	collider.fill(TileShape::from_string("solid"));
+	collider.applyChanges();
+	collider.removeTile({ 2, 2 });
+	collider.removeTile({ 4, 4 });
+	collider.applyChanges();
+
+	Linef line{ { 1.f, 1.f }, { 120.f, 110.f } };
+
+	for (bool skip_empty : { true, false }) {
+		std::vector<ColliderRegion::quad_iter> expected;
+		for (auto quad : collider.in_line(line, skip_empty)) {
+			expected.push_back(quad);
+		}
+
+		std::vector<ColliderRegion::quad_iter> buffer;
+		auto quads = collider.quads_in_line(line, buffer, skip_empty);
+
+		ASSERT_EQ(quads.size(), expected.size());
+		for (size_t i = 0; i < quads.size(); i++) {
+			EXPECT_EQ(quads[i].id, expected[i].id);
+			EXPECT_EQ(quads[i].ptr, expected[i].ptr);
+		}
+	}
+}
+
+TEST(collider_tilemap, collect_quads_in_line_skips_empty_blocks)
+{
+	// mostly empty, so most of each line is stepped over a block at a time
+	ColliderTileMap collider{ Vec2i{ 100, 60 }, true };
+	collider.setBorders(Vec2u{ 100, 60 }, direction::to_bits(Cardinal::S) | direction::to_bits(Cardinal::E));
+	for (int i = 0; i < 40; i++) {
+		collider.setTile({ (i * 37) % 100, (i * 23) % 60 }, TileShape::from_string("solid"));
+	}
+	collider.applyChanges();
+
+	std::vector<Linef> lines;
+	for (int i = 0; i < 32; i++) {
+		Vec2f from{ (float)((i * 173) % 1600) + 0.5f, (float)((i * 97) % 960) + 0.25f };
+		Vec2f to{ (float)((i * 311 + 700) % 1600) + 0.75f, (float)((i * 59 + 400) % 960) + 0.5f };
+		lines.push_back({ from, to });
+	}
+	lines.push_back({ { 8.f, 500.f }, { 1590.f, 500.f } });
+	lines.push_back({ { 800.f, 950.f }, { 800.f, 8.f } });
+
+	std::vector<ColliderRegion::quad_iter> buffer;
+	for (auto& line : lines) {
+		std::vector<QuadID> expected;
+		for (auto quad : collider.in_line(line)) {
+			expected.push_back(quad.id);
+		}
+
+		auto quads = collider.quads_in_line(line, buffer);
+		ASSERT_EQ(quads.size(), expected.size());
+		for (size_t i = 0; i < quads.size(); i++) {
+			EXPECT_EQ(quads[i].id, expected[i]);
+		}
+	}
+}
+
+TEST(collider_tile, to_quad_flips)
+{
+	ColliderTile tile{ Vec2i{ 2, 1 }, TileShape::from_string("slope-h") };
+	ColliderQuad quad = tile.toQuad(QuadID{ 5 });
+
+	EXPECT_EQ(quad.getID(), QuadID{ 5 });
+	EXPECT_FALSE(quad.hasOneWay);
+
+	// slope falling to the right, translated to its tile
+	auto* north = quad.getSurface(Cardinal::N);
+	ASSERT_TRUE(north);
+	EXPECT_TRUE(north->surface.p1 == Vec2f(32.f, 16.f));
+	EXPECT_TRUE(north->surface.p2 == Vec2f(48.f, 32.f));
+	EXPECT_EQ(north->id.quad_id, QuadID{ 5 });
+
+	// wall side flipped to the west
+	EXPECT_FALSE(quad.getSurface(Cardinal::E));
+	EXPECT_TRUE(quad.getSurface(Cardinal::W));
+
+	ColliderQuad oneway = ColliderTile{ Vec2i{ 0, 0 }, TileShape::from_string("oneway-v") }.toQuad(QuadID{ 0 });
+	EXPECT_TRUE(oneway.isOneWay(Cardinal::S));
+	EXPECT_TRUE(oneway.getSurface(Cardinal::S));
+	EXPECT_FALSE(oneway.getSurface(Cardinal::N));
+}
+
+TEST_F(collision, mesh_floor)
+{
+	// separate quads sharing edges, walked across like tiles
+	std::vector<ColliderQuad> quads;
+	for (int x = 0; x < 6; x++) {
+		quads.emplace_back(Rectf{ x * 16.f, 32.f, 16.f, 16.f });
+	}
+	world.create<ColliderMesh>(collider_obj_id, std::move(quads));
+
+	box->teleport(Vec2f{ 8, 32 });
+	box->set_gravity(Vec2f{ 0.f, 500.f });
+	box->set_local_vel(Vec2f{ 100.f, 0.f });
+
+	for (size_t i = 0; i < 30; i++) {
+		update();
+		EXPECT_EQ(box->getPosition().y, 32.f);
+		EXPECT_EQ(box->get_contacts().size(), 1);
+	}
+	EXPECT_GT(box->getPosition().x, 48.f);
+}
+
+TEST(collider_mesh, queries_match_brute_force)
+{
+	std::mt19937 rand{ 42 };
+	std::uniform_real_distribution<float> pos{ 0.f, 2000.f };
+	std::uniform_real_distribution<float> size{ 4.f, 40.f };
+
+	std::vector<ColliderQuad> quads;
+	for (int i = 0; i < 2000; i++) {
+		quads.emplace_back(Rectf{ pos(rand), pos(rand), size(rand), size(rand) });
+	}
+	ColliderMesh mesh{ std::move(quads) };
+	mesh.teleport(Vec2f{ 100.f, -50.f });
+
+	ASSERT_EQ(mesh.get_quads().size(), 2000);
+	for (size_t i = 0; i < mesh.get_quads().size(); i++) {
+		EXPECT_EQ(mesh.get_quads()[i].getID(), QuadID{ (int)i });
+	}
+
+	std::vector<ColliderRegion::quad_iter> buffer;
+	for (int i = 0; i < 50; i++) {
+		Rectf area{ pos(rand), pos(rand), size(rand) * 4.f, size(rand) * 4.f };
+
+		std::vector<QuadID> expected;
+		for (auto& quad : mesh.get_quads()) {
+			if (math::shift(mesh.tile_area(quad.getID()), mesh.getPosition()).touches(area))
+				expected.push_back(quad.getID());
+		}
+
+		std::vector<QuadID> iterated;
+		for (auto quad : mesh.in_rect(area)) {
+			iterated.push_back(quad.id);
+		}
+
+		auto quads = mesh.quads_in_rect(area, buffer);
+		ASSERT_EQ(quads.size(), expected.size());
+		ASSERT_EQ(iterated.size(), expected.size());
+		for (size_t j = 0; j < quads.size(); j++) {
+			EXPECT_EQ(quads[j].id, expected[j]);
+			EXPECT_EQ(iterated[j], expected[j]);
+		}
+	}
+
+	for (int i = 0; i < 50; i++) {
+		Linef line{ { pos(rand), pos(rand) }, { pos(rand), pos(rand) } };
+
+		std::vector<QuadID> iterated;
+		for (auto quad : mesh.in_line(line)) {
+			iterated.push_back(quad.id);
+		}
+
+		auto quads = mesh.quads_in_line(line, buffer);
+		ASSERT_EQ(quads.size(), iterated.size());
+		for (size_t j = 0; j < quads.size(); j++) {
+			EXPECT_EQ(quads[j].id, iterated[j]);
+		}
+	}
+}
+
+TEST(collider_mesh, raycast_overlapping_slopes)
+{
+	World world;
+	auto ent = world.create_entity();
+
+	// the slope's bounds are entered first, but the flat quad inside them is hit first
+	ColliderQuad slope{ Rectf{ 0.f, 0.f, 32.f, 32.f } };
+	auto slope_surf = *slope.getSurface(Cardinal::N);
+	slope_surf.surface = Linef{ { 0.f, 32.f }, { 32.f, 0.f } };
+	slope.setSurface(Cardinal::N, slope_surf);
+	slope.removeSurface(Cardinal::W);
+
+	ColliderQuad flat{ Rectf{ 4.f, 10.f, 8.f, 6.f } };
+
+	// a second slope overlapping the first, to the ray's right
+	ColliderQuad other_slope{ Rectf{ 8.f, 0.f, 32.f, 32.f } };
+	auto other_surf = *other_slope.getSurface(Cardinal::N);
+	other_surf.surface = Linef{ { 8.f, 32.f }, { 40.f, 0.f } };
+	other_slope.setSurface(Cardinal::N, other_surf);
+	other_slope.removeSurface(Cardinal::W);
+
+	auto mesh = world.create<ColliderMesh>(ent, std::vector<ColliderQuad>{ slope, other_slope, flat });
+	mesh->teleport(Vec2f{ 200.f, 100.f });
+
+	auto hit = raycast(world, Linef{ { 208.f, 90.f }, { 208.f, 190.f } });
+	ASSERT_TRUE(hit);
+	EXPECT_FLOAT_EQ(hit->impact.y, 110.f);
+	EXPECT_FLOAT_EQ(hit->distance, 20.f);
+
+	// past the flat quad, only the slopes are under the ray
+	hit = raycast(world, Linef{ { 220.f, 90.f }, { 220.f, 190.f } });
+	ASSERT_TRUE(hit);
+	EXPECT_FLOAT_EQ(hit->impact.y, 112.f);
+
+	// diagonally, both slopes are entered before the flat quad is hit
+	hit = raycast(world, Linef{ { 196.f, 96.f }, { 296.f, 196.f } });
+	ASSERT_TRUE(hit);
+	EXPECT_NEAR(hit->impact.x, 210.f, 0.01f);
+	EXPECT_NEAR(hit->impact.y, 110.f, 0.01f);
+	EXPECT_NEAR(hit->distance, 14.f * std::sqrt(2.f), 0.01f);
+}
+
+TEST(collider_mesh, bounds_skip_quads_without_surfaces)
+{
+	ColliderQuad empty{ Rectf{ 0.f, 0.f, 16.f, 16.f } };
+	empty.clearSurfaces();
+
+	ColliderMesh mesh{ { ColliderQuad{ Rectf{ 1000.f, 1000.f, 16.f, 16.f } }, empty } };
+	ASSERT_EQ(mesh.get_quads().size(), 2);
+	EXPECT_TRUE(mesh.get_quads()[0].hasAnySurface());
+	EXPECT_FALSE(mesh.get_quads()[1].hasAnySurface());
+
+	Rectf bounds = mesh.getBoundingBox();
+	EXPECT_EQ(bounds.left, 1000.f);
+	EXPECT_EQ(bounds.top, 1000.f);
+	EXPECT_EQ(bounds.width, 16.f);
+	EXPECT_EQ(bounds.height, 16.f);
+
+	std::vector<ColliderRegion::quad_iter> buffer;
+	EXPECT_TRUE(mesh.quads_in_rect(Rectf{ -8.f, -8.f, 32.f, 32.f }, buffer).empty());
+}
@@ -0,0 +1,164 @@
+#include "fastfall/game/phys/collision/CollisionTrace.hpp"
+#include "fastfall/game/phys/collider_regiontypes/ColliderTileMap.hpp"
+#include "fastfall/game/World.hpp"
+
+#include "gtest/gtest.h"
+
+#include "nlohmann/json.hpp"
+
+#include <filesystem>
+
+using namespace ff;
+
+class collision_trace : public ::testing::Test {
+protected:
+    World world;
+    CollisionSystem* colMan = nullptr;
+    Collidable* box = nullptr;
+    ID<Collidable> box_id;
+
+    static constexpr secs one_frame = (1.0 / 60.0);
+
+    void SetUp() override {
+        auto collider_ent = world.create_entity();
+        auto box_ent = world.create_entity();
+
+        auto* collider = world.create<ColliderTileMap>(collider_ent, Vec2i{ 1, 3 }).ptr;
+        collider->setTile({ 0, 2 }, TileShape::from_string("solid"));
+        collider->applyChanges();
+
+        auto box_ptr = world.create<Collidable>(box_ent, Vec2f{ 8, 32 }, Vec2f{ 16, 32 }, Vec2f{ 0.f, 500.f });
+        box_id = box_ptr.id;
+        box = box_ptr.ptr;
+
+        colMan = &world.system<CollisionSystem>();
+    }
+};
+
+TEST(collision_trace_buffer, overwrites_oldest)
+{
+    CollisionTrace trace{ 4 };
+
+    for (uint32_t i = 0; i < 6; i++) {
+        trace.begin_frame(i, 1.0);
+    }
+
+    EXPECT_EQ(trace.size(), 4);
+    EXPECT_EQ(trace.capacity(), 4);
+    EXPECT_EQ(trace.total_recorded(), 6);
+
+    auto records = trace.records();
+    ASSERT_EQ(records.size(), 4);
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT_EQ(records[i].type, trace::kind::Frame);
+        EXPECT_EQ(records[i].frame, i + 2);
+    }
+
+    trace.clear();
+    EXPECT_EQ(trace.size(), 0);
+    EXPECT_TRUE(trace.records().empty());
+}
+
+TEST(collision_trace_buffer, skips_cut_off_frames)
+{
+    CollisionTrace trace{ 16 };
+    trace.begin_frame(0, 1.0);
+    trace.record_section(trace::section::Solver);
+    trace.begin_frame(1, 1.0);
+    trace.record_section(trace::section::Solver);
+
+    // drop the first frame's start, like an overwritten ring buffer
+    auto records = trace.records();
+    auto json = trace_to_json(std::span{ records }.subspan(1));
+
+    ASSERT_EQ(json.size(), 1);
+    EXPECT_EQ(json[0]["frame"], 1);
+}
+
+TEST_F(collision_trace, records_frames)
+{
+    CollisionTrace trace;
+    colMan->setTrace(&trace);
+
+    for (size_t i = 0; i < 5; i++) {
+        colMan->update(world, one_frame);
+    }
+    colMan->setTrace(nullptr);
+
+    auto json = trace_to_json(trace.records());
+    ASSERT_EQ(json.size(), 5);
+
+    for (size_t i = 0; i < json.size(); i++) {
+        auto& frame = json[i];
+        EXPECT_EQ(frame["frame"], i);
+        ASSERT_EQ(frame["collisions"].size(), 1);
+
+        auto& collision = frame["collisions"][0];
+        EXPECT_EQ(collision["collidable"]["id"], box_id.raw());
+        EXPECT_TRUE(collision.contains("broad_phase"));
+        EXPECT_TRUE(collision.contains("solver"));
+        EXPECT_FALSE(collision["solver"]["apply"].empty());
+    }
+
+    // only the frames asked for
+    auto some = trace_to_json(trace.records(), 1, 2);
+    ASSERT_EQ(some.size(), 2);
+    EXPECT_EQ(some[0]["frame"], 1);
+    EXPECT_EQ(some[1]["frame"], 2);
+}
+
+TEST_F(collision_trace, save_and_load)
+{
+    CollisionTrace trace;
+    colMan->setTrace(&trace);
+    for (size_t i = 0; i < 3; i++) {
+        colMan->update(world, one_frame);
+    }
+    colMan->setTrace(nullptr);
+
+    auto path = std::filesystem::temp_directory_path() / "ff_collision_trace_test.bin";
+    ASSERT_TRUE(trace.save(path));
+
+    auto loaded = CollisionTrace::load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(loaded->size(), trace.size());
+    EXPECT_EQ(trace_to_json(*loaded), trace_to_json(trace.records()));
+}
+
+TEST_F(collision_trace, dump_matches_trace)
+{
+    CollisionTrace trace;
+    colMan->setTrace(&trace);
+
+    nlohmann::ordered_json dump;
+    colMan->dumpCollisionDataThisFrame(&dump);
+    colMan->update(world, one_frame);
+    colMan->setTrace(nullptr);
+
+    EXPECT_EQ(dump["frame"], 0);
+    ASSERT_EQ(dump["collisions"].size(), 1);
+
+    // the persistent trace got the dumped frame too
+    auto json = trace_to_json(trace.records());
+    ASSERT_EQ(json.size(), 1);
+    EXPECT_EQ(json[0], dump);
+}
+
+TEST_F(collision_trace, copies_dont_record)
+{
+    CollisionTrace trace;
+    colMan->setTrace(&trace);
+
+    World copy = world;
+    auto& copyColMan = copy.system<CollisionSystem>();
+    EXPECT_EQ(copyColMan.getTrace(), nullptr);
+
+    copyColMan.update(copy, one_frame);
+    EXPECT_EQ(trace.size(), 0);
+
+    colMan->update(world, one_frame);
+    colMan->setTrace(nullptr);
+    EXPECT_EQ(trace_to_json(trace.records()).size(), 1);
+}
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/render/util/AtlasPacker.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace ff;
+
+namespace {
+	// true if the padded areas overlap
+	bool overlaps(const AtlasRegion& a, const AtlasRegion& b, int pad) {
+		if (a.page != b.page)
+			return false;
+
+		return a.area.left < b.area.left + b.area.width + pad
+			&& b.area.left < a.area.left + a.area.width + pad
+			&& a.area.top  < b.area.top + b.area.height + pad
+			&& b.area.top  < a.area.top + a.area.height + pad;
+	}
+}
+
+TEST(atlas, insert_no_overlap)
+{
+	constexpr unsigned padding = 1;
+	AtlasPacker packer{ { 256, 256 }, padding };
+
+	std::mt19937 rng{ 1234 };
+	std::uniform_int_distribution<unsigned> dist{ 1, 48 };
+
+	std::vector<AtlasRegion> regions;
+	for (int i = 0; i < 200; i++) {
+		Vec2u size{ dist(rng), dist(rng) };
+		auto region = packer.insert(size);
+		ASSERT_TRUE(region);
+		EXPECT_EQ(region->area.width, size.x);
+		EXPECT_EQ(region->area.height, size.y);
+		EXPECT_GE(region->area.left, 0);
+		EXPECT_GE(region->area.top, 0);
+		EXPECT_LE(region->area.left + region->area.width, 256);
+		EXPECT_LE(region->area.top + region->area.height, 256);
+		regions.push_back(*region);
+	}
+
+	for (size_t i = 0; i < regions.size(); i++) {
+		for (size_t j = i + 1; j < regions.size(); j++) {
+			EXPECT_FALSE(overlaps(regions[i], regions[j], padding)) << i << " " << j;
+		}
+	}
+	EXPECT_GT(packer.pageCount(), 1);
+}
+
+TEST(atlas, full_page)
+{
+	AtlasPacker packer{ { 64, 64 }, 1 };
+
+	// padding may hang off the page edge, so an exact fit still works
+	auto full = packer.insert(Vec2u{ 64, 64 });
+	ASSERT_TRUE(full);
+	EXPECT_EQ(full->page, 0);
+	EXPECT_FLOAT_EQ(packer.occupancy(0), 1.f);
+
+	auto next = packer.insert(Vec2u{ 8, 8 });
+	ASSERT_TRUE(next);
+	EXPECT_EQ(next->page, 1);
+
+	EXPECT_FALSE(packer.insert(Vec2u{ 65, 1 }));
+	EXPECT_FALSE(packer.insert(Vec2u{ 0, 4 }));
+
+	packer.clear();
+	EXPECT_EQ(packer.pageCount(), 0);
+}
+
+TEST(atlas, batch_order)
+{
+	AtlasPacker packer{ { 128, 128 }, 0 };
+
+	// exactly fills the page when packed tallest first
+	std::vector<Vec2u> sizes;
+	for (int i = 0; i < 8; i++) {
+		sizes.push_back({ 32, 16 });
+		sizes.push_back({ 32, 16 });
+		sizes.push_back({ 32, 32 });
+	}
+	sizes.push_back({ 200, 8 });
+
+	auto regions = packer.insert(sizes);
+	ASSERT_EQ(regions.size(), sizes.size());
+	EXPECT_FALSE(regions.back());
+
+	for (size_t i = 0; i + 1 < sizes.size(); i++) {
+		ASSERT_TRUE(regions[i]);
+		EXPECT_EQ(regions[i]->page, 0);
+		EXPECT_EQ(regions[i]->area.width, sizes[i].x);
+		EXPECT_EQ(regions[i]->area.height, sizes[i].y);
+	}
+	EXPECT_EQ(packer.pageCount(), 1);
+	EXPECT_FLOAT_EQ(packer.occupancy(0), 1.f);
+}
+
+TEST(atlas, uv_remap)
+{
+	AtlasRegion region{ 0, Recti{ 64, 32, 16, 16 } };
+	Vec2u page_size{ 256, 128 };
+
+	Rectf page_rect = region.toPage(Rectf{ 4, 8, 8, 8 });
+	EXPECT_EQ(page_rect, (Rectf{ 68, 40, 8, 8 }));
+
+	Vec2f uv0 = region.toUV(Vec2f{ 0, 0 }, page_size);
+	Vec2f uv1 = region.toUV(Vec2f{ 16, 16 }, page_size);
+	EXPECT_FLOAT_EQ(uv0.x, 0.25f);
+	EXPECT_FLOAT_EQ(uv0.y, 0.25f);
+	EXPECT_FLOAT_EQ(uv1.x, 80.f / 256.f);
+	EXPECT_FLOAT_EQ(uv1.y, 48.f / 128.f);
+}
+
+TEST(atlas, blit)
+{
+	Vec2u page_size{ 8, 8 };
+	std::vector<uint8_t> page(page_size.x * page_size.y * 4, 0);
+
+	// 2x3 image with a padded pitch
+	constexpr size_t pitch = 12;
+	std::vector<uint8_t> image(pitch * 3, 0xFF);
+	for (size_t row = 0; row < 3; row++) {
+		for (size_t byte = 0; byte < 8; byte++) {
+			image[row * pitch + byte] = static_cast<uint8_t>(row * 8 + byte + 1);
+		}
+	}
+
+	AtlasRegion region{ 0, Recti{ 5, 2, 2, 3 } };
+	atlasBlit(page, page_size, region, image.data(), pitch);
+
+	for (unsigned y = 0; y < page_size.y; y++) {
+		for (unsigned x = 0; x < page_size.x; x++) {
+			bool inside = x >= 5 && x < 7 && y >= 2 && y < 5;
+			for (unsigned c = 0; c < 4; c++) {
+				uint8_t px = page[(y * page_size.x + x) * 4 + c];
+				uint8_t expected = inside
+					? static_cast<uint8_t>((y - 2) * 8 + (x - 5) * 4 + c + 1)
+					: 0;
+				EXPECT_EQ(px, expected) << x << "," << y;
+			}
+		}
+	}
+}
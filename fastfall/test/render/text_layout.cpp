@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/render/external/freetype.hpp"
+#include "fastfall/render/util/Font.hpp"
+#include "fastfall/render/util/TextLayout.hpp"
+
+using namespace ff;
+
+class text_layout : public ::testing::Test {
+protected:
+    void SetUp() override {
+        freetype_init();
+        ASSERT_TRUE(font.loadFromFile(std::string_view{ "data/pixelated.ttf" }));
+    }
+
+    void TearDown() override {
+        font.unload();
+        freetype_quit();
+    }
+
+    Font font;
+};
+
+void expect_same(const TextLayout& lhs, const TextLayout& rhs) {
+    EXPECT_EQ(lhs.text, rhs.text);
+    EXPECT_EQ(lhs.glyphs, rhs.glyphs);
+    EXPECT_EQ(lhs.bounds, rhs.bounds);
+    ASSERT_EQ(lhs.steps.size(), rhs.steps.size());
+    for (size_t i = 0; i < lhs.steps.size(); i++) {
+        EXPECT_TRUE(lhs.steps[i].pen == rhs.steps[i].pen);
+        EXPECT_EQ(lhs.steps[i].glyph_count, rhs.steps[i].glyph_count);
+    }
+}
+
+TEST_F(text_layout, build)
+{
+    TextLayout layout;
+    ASSERT_TRUE(layout.build(font, 8, 1.f, "ab c\nd"));
+
+    // whitespace has no glyph
+    ASSERT_EQ(layout.glyphs.size(), 4);
+    EXPECT_EQ(layout.glyphs[0].character, 'a');
+    EXPECT_EQ(layout.glyphs[3].character, 'd');
+    EXPECT_EQ(layout.steps.size(), 7);
+
+    // new line returns the pen
+    EXPECT_EQ(layout.steps[5].pen.x, 0.f);
+    EXPECT_GT(layout.glyphs[3].offset.y, layout.glyphs[0].offset.y);
+    EXPECT_GT(layout.bounds.width, 0.f);
+
+    EXPECT_FALSE(layout.build(font, 0, 1.f, "a"));
+    EXPECT_TRUE(layout.glyphs.empty());
+}
+
+TEST_F(text_layout, incremental)
+{
+    TextLayout layout;
+    layout.build(font, 8, 1.f, "Score: 100");
+    layout.build(font, 8, 1.f, "Score: 123");
+
+    TextLayout fresh;
+    fresh.build(font, 8, 1.f, "Score: 123");
+    expect_same(layout, fresh);
+
+    // shorter, then a different font size
+    layout.build(font, 8, 1.f, "Score");
+    fresh.clear();
+    fresh.build(font, 8, 1.f, "Score");
+    expect_same(layout, fresh);
+
+    layout.build(font, 16, 1.f, "Score: 1\t2");
+    fresh.clear();
+    fresh.build(font, 16, 1.f, "Score: 1\t2");
+    expect_same(layout, fresh);
+}
+
+TEST(text_layout_cache, lru)
+{
+    auto make = [](std::string_view text, unsigned px_size = 8) {
+        TextLayout layout;
+        layout.font_id = 1;
+        layout.px_size = px_size;
+        layout.text = text;
+        return layout;
+    };
+
+    TextLayoutCache cache{ 2 };
+    cache.insert(make("a"));
+    cache.insert(make("b"));
+    EXPECT_EQ(cache.size(), 2);
+
+    EXPECT_NE(cache.find(1, 8, 1.f, "a"), nullptr);
+    EXPECT_EQ(cache.find(1, 16, 1.f, "a"), nullptr);
+    EXPECT_EQ(cache.find(2, 8, 1.f, "a"), nullptr);
+
+    // b is the least recently used
+    cache.insert(make("c"));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_NE(cache.find(1, 8, 1.f, "a"), nullptr);
+    EXPECT_EQ(cache.find(1, 8, 1.f, "b"), nullptr);
+    EXPECT_NE(cache.find(1, 8, 1.f, "c"), nullptr);
+
+    // reinserting updates in place
+    cache.insert(make("c"));
+    EXPECT_EQ(cache.size(), 2);
+
+    EXPECT_EQ(cache.hits(), 3);
+    EXPECT_EQ(cache.misses(), 3);
+}
@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+
+#include "alloc_guard.hpp"
+
+#include "fastfall/util/alloc.hpp"
+#include "fastfall/game/World.hpp"
+#include "fastfall/game/level/Level.hpp"
+#include "fastfall/game/phys/collider_regiontypes/ColliderTileMap.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace ff;
+
+TEST(alloc, count)
+{
+    if (!alloc::hook_installed()) {
+        GTEST_SKIP() << "built without the allocation hook";
+    }
+
+    auto stats = alloc::count_allocations([]() {
+        auto ptr = std::make_unique<int>(1);
+        std::vector<int> vec(10);
+    });
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_GE(stats.bytes, sizeof(int) * 11);
+}
+
+TEST(alloc, nested_scopes)
+{
+    if (!alloc::hook_installed()) {
+        GTEST_SKIP() << "built without the allocation hook";
+    }
+
+    alloc::set_enabled(true);
+    {
+        alloc::Scope outer;
+        auto a = std::make_unique<int>(1);
+        {
+            alloc::Scope inner;
+            auto b = std::make_unique<int>(2);
+            EXPECT_EQ(inner.stats().count, 1);
+            EXPECT_EQ(outer.stats().count, 1);
+        }
+        EXPECT_EQ(outer.stats().count, 2);
+    }
+    alloc::set_enabled(false);
+}
+
+TEST(alloc, disabled)
+{
+    alloc::set_enabled(false);
+    alloc::Scope scope;
+    auto ptr = std::make_unique<int>(1);
+    EXPECT_EQ(scope.stats().count, 0);
+}
+
+TEST(alloc, no_allocations)
+{
+    std::vector<int> vec;
+    vec.reserve(16);
+    EXPECT_NO_ALLOCATIONS(
+        for (int i = 0; i < 16; i++) {
+            vec.push_back(i);
+        }
+    );
+}
+
+TEST(alloc, world_update_steady_state)
+{
+    World world;
+    constexpr secs one_tick = 1.0 / 60.0;
+
+    world.create_actor<Level>(std::optional<std::string>{ "alloc" }, std::optional<Vec2u>{ Vec2u{ 16, 8 } }, std::optional<Color>{});
+
+    // floor for the collidables to land on, and a wall for them to push against
+    auto floor_ent = world.create_entity();
+    auto* floor = world.create<ColliderTileMap>(floor_ent, Vec2i{ 16, 8 }, true).ptr;
+    for (int x = 0; x < 16; ++x) {
+        floor->setTile({ x, 7 }, TileShape::from_string("solid"));
+    }
+    for (int y = 0; y < 7; ++y) {
+        floor->setTile({ 15, y }, TileShape::from_string("solid"));
+    }
+    floor->applyChanges();
+
+    std::vector<ID<Collidable>> collidables;
+    for (int i = 0; i < 8; ++i) {
+        auto ent = world.create_entity();
+        collidables.push_back(world.create<Collidable>(ent, Vec2f{ 16.f + 24.f * i, 64.f }, Vec2f{ 16, 16 }, Vec2f{ 0.f, 500.f }).id);
+    }
+
+    // accelerating keeps them awake, a resting collidable skips most of the update
+    auto push_right = [&]() {
+        for (auto id : collidables) {
+            world.at(id).add_accel(Vec2f{ 500.f, 0.f });
+        }
+    };
+
+    // emits at a fixed rate up to max_particles, so the particle count levels off
+    EmitterStrategy strategy;
+    strategy.emit_rate_min = 50;
+    strategy.emit_rate_max = 50;
+    strategy.max_particles = 50;
+    strategy.max_lifetime  = 0.5;
+    auto emit_ent = world.create_entity();
+    auto emitter = world.create<Emitter>(emit_ent, strategy);
+    emitter->seed(0);
+    emitter->position = Vec2f{ 128.f, 32.f };
+    emitter->prev_position = emitter->position;
+
+    // warm up, past the emitter's max lifetime and long enough for the collidables to land
+    for (int i = 0; i < 120; ++i) {
+        push_right();
+        world.update(one_tick);
+    }
+    EXPECT_FALSE(world.at(emitter.id).particles.empty());
+
+    push_right();
+    for (auto id : collidables) {
+        ASSERT_FALSE(world.system<CollisionSystem>().get_rest(id).is_asleep());
+    }
+
+    EXPECT_NO_ALLOCATIONS(world.update(one_tick));
+}
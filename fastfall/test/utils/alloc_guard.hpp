@@ -0,0 +1,17 @@
+#pragma once
+
+#include "gtest/gtest.h"
+
+#include "fastfall/util/alloc.hpp"
+
+// expects the statements to make no heap allocations on the calling thread
+// skips the test if fastfall_alloc_hook isn't linked in
+#define EXPECT_NO_ALLOCATIONS(...)                                              \
+    do {                                                                        \
+        if (!ff::alloc::hook_installed()) {                                     \
+            GTEST_SKIP() << "built without the allocation hook";                 \
+        }                                                                       \
+        auto ff_alloc_stats = ff::alloc::count_allocations([&]() { __VA_ARGS__; }); \
+        EXPECT_EQ(ff_alloc_stats.count, 0)                                      \
+            << ff_alloc_stats.bytes << " bytes allocated by: " #__VA_ARGS__;    \
+    } while (false)
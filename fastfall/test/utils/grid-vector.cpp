@@ -40,4 +40,59 @@ TEST(grid_vector, views)
 		EXPECT_EQ(view.column_count(), 2);
 		EXPECT_EQ(view.row_count(), 2);
 	}
-}
\ No newline at end of file
+}
+
+TEST(grid_vector, blocked_layout)
+{
+	using layout = grid_layout::blocked<4>;
+
+	grid_vector<int> row_grid(10, 7);
+	grid_vector<int, layout> grid(10, 7);
+	EXPECT_EQ(grid.storage_size(), 12 * 8);
+
+	std::iota(row_grid.begin(), row_grid.end(), 1);
+	std::iota(grid.begin(), grid.end(), 1);
+
+	// iterated in row order, same as row major
+	EXPECT_TRUE(std::equal(grid.begin(), grid.end(), row_grid.begin(), row_grid.end()));
+	for (size_t y = 0; y < 7; y++) {
+		for (size_t x = 0; x < 10; x++) {
+			EXPECT_EQ(grid.at(x, y), row_grid.at(x, y));
+			EXPECT_EQ(grid[y * 10 + x], row_grid[y * 10 + x]);
+		}
+	}
+
+	// first block is stored together
+	EXPECT_EQ(grid.data()[4], grid.at(0, 1));
+
+	auto view = grid.take_view(3, 2, 6, 4);
+	auto row_view = row_grid.take_view(3, 2, 6, 4);
+	EXPECT_TRUE(std::equal(view.cbegin(), view.cend(), row_view.cbegin(), row_view.cend()));
+
+	auto sub_view = view.take_view(1, 1, 3, 2);
+	EXPECT_EQ(sub_view.at(0, 0), grid.at(4, 3));
+	EXPECT_EQ(sub_view.at(2, 1), grid.at(6, 4));
+
+	size_t count = 0;
+	for (auto it = sub_view.cbegin(); it != sub_view.cend(); ++it) {
+		EXPECT_EQ(*it, grid.at(4 + it.column(), 3 + it.row()));
+		count++;
+	}
+	EXPECT_EQ(count, 6);
+
+	grid_vector<int, layout> copy = grid;
+	EXPECT_TRUE(std::equal(copy.begin(), copy.end(), grid.begin(), grid.end()));
+
+	grid_vector<int, layout> from_view{ view };
+	EXPECT_EQ(from_view.at(0, 0), grid.at(3, 2));
+	EXPECT_EQ(from_view.at(5, 3), grid.at(8, 5));
+
+	grid_vector<int, layout> il = { { 1, 2, 3 }, { 4, 5, 6 } };
+	EXPECT_EQ(il.at(2, 0), 3);
+	EXPECT_EQ(il.at(0, 1), 4);
+
+	// only layouts that aren't linear keep where a view sits in its grid
+	static_assert(sizeof(grid_view<int>) == sizeof(int*) + 3 * sizeof(size_t));
+	static_assert(sizeof(grid_vector<int>::const_iterator) == sizeof(int*) + 4 * sizeof(size_t));
+	static_assert(sizeof(grid_view<int, layout>) > sizeof(grid_view<int>));
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/util/inline_vector.hpp"
+
+#include <algorithm>
+
+using namespace ff;
+
+TEST(inline_vector, push_erase)
+{
+    inline_vector<int, 4> vec;
+    EXPECT_TRUE(vec.empty());
+
+    for (int i = 0; i < 4; i++) {
+        vec.push_back(i);
+    }
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(vec.size(), 4);
+
+    vec.erase(vec.begin());
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec.front(), 1);
+    EXPECT_EQ(vec.back(), 3);
+
+    vec.erase(vec.begin() + 1);
+    EXPECT_EQ(vec[0], 1);
+    EXPECT_EQ(vec[1], 3);
+}
+
+TEST(inline_vector, overflow)
+{
+    inline_vector<int, 4> vec;
+    for (int i = 0; i < 10; i++) {
+        vec.push_back(i);
+    }
+    EXPECT_FALSE(vec.is_inline());
+    ASSERT_EQ(vec.size(), 10);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(vec[i], i);
+    }
+
+    vec.erase(vec.begin());
+    EXPECT_EQ(vec.front(), 1);
+    EXPECT_EQ(vec.size(), 9);
+
+    // back to the inline storage
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_TRUE(vec.is_inline());
+    vec.push_back(5);
+    EXPECT_EQ(vec.front(), 5);
+}
+
+TEST(inline_vector, insert_sort)
+{
+    inline_vector<int, 4> vec;
+    vec.push_back(3);
+    vec.push_back(0);
+
+    int more[] = { 2, 1, 4 };
+    vec.insert(vec.end(), std::begin(more), std::end(more));
+    ASSERT_EQ(vec.size(), 5);
+
+    std::sort(vec.begin(), vec.end());
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(vec[i], i);
+    }
+
+    // insert in front
+    int front[] = { -2, -1 };
+    vec.insert(vec.begin(), std::begin(front), std::end(front));
+    EXPECT_EQ(vec[0], -2);
+    EXPECT_EQ(vec[1], -1);
+    EXPECT_EQ(vec[2], 0);
+    EXPECT_EQ(vec.size(), 7);
+}
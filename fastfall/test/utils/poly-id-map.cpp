@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/util/id_map.hpp"
+
+#include <string>
+
+using namespace ff;
+
+namespace {
+
+struct Shape {
+    virtual ~Shape() { destroyed++; }
+    virtual int sides() const = 0;
+
+    static inline int destroyed = 0;
+};
+
+struct Triangle : Shape {
+    int sides() const override { return 3; }
+};
+
+struct Polygon : Shape {
+    Polygon(int t_sides, std::string t_name) : count{ t_sides }, name{ std::move(t_name) } {}
+    int sides() const override { return count; }
+
+    int count;
+    std::string name;
+};
+
+}
+
+TEST(poly_id_map, create_erase)
+{
+    Shape::destroyed = 0;
+    {
+        poly_id_map<Shape> shapes;
+        auto tri  = shapes.create<Triangle>();
+        auto poly = shapes.create<Polygon>(5, "pentagon");
+        EXPECT_EQ(shapes.size(), 2);
+        EXPECT_EQ(shapes.at(tri).sides(), 3);
+        EXPECT_EQ(shapes.at(poly).name, "pentagon");
+
+        int total = 0;
+        for (auto [id, shape] : shapes) {
+            total += shape->sides();
+        }
+        EXPECT_EQ(total, 8);
+
+        EXPECT_TRUE(shapes.erase(tri));
+        EXPECT_FALSE(shapes.exists(tri));
+        EXPECT_EQ(Shape::destroyed, 1);
+
+        // freed slot is reused
+        Shape* poly_ptr = &shapes.at(poly);
+        auto tri2 = shapes.create<Triangle>();
+        EXPECT_EQ(shapes.at(tri2).sides(), 3);
+        EXPECT_EQ(&shapes.at(poly), poly_ptr);
+    }
+    EXPECT_EQ(Shape::destroyed, 3);
+}
+
+TEST(poly_id_map, same_type_contiguous)
+{
+    poly_id_map<Shape> shapes;
+    std::vector<ID<Triangle>> ids;
+    for (int i = 0; i < 8; i++) {
+        ids.push_back(shapes.create<Triangle>());
+        shapes.create<Polygon>(i, "");
+    }
+    for (size_t i = 1; i < ids.size(); i++) {
+        auto* prev = reinterpret_cast<std::byte*>(&shapes.at(ids[i - 1]));
+        auto* curr = reinterpret_cast<std::byte*>(&shapes.at(ids[i]));
+        EXPECT_EQ(curr - prev, sizeof(Triangle));
+    }
+}
+
+TEST(poly_id_map, empty_then_emplace)
+{
+    poly_id_map<Shape> shapes;
+    auto id = shapes.create_empty();
+    EXPECT_TRUE(shapes.exists(id));
+    EXPECT_EQ(shapes.get(id), nullptr);
+
+    shapes.emplace_at<Polygon>(id, 6, "hexagon");
+    EXPECT_EQ(shapes.at(id).sides(), 6);
+
+    // replaces the old one
+    shapes.emplace_at<Triangle>(id);
+    EXPECT_EQ(shapes.at(id).sides(), 3);
+}
+
+TEST(poly_id_map, copy)
+{
+    poly_id_map<Shape> shapes;
+    auto tri = shapes.create<Triangle>();
+    auto poly = shapes.create<Polygon>(4, "square");
+    shapes.erase(tri);
+    auto poly2 = shapes.create<Polygon>(8, "octagon");
+
+    poly_id_map<Shape> copy{ shapes };
+    ASSERT_EQ(copy.size(), 2);
+    EXPECT_NE(&copy.at(poly), &shapes.at(poly));
+    EXPECT_EQ(copy.at(poly).name, "square");
+    EXPECT_EQ(copy.at(poly2).name, "octagon");
+
+    // iteration sees the copies
+    for (auto [id, shape] : copy) {
+        EXPECT_EQ(shape.get(), copy.get(id_cast<Polygon>(id)));
+    }
+
+    copy.at(poly).name = "changed";
+    EXPECT_EQ(shapes.at(poly).name, "square");
+
+    shapes = copy;
+    EXPECT_EQ(shapes.at(poly).name, "changed");
+    EXPECT_NE(&copy.at(poly), &shapes.at(poly));
+}
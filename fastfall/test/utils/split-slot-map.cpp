@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/util/split_slot_map.hpp"
+
+#include <string>
+
+using namespace ff;
+
+namespace {
+
+struct Hot {
+    float x = 0.f;
+    float vx = 0.f;
+};
+
+struct Cold {
+    std::string name;
+};
+
+}
+
+TEST(split_slot_map, emplace_get)
+{
+    split_slot_map<Hot, Cold> map;
+    auto a = map.emplace_back({ 1.f, 2.f }, { "a" });
+    auto b = map.emplace_back({ 3.f, 4.f }, { "b" });
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_TRUE(map.exists(a));
+    EXPECT_TRUE(map.exists(b));
+
+    EXPECT_EQ(map.get<Hot>(a).x, 1.f);
+    EXPECT_EQ(map.get<Cold>(b).name, "b");
+    EXPECT_EQ(map.at<1>(a).name, "a");
+
+    // columns line up with the keys
+    auto keys = map.keys();
+    auto hot = map.column<Hot>();
+    auto cold = map.column<Cold>();
+    ASSERT_EQ(keys.size(), 2);
+    ASSERT_EQ(hot.size(), 2);
+    ASSERT_EQ(cold.size(), 2);
+    for (size_t i = 0; i < keys.size(); i++) {
+        EXPECT_EQ(&hot[i], &map.get<Hot>(keys[i]));
+        EXPECT_EQ(&cold[i], &map.get<Cold>(keys[i]));
+    }
+}
+
+TEST(split_slot_map, erase)
+{
+    split_slot_map<Hot, Cold> map;
+    auto a = map.emplace_back({ 1.f, 0.f }, { "a" });
+    auto b = map.emplace_back({ 2.f, 0.f }, { "b" });
+    auto c = map.emplace_back({ 3.f, 0.f }, { "c" });
+
+    EXPECT_TRUE(map.erase(a));
+    EXPECT_FALSE(map.erase(a));
+    EXPECT_FALSE(map.exists(a));
+    EXPECT_EQ(map.size(), 2);
+
+    // last element moved into the hole
+    EXPECT_EQ(map.dense_index(c), 0);
+    EXPECT_EQ(map.get<Hot>(c).x, 3.f);
+    EXPECT_EQ(map.get<Cold>(c).name, "c");
+    EXPECT_EQ(map.get<Cold>(b).name, "b");
+
+    // reused slot gets a new generation
+    auto d = map.emplace_back({ 4.f, 0.f }, { "d" });
+    EXPECT_EQ(d.sparse_index, a.sparse_index);
+    EXPECT_NE(d.generation, a.generation);
+    EXPECT_FALSE(map.exists(a));
+    EXPECT_EQ(map.get<Cold>(d).name, "d");
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.exists(b));
+    EXPECT_FALSE(map.exists(c));
+    EXPECT_FALSE(map.exists(d));
+}
+
+TEST(split_slot_map, for_each)
+{
+    split_slot_map<Hot, Cold> map;
+    for (int i = 0; i < 100; i++) {
+        map.emplace_back({ (float)i, 1.f }, { std::to_string(i) });
+    }
+    for (int i = 0; i < 100; i += 3) {
+        map.erase(map.keys()[i % map.size()]);
+    }
+
+    for (auto& hot : map.column<Hot>()) {
+        hot.x += hot.vx;
+    }
+
+    size_t count = 0;
+    map.for_each([&](slot_key key, Hot& hot, Cold& cold) {
+        EXPECT_TRUE(map.exists(key));
+        EXPECT_EQ(hot.x, std::stof(cold.name) + 1.f);
+        count++;
+    });
+    EXPECT_EQ(count, map.size());
+}
+
+TEST(split_slot_map, single_column)
+{
+    // just keys and values apart
+    split_slot_map<int> map;
+    auto a = map.emplace_back(5);
+    EXPECT_EQ(map.get<int>(a), 5);
+    EXPECT_EQ(map.column<int>().size(), 1);
+}
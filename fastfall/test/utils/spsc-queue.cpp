@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/util/spsc_queue.hpp"
+
+#include <thread>
+
+using namespace ff;
+
+TEST(spsc_queue, push_pop)
+{
+    spsc_queue<int, 4> queue;
+    int value = 0;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_TRUE(queue.push(3));
+    EXPECT_TRUE(queue.push(4));
+    EXPECT_FALSE(queue.push(5));
+    EXPECT_EQ(queue.size(), 4);
+
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 1);
+
+    // wraps around
+    EXPECT_TRUE(queue.push(5));
+
+    for (int expected = 2; expected <= 5; expected++) {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(spsc_queue, threaded)
+{
+    spsc_queue<uint64_t, 64> queue;
+    constexpr uint64_t count = 100000;
+
+    std::thread producer{ [&]() {
+        for (uint64_t i = 1; i <= count; ) {
+            if (queue.push(i)) {
+                i++;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    } };
+
+    // values arrive in order, none lost
+    uint64_t expected = 1;
+    uint64_t value = 0;
+    while (expected <= count) {
+        if (queue.pop(value)) {
+            EXPECT_EQ(value, expected);
+            expected++;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
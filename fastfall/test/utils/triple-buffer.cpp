@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+
+#include "fastfall/util/triple_buffer.hpp"
+
+#include <thread>
+
+using namespace ff;
+
+TEST(triple_buffer, publish_acquire)
+{
+    triple_buffer<int> buffer{ 0 };
+    EXPECT_FALSE(buffer.acquire());
+    EXPECT_EQ(buffer.front(), 0);
+
+    buffer.back() = 1;
+    buffer.publish();
+    EXPECT_TRUE(buffer.has_fresh());
+    EXPECT_TRUE(buffer.acquire());
+    EXPECT_EQ(buffer.front(), 1);
+
+    // nothing new published
+    EXPECT_FALSE(buffer.acquire());
+    EXPECT_EQ(buffer.front(), 1);
+}
+
+TEST(triple_buffer, latest_wins)
+{
+    triple_buffer<int> buffer{ 0 };
+
+    buffer.back() = 1;
+    buffer.publish();
+    buffer.back() = 2;
+    buffer.publish();
+    buffer.back() = 3;
+    buffer.publish();
+
+    EXPECT_TRUE(buffer.acquire());
+    EXPECT_EQ(buffer.front(), 3);
+    EXPECT_FALSE(buffer.acquire());
+}
+
+TEST(triple_buffer, producer_never_writes_front)
+{
+    triple_buffer<int> buffer{ 0 };
+
+    buffer.back() = 1;
+    buffer.publish();
+    EXPECT_TRUE(buffer.acquire());
+
+    for (int i = 2; i < 10; i++) {
+        EXPECT_NE(&buffer.back(), &buffer.front());
+        buffer.back() = i;
+        buffer.publish();
+        EXPECT_EQ(buffer.front(), 1);
+    }
+}
+
+TEST(triple_buffer, threaded)
+{
+    struct value_t {
+        size_t a = 0;
+        size_t b = 0;
+    };
+
+    constexpr size_t count = 100000;
+    triple_buffer<value_t> buffer;
+
+    std::thread producer([&]() {
+        for (size_t i = 1; i <= count; i++) {
+            buffer.back() = { i, i * 2 };
+            buffer.publish();
+        }
+    });
+
+    size_t last = 0;
+    while (last < count) {
+        if (buffer.acquire()) {
+            auto& v = buffer.front();
+            EXPECT_EQ(v.a * 2, v.b);
+            EXPECT_GT(v.a, last);
+            last = v.a;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(last, count);
+}
@@ -0,0 +1,44 @@
+// converts a collision trace saved by CollisionTrace::save to the collision dump's json format
+// usage: ff_trace2json <trace file> [first frame] [last frame]
+
+#include "fastfall/game/phys/collision/CollisionTrace.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+bool parse_frame(std::string_view arg, uint32_t& out) {
+    auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), out);
+    return ec == std::errc{} && ptr == arg.data() + arg.size();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        std::cerr << "usage: " << argv[0] << " <trace file> [first frame] [last frame]\n";
+        return 1;
+    }
+
+    uint32_t first_frame = 0;
+    uint32_t last_frame  = UINT32_MAX;
+    if ((argc > 2 && !parse_frame(argv[2], first_frame))
+        || (argc > 3 && !parse_frame(argv[3], last_frame)))
+    {
+        std::cerr << "frames must be unsigned integers\n";
+        return 1;
+    }
+
+    auto records = ff::CollisionTrace::load(argv[1]);
+    if (!records) {
+        return 1;
+    }
+
+    std::cout << ff::trace_to_json(*records, first_frame, last_frame).dump(4) << std::endl;
+    return 0;
+}